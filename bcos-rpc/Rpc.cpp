@@ -92,6 +92,7 @@ void Rpc::asyncNotifyBlockNumber(std::string const& _groupID, std::string const&
     {
         _callback(nullptr);
     }
+    // the event sub tasks are woken by the block number notifier of the group manager
     m_jsonRpcImpl->groupManager()->updateGroupBlockInfo(_groupID, _nodeName, _blockNumber);
     WEBSOCKET_SERVICE(TRACE) << LOG_BADGE("asyncNotifyBlockNumber")
                              << LOG_KV("blockNumber", _blockNumber) << LOG_KV("ss size", ss.size());
@@ -110,19 +111,25 @@ void Rpc::asyncNotifyGroupInfo(
 void Rpc::notifyGroupInfo(bcos::group::GroupInfo::Ptr _groupInfo)
 {
     // notify the groupInfo to SDK
+    // Note: the notifier may be called with the lock of the GroupManager held, so the groupInfo
+    //       is serialized directly instead of through the GroupInfoCache, but only once for all
+    //       the sessions
     auto sdkSessions = m_wsService->sessions();
+    std::shared_ptr<bcos::bytes> response = nullptr;
     for (auto const& session : sdkSessions)
     {
         if (!session || !session->isConnected())
         {
             continue;
         }
-        Json::Value groupInfoJson;
-        groupInfoToJson(groupInfoJson, _groupInfo);
-        auto response = groupInfoJson.toStyledString();
-        auto message =
-            m_wsService->messageFactory()->buildMessage(bcos::rpc::MessageType::GROUP_NOTIFY,
-                std::make_shared<bcos::bytes>(response.begin(), response.end()));
+        if (!response)
+        {
+            Json::Value groupInfoJson;
+            groupInfoToJson(groupInfoJson, _groupInfo);
+            response = GroupInfoCache::serialize(groupInfoJson);
+        }
+        auto message = m_wsService->messageFactory()->buildMessage(
+            bcos::rpc::MessageType::GROUP_NOTIFY, response);
         session->asyncSendMessage(message);
     }
 }
\ No newline at end of file
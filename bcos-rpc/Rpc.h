@@ -50,6 +50,20 @@ public:
     {
         m_jsonRpcImpl->groupManager()->registerGroupInfoNotifier(
             [this](bcos::group::GroupInfo::Ptr _groupInfo) { notifyGroupInfo(_groupInfo); });
+        // wake the event sub tasks waiting for the new block only when the highest block of the
+        // group increased, the stale and duplicate notifications of the lagging nodes are ignored
+        if (m_eventSub)
+        {
+            auto eventSub = std::weak_ptr<bcos::event::EventSub>(m_eventSub);
+            m_jsonRpcImpl->groupManager()->registerBlockNumberNotifier(
+                [eventSub](std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber) {
+                    auto es = eventSub.lock();
+                    if (es)
+                    {
+                        es->onBlockNumberUpdated(_groupID, _blockNumber);
+                    }
+                });
+        }
     }
 
     virtual ~Rpc() { stop(); }
@@ -0,0 +1,141 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the tuning options of the rpc in the [rpc] section of config.ini
+ * @file RpcConfig.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/RpcConfig.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+void RpcConfig::loadConfig(std::string const& _configPath)
+{
+    boost::property_tree::ptree pt;
+    try
+    {
+        boost::property_tree::ini_parser::read_ini(_configPath, pt);
+    }
+    catch (std::exception const& e)
+    {
+        BOOST_THROW_EXCEPTION(InvalidRpcConfig() << errinfo_comment(
+                                  "load the rpc config failed: " + _configPath + ", " + e.what()));
+    }
+    loadConfig(pt);
+}
+
+void RpcConfig::loadConfig(boost::property_tree::ptree const& _pt)
+{
+    m_callCacheEnabled = _pt.get<bool>("rpc.call_cache_enable", m_callCacheEnabled);
+    m_callCacheCapacity =
+        _pt.get<uint64_t>("rpc.call_cache_capacity", m_callCacheCapacity / (1024 * 1024)) * 1024 *
+        1024;
+    auto allowlist = _pt.get<std::string>("rpc.call_cache_allowlist", "");
+    if (!allowlist.empty())
+    {
+        std::vector<std::string> contracts;
+        boost::split(contracts, allowlist, boost::is_any_of(","));
+        m_callCacheAllowlist.clear();
+        for (auto& contract : contracts)
+        {
+            boost::trim(contract);
+            if (!contract.empty())
+            {
+                m_callCacheAllowlist.insert(contract);
+            }
+        }
+    }
+    m_codeCacheMaxBlockAge =
+        _pt.get<int64_t>("rpc.code_cache_max_block_age", m_codeCacheMaxBlockAge);
+    m_logQueryMaxBlockRange =
+        _pt.get<int64_t>("rpc.log_query_max_block_range", m_logQueryMaxBlockRange);
+    m_logQueryMaxResultCount =
+        _pt.get<uint64_t>("rpc.log_query_max_result_count", m_logQueryMaxResultCount);
+    m_logQueryFetchWindow = _pt.get<uint64_t>("rpc.log_query_fetch_window", m_logQueryFetchWindow);
+    if (m_logQueryMaxBlockRange <= 0 || m_logQueryMaxResultCount == 0 || m_logQueryFetchWindow == 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidRpcConfig() << errinfo_comment(
+                "the log query limits of the rpc should be positive: " +
+                std::to_string(m_logQueryMaxBlockRange) + ", " +
+                std::to_string(m_logQueryMaxResultCount) + ", " +
+                std::to_string(m_logQueryFetchWindow)));
+    }
+    m_filterTimeout = _pt.get<uint64_t>("rpc.filter_timeout", m_filterTimeout);
+    m_maxFilterCount = _pt.get<size_t>("rpc.max_filter_count", m_maxFilterCount);
+    m_hedgeEnabled = _pt.get<bool>("rpc.hedge_enable", m_hedgeEnabled);
+    m_hedgePercentile = _pt.get<double>("rpc.hedge_percentile", m_hedgePercentile);
+    m_hedgeTokenRatio = _pt.get<double>("rpc.hedge_token_ratio", m_hedgeTokenRatio);
+    if (m_hedgePercentile <= 0 || m_hedgePercentile > 1 || m_hedgeTokenRatio < 0 ||
+        m_hedgeTokenRatio > 1)
+    {
+        BOOST_THROW_EXCEPTION(InvalidRpcConfig() << errinfo_comment(
+                                  "the hedge percentile and the hedge token ratio of the rpc "
+                                  "should be in (0, 1] and [0, 1]"));
+    }
+    m_writeSessionEnabled = _pt.get<bool>("rpc.write_session_enable", m_writeSessionEnabled);
+    m_eventBloomPath = _pt.get<std::string>("rpc.event_bloom_path", m_eventBloomPath);
+    m_eventLogIndexPath = _pt.get<std::string>("rpc.event_log_index_path", m_eventLogIndexPath);
+    loadCircuitBreakerConfig(_pt);
+
+    BCOS_LOG(INFO) << LOG_DESC("[RPC][CONFIG][loadConfig]")
+                   << LOG_KV("callCacheEnabled", m_callCacheEnabled)
+                   << LOG_KV("callCacheCapacity", m_callCacheCapacity)
+                   << LOG_KV("callCacheAllowlist", m_callCacheAllowlist.size())
+                   << LOG_KV("codeCacheMaxBlockAge", m_codeCacheMaxBlockAge)
+                   << LOG_KV("logQueryMaxBlockRange", m_logQueryMaxBlockRange)
+                   << LOG_KV("logQueryMaxResultCount", m_logQueryMaxResultCount)
+                   << LOG_KV("logQueryFetchWindow", m_logQueryFetchWindow)
+                   << LOG_KV("filterTimeout", m_filterTimeout)
+                   << LOG_KV("maxFilterCount", m_maxFilterCount)
+                   << LOG_KV("hedgeEnabled", m_hedgeEnabled)
+                   << LOG_KV("hedgePercentile", m_hedgePercentile)
+                   << LOG_KV("hedgeTokenRatio", m_hedgeTokenRatio)
+                   << LOG_KV("writeSessionEnabled", m_writeSessionEnabled)
+                   << LOG_KV("eventBloomPath", m_eventBloomPath)
+                   << LOG_KV("eventLogIndexPath", m_eventLogIndexPath);
+}
+
+void RpcConfig::loadCircuitBreakerConfig(boost::property_tree::ptree const& _pt)
+{
+    auto& config = m_circuitBreakerConfig;
+    config.errorRateThreshold =
+        _pt.get<double>("rpc.circuit_breaker_error_rate", config.errorRateThreshold);
+    config.consecutiveFailureThreshold = _pt.get<uint64_t>(
+        "rpc.circuit_breaker_consecutive_failures", config.consecutiveFailureThreshold);
+    config.slowCallThreshold = _pt.get<uint64_t>("rpc.circuit_breaker_slow_call_threshold",
+                                   config.slowCallThreshold / 1000) *
+                               1000;
+    config.openTime = _pt.get<uint64_t>("rpc.circuit_breaker_open_time", config.openTime);
+    config.rampTime = _pt.get<uint64_t>("rpc.circuit_breaker_ramp_time", config.rampTime);
+    if (config.errorRateThreshold <= 0 || config.errorRateThreshold > 1 ||
+        config.consecutiveFailureThreshold == 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidRpcConfig() << errinfo_comment(
+                                  "the error rate of the circuit breaker should be in (0, 1], "
+                                  "and the consecutive failures should be positive"));
+    }
+    BCOS_LOG(INFO) << LOG_DESC("[RPC][CONFIG][loadCircuitBreakerConfig]")
+                   << LOG_KV("errorRate", config.errorRateThreshold)
+                   << LOG_KV("consecutiveFailures", config.consecutiveFailureThreshold)
+                   << LOG_KV("slowCallThreshold(us)", config.slowCallThreshold)
+                   << LOG_KV("openTime", config.openTime) << LOG_KV("rampTime", config.rampTime);
+}
@@ -0,0 +1,142 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the tuning options of the rpc in the [rpc] section of config.ini
+ * @file RpcConfig.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-rpc/jsonrpc/groupmgr/CircuitBreaker.h>
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace bcos
+{
+namespace rpc
+{
+DERIVE_BCOS_EXCEPTION(InvalidRpcConfig);
+/**
+ * @brief the NodeConfig of bcos-framework only loads the listen and ssl options of the rpc, the
+ * options of the caches and the schedulers of the rpc are loaded here from the same config.ini,
+ * the defaults are used for the missing keys
+ */
+class RpcConfig
+{
+public:
+    using Ptr = std::shared_ptr<RpcConfig>;
+    RpcConfig() = default;
+    virtual ~RpcConfig() {}
+
+    // load from the ini file, throw InvalidRpcConfig if the file cannot be parsed
+    virtual void loadConfig(std::string const& _configPath);
+    virtual void loadConfig(boost::property_tree::ptree const& _pt);
+
+    // rpc.call_cache_enable, rpc.call_cache_capacity(MB)
+    bool callCacheEnabled() const { return m_callCacheEnabled; }
+    void setCallCacheEnabled(bool _enabled) { m_callCacheEnabled = _enabled; }
+    uint64_t callCacheCapacity() const { return m_callCacheCapacity; }
+    void setCallCacheCapacity(uint64_t _capacity) { m_callCacheCapacity = _capacity; }
+    // rpc.call_cache_allowlist, the comma separated contracts whose calls are cached, all the
+    // contracts are cached if empty
+    std::set<std::string> const& callCacheAllowlist() const { return m_callCacheAllowlist; }
+    void setCallCacheAllowlist(std::set<std::string> const& _allowlist)
+    {
+        m_callCacheAllowlist = _allowlist;
+    }
+
+    // rpc.code_cache_max_block_age, -1 means never expire
+    int64_t codeCacheMaxBlockAge() const { return m_codeCacheMaxBlockAge; }
+    void setCodeCacheMaxBlockAge(int64_t _maxBlockAge) { m_codeCacheMaxBlockAge = _maxBlockAge; }
+
+    // rpc.log_query_max_block_range, rpc.log_query_max_result_count, rpc.log_query_fetch_window
+    int64_t logQueryMaxBlockRange() const { return m_logQueryMaxBlockRange; }
+    void setLogQueryMaxBlockRange(int64_t _maxBlockRange)
+    {
+        m_logQueryMaxBlockRange = _maxBlockRange;
+    }
+    uint64_t logQueryMaxResultCount() const { return m_logQueryMaxResultCount; }
+    void setLogQueryMaxResultCount(uint64_t _maxResultCount)
+    {
+        m_logQueryMaxResultCount = _maxResultCount;
+    }
+    uint64_t logQueryFetchWindow() const { return m_logQueryFetchWindow; }
+    void setLogQueryFetchWindow(uint64_t _fetchWindow) { m_logQueryFetchWindow = _fetchWindow; }
+
+    // rpc.filter_timeout(ms), rpc.max_filter_count
+    uint64_t filterTimeout() const { return m_filterTimeout; }
+    void setFilterTimeout(uint64_t _filterTimeout) { m_filterTimeout = _filterTimeout; }
+    size_t maxFilterCount() const { return m_maxFilterCount; }
+    void setMaxFilterCount(size_t _maxFilterCount) { m_maxFilterCount = _maxFilterCount; }
+
+    // rpc.hedge_enable, rpc.hedge_percentile, rpc.hedge_token_ratio
+    bool hedgeEnabled() const { return m_hedgeEnabled; }
+    void setHedgeEnabled(bool _enabled) { m_hedgeEnabled = _enabled; }
+    double hedgePercentile() const { return m_hedgePercentile; }
+    void setHedgePercentile(double _hedgePercentile) { m_hedgePercentile = _hedgePercentile; }
+    double hedgeTokenRatio() const { return m_hedgeTokenRatio; }
+    void setHedgeTokenRatio(double _ratio) { m_hedgeTokenRatio = _ratio; }
+
+    // rpc.write_session_enable, route the reads of the submitted transactions to the node at or
+    // past their blocks
+    bool writeSessionEnabled() const { return m_writeSessionEnabled; }
+    void setWriteSessionEnabled(bool _enabled) { m_writeSessionEnabled = _enabled; }
+
+    // rpc.circuit_breaker_error_rate, rpc.circuit_breaker_consecutive_failures,
+    // rpc.circuit_breaker_slow_call_threshold(ms), rpc.circuit_breaker_open_time(ms),
+    // rpc.circuit_breaker_ramp_time(ms)
+    CircuitBreakerConfig const& circuitBreakerConfig() const { return m_circuitBreakerConfig; }
+    void setCircuitBreakerConfig(CircuitBreakerConfig const& _config)
+    {
+        m_circuitBreakerConfig = _config;
+    }
+
+    // rpc.event_bloom_path, the directory to persist the log blooms of the fetched blocks, empty
+    // means in memory only
+    std::string const& eventBloomPath() const { return m_eventBloomPath; }
+    void setEventBloomPath(std::string const& _path) { m_eventBloomPath = _path; }
+
+    // rpc.event_log_index_path, the directory of the persistent event log index, empty means the
+    // index is disabled
+    std::string const& eventLogIndexPath() const { return m_eventLogIndexPath; }
+    void setEventLogIndexPath(std::string const& _path) { m_eventLogIndexPath = _path; }
+
+private:
+    void loadCircuitBreakerConfig(boost::property_tree::ptree const& _pt);
+
+private:
+    bool m_callCacheEnabled = false;
+    uint64_t m_callCacheCapacity = 64 * 1024 * 1024;
+    std::set<std::string> m_callCacheAllowlist;
+    int64_t m_codeCacheMaxBlockAge = 10;
+    int64_t m_logQueryMaxBlockRange = 1000;
+    uint64_t m_logQueryMaxResultCount = 10000;
+    uint64_t m_logQueryFetchWindow = 8;
+    uint64_t m_filterTimeout = 5 * 60 * 1000;
+    size_t m_maxFilterCount = 10000;
+    bool m_hedgeEnabled = false;
+    double m_hedgePercentile = 0.95;
+    double m_hedgeTokenRatio = 0.05;
+    bool m_writeSessionEnabled = false;
+    CircuitBreakerConfig m_circuitBreakerConfig;
+    std::string m_eventBloomPath;
+    std::string m_eventLogIndexPath;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -146,37 +146,27 @@ void RpcFactory::registerHandlers(std::shared_ptr<boostssl::ws::WsService> _wsSe
             auto version = ws::EnumPV::CurrentVersion;
             _session->setVersion(version);
 
-            _jsonRpcInterface->getGroupInfoList(
-                [_msg, _session, version, seq](
-                    bcos::Error::Ptr _error, Json::Value& _jGroupInfoList) {
-                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-                    {
-                        BCOS_LOG(ERROR)
-                            << LOG_BADGE("HANDSHAKE") << LOG_DESC("get group info list error")
-                            << LOG_KV("seq", seq)
-                            << LOG_KV("endpoint", _session ? _session->endPoint() : std::string(""))
-                            << LOG_KV("errorCode", _error->errorCode())
-                            << LOG_KV("errorMessage", _error->errorMessage());
-                        return;
-                    }
-
-                    auto pv = std::make_shared<ws::ProtocolVersion>();
-                    pv->setProtocolVersion(version);
-                    auto jResult = pv->toJson();
-                    jResult["groupInfoList"] = _jGroupInfoList;
-
-                    Json::FastWriter writer;
-                    std::string result = writer.write(jResult);
-
-                    _msg->setData(std::make_shared<bcos::bytes>(result.begin(), result.end()));
-                    _session->asyncSendMessage(_msg);
-
-                    BCOS_LOG(INFO)
-                        << LOG_BADGE("HANDSHAKE") << LOG_DESC("handshake response")
-                        << LOG_KV("version", version) << LOG_KV("seq", seq)
-                        << LOG_KV("endpoint", _session ? _session->endPoint() : std::string(""))
-                        << LOG_KV("result", result);
-                });
+            // the client with many groups requests only the groupIDs by {"onlyGroupID": true},
+            // and fetches the group info by getGroupInfo when used
+            bool onlyGroupID = false;
+            Json::Value request;
+            Json::Reader reader;
+            if (reader.parse(seq, request) && request.isObject())
+            {
+                onlyGroupID = request.get("onlyGroupID", false).asBool();
+            }
+            // the response is serialized once per version of the group info list and shared
+            // by the handshakes, which avoids re-serializing in the reconnect storm
+            auto response =
+                _jsonRpcInterface->groupInfoCache()->handshakeResponse(version, onlyGroupID);
+            _msg->setData(response);
+            _session->asyncSendMessage(_msg);
+
+            BCOS_LOG(INFO) << LOG_BADGE("HANDSHAKE") << LOG_DESC("handshake response")
+                           << LOG_KV("version", version) << LOG_KV("seq", seq)
+                           << LOG_KV("endpoint", _session ? _session->endPoint() : std::string(""))
+                           << LOG_KV("onlyGroupID", onlyGroupID)
+                           << LOG_KV("responseSize", response->size());
         });
 
     _wsService->registerMsgHandler(bcos::rpc::MessageType::RPC_REQUEST,
@@ -206,11 +196,44 @@ void RpcFactory::registerHandlers(std::shared_ptr<boostssl::ws::WsService> _wsSe
             });
         });
 }
+
+void RpcFactory::loadRpcConfig()
+{
+    std::call_once(m_loadRpcConfigOnce, [this]() {
+        if (m_configPath.empty())
+        {
+            BCOS_LOG(INFO) << LOG_DESC("[RPC][FACTORY][loadRpcConfig]")
+                           << LOG_DESC("no config path, use the default rpc config");
+            return;
+        }
+        m_rpcConfig->loadConfig(m_configPath);
+    });
+}
+
 bcos::rpc::JsonRpcImpl_2_0::Ptr RpcFactory::buildJsonRpc(
     std::shared_ptr<boostssl::ws::WsService> _wsService, GroupManager::Ptr _groupManager)
 {
+    loadRpcConfig();
     // JsonRpcImpl_2_0
     auto jsonRpcInterface = std::make_shared<bcos::rpc::JsonRpcImpl_2_0>(_groupManager, m_gateway);
+    auto callResultCache = jsonRpcInterface->callResultCache();
+    callResultCache->setEnabled(m_rpcConfig->callCacheEnabled());
+    callResultCache->setCapacity(m_rpcConfig->callCacheCapacity());
+    callResultCache->setAllowlist(m_rpcConfig->callCacheAllowlist());
+    jsonRpcInterface->codeCache()->setMaxBlockAge(m_rpcConfig->codeCacheMaxBlockAge());
+    auto logQuery = jsonRpcInterface->logQuery();
+    logQuery->setMaxBlockRange(m_rpcConfig->logQueryMaxBlockRange());
+    logQuery->setMaxResultCount(m_rpcConfig->logQueryMaxResultCount());
+    logQuery->setFetchWindow(m_rpcConfig->logQueryFetchWindow());
+    jsonRpcInterface->filterManager()->setFilterTimeout(m_rpcConfig->filterTimeout());
+    jsonRpcInterface->filterManager()->setMaxFilterCount(m_rpcConfig->maxFilterCount());
+    auto requestHedger = jsonRpcInterface->requestHedger();
+    requestHedger->setHedgePercentile(m_rpcConfig->hedgePercentile());
+    requestHedger->setHedgeTokenRatio(m_rpcConfig->hedgeTokenRatio());
+    // the hedge thread is started when enabled
+    requestHedger->setEnabled(m_rpcConfig->hedgeEnabled());
+    // the cleaner timer of the write sessions is started when enabled
+    jsonRpcInterface->writeSessionTracker()->setEnabled(m_rpcConfig->writeSessionEnabled());
     auto httpServer = _wsService->httpServer();
     if (httpServer)
     {
@@ -225,7 +248,9 @@ bcos::event::EventSub::Ptr RpcFactory::buildEventSub(
     std::shared_ptr<boostssl::ws::WsService> _wsService, GroupManager::Ptr _groupManager)
 {
     auto eventSubFactory = std::make_shared<event::EventSubFactory>();
-    auto eventSub = eventSubFactory->buildEventSub();
+    // the event sub tasks are executed by as many threads as the rpc
+    size_t threadNum = m_nodeConfig ? m_nodeConfig->rpcThreadPoolSize() : 8;
+    auto eventSub = eventSubFactory->buildEventSub(threadNum);
 
     auto matcher = std::make_shared<event::EventSubMatcher>();
     eventSub->setIoc(_wsService->ioc());
@@ -298,18 +323,45 @@ Rpc::Ptr RpcFactory::buildRpc(std::shared_ptr<boostssl::ws::WsService> _wsServic
     auto jsonRpc = buildJsonRpc(_wsService, _groupManager);
     // EventSub
     auto es = buildEventSub(_wsService, _groupManager);
+    // the blocks fetched by the event sub and their blooms are shared by the log queries
+    auto bloomIndex = es->blockFeed()->bloomIndex();
+    bloomIndex->setStoragePath(m_rpcConfig->eventBloomPath());
+    jsonRpc->logQuery()->setBloomIndex(bloomIndex);
+    jsonRpc->logQuery()->setBlockFeed(es->blockFeed());
+    // the contracts deployed by the fetched blocks invalidate their cached code
+    auto codeCache = jsonRpc->codeCache();
+    es->blockFeed()->setBlockHandler(
+        [codeCache](std::string const& _group, bcos::protocol::Block::ConstPtr _block) {
+            codeCache->onBlock(_group, _block);
+        });
+    auto const& logIndexPath = m_rpcConfig->eventLogIndexPath();
+    if (!logIndexPath.empty())
+    {
+        // the log index is started and stopped with the event sub
+        auto logIndex = std::make_shared<bcos::event::EventLogIndex>(logIndexPath, _groupManager);
+        es->setLogIndex(logIndex);
+        jsonRpc->logQuery()->setLogIndex(logIndex);
+        BCOS_LOG(INFO) << LOG_DESC("[RPC][FACTORY][buildRpc]")
+                       << LOG_DESC("enable the event log index")
+                       << LOG_KV("path", logIndexPath);
+    }
     return std::make_shared<Rpc>(_wsService, jsonRpc, es, _amopClient);
 }
 
 GroupManager::Ptr RpcFactory::buildGroupManager()
 {
+    // the group manager is built before the json rpc
+    loadRpcConfig();
     auto nodeServiceFactory = std::make_shared<NodeServiceFactory>();
+    nodeServiceFactory->setCircuitBreakerConfig(m_rpcConfig->circuitBreakerConfig());
     return std::make_shared<GroupManager>(m_chainID, nodeServiceFactory);
 }
 
 GroupManager::Ptr RpcFactory::buildLocalGroupManager(
     GroupInfo::Ptr _groupInfo, NodeService::Ptr _nodeService)
 {
+    loadRpcConfig();
+    _nodeService->circuitBreaker()->setConfig(m_rpcConfig->circuitBreakerConfig());
     return std::make_shared<LocalGroupManager>(m_chainID, _groupInfo, _nodeService);
 }
 
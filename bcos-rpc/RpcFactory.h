@@ -31,8 +31,10 @@
 #include <bcos-framework/libtool/NodeConfig.h>
 #include <bcos-rpc/Common.h>
 #include <bcos-rpc/Rpc.h>
+#include <bcos-rpc/RpcConfig.h>
 #include <bcos-rpc/event/EventSub.h>
 #include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
+#include <mutex>
 
 namespace bcos
 {
@@ -84,12 +86,23 @@ public:
     bcos::tool::NodeConfig::Ptr nodeConfig() const { return m_nodeConfig; }
     void setNodeConfig(bcos::tool::NodeConfig::Ptr _nodeConfig) { m_nodeConfig = _nodeConfig; }
 
+    // the options of the caches and the schedulers, loaded from the [rpc] section of the
+    // config.ini at configPath before the rpc is built
+    RpcConfig::Ptr rpcConfig() const { return m_rpcConfig; }
+    void setRpcConfig(RpcConfig::Ptr _rpcConfig) { m_rpcConfig = _rpcConfig; }
+    // the config.ini of the rpc, the defaults are used if empty
+    std::string const& configPath() const { return m_configPath; }
+    void setConfigPath(std::string const& _configPath) { m_configPath = _configPath; }
+
 protected:
     bcos::rpc::JsonRpcImpl_2_0::Ptr buildJsonRpc(
         std::shared_ptr<boostssl::ws::WsService> _wsService, GroupManager::Ptr _groupManager);
     bcos::event::EventSub::Ptr buildEventSub(
         std::shared_ptr<boostssl::ws::WsService> _wsService, GroupManager::Ptr _groupManager);
 
+    // load the [rpc] section once, throw InvalidRpcConfig if the config is invalid
+    void loadRpcConfig();
+
 private:
     void registerHandlers(std::shared_ptr<boostssl::ws::WsService> _wsService,
         bcos::rpc::JsonRpcImpl_2_0::Ptr _jsonRpcInterface);
@@ -99,6 +112,9 @@ private:
     bcos::gateway::GatewayInterface::Ptr m_gateway;
     std::shared_ptr<bcos::crypto::KeyFactory> m_keyFactory;
     bcos::tool::NodeConfig::Ptr m_nodeConfig;
+    RpcConfig::Ptr m_rpcConfig = std::make_shared<RpcConfig>();
+    std::string m_configPath;
+    std::once_flag m_loadRpcConfigOnce;
 };
 }  // namespace rpc
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,342 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the polling filters with server-side cursors
+ * @file EventFilterManager.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventFilterManager.h>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+
+EventFilterManager::EventFilterManager(
+    bcos::rpc::GroupManager::Ptr _groupManager, EventLogQuery::Ptr _logQuery)
+  : m_groupManager(_groupManager), m_logQuery(_logQuery)
+{
+    m_filterCleaner = std::make_shared<Timer>(10000, "filterCleaner");
+    m_filterCleaner->registerTimeoutHandler([this]() { removeExpiredFilters(); });
+    m_filterCleaner->start();
+}
+
+EventFilterManager::~EventFilterManager()
+{
+    if (m_filterCleaner)
+    {
+        m_filterCleaner->stop();
+    }
+}
+
+std::string EventFilterManager::newFilter(
+    std::string const& _group, EventSubParams::ConstPtr _params)
+{
+    // the logs of the blocks after the filter created are returned if fromBlock not specified
+    auto nextBlock = _params->fromBlock() >= 0 ?
+                         _params->fromBlock() :
+                         m_groupManager->getBlockNumberByGroup(_group) + 1;
+    return addFilter(_group, EventFilterType::LOG_FILTER, _params, nextBlock);
+}
+
+std::string EventFilterManager::newBlockFilter(std::string const& _group)
+{
+    auto nextBlock = m_groupManager->getBlockNumberByGroup(_group) + 1;
+    return addFilter(
+        _group, EventFilterType::BLOCK_FILTER, std::make_shared<EventSubParams>(), nextBlock);
+}
+
+std::string EventFilterManager::addFilter(std::string const& _group, EventFilterType _type,
+    EventSubParams::ConstPtr _params, int64_t _nextBlock)
+{
+    WriteGuard l(x_filters);
+    if (m_filters.size() >= m_maxFilterCount.load())
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventFilterManager")
+                           << LOG_DESC("exceed the max filter count")
+                           << LOG_KV("count", m_filters.size()) << LOG_KV("group", _group);
+        return "";
+    }
+    static boost::uuids::random_generator uuidGenerator;
+    auto id = boost::uuids::to_string(uuidGenerator());
+    m_filters[id] = std::make_shared<EventFilter>(id, _group, _type, _params, _nextBlock);
+    EVENT_SUB(INFO) << LOG_BADGE("EventFilterManager") << LOG_DESC("add filter")
+                    << LOG_KV("id", id) << LOG_KV("group", _group) << LOG_KV("type", (int)_type)
+                    << LOG_KV("nextBlock", _nextBlock) << LOG_KV("count", m_filters.size());
+    return id;
+}
+
+bool EventFilterManager::uninstallFilter(std::string const& _filterID)
+{
+    WriteGuard l(x_filters);
+    auto removed = m_filters.erase(_filterID) > 0;
+    EVENT_SUB(INFO) << LOG_BADGE("EventFilterManager") << LOG_DESC("uninstall filter")
+                    << LOG_KV("id", _filterID) << LOG_KV("removed", removed);
+    return removed;
+}
+
+EventFilter::Ptr EventFilterManager::getFilter(std::string const& _filterID)
+{
+    ReadGuard l(x_filters);
+    auto it = m_filters.find(_filterID);
+    if (it == m_filters.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void EventFilterManager::getFilterChanges(std::string const& _filterID, Callback _callback)
+{
+    auto filter = getFilter(_filterID);
+    if (!filter)
+    {
+        Json::Value jResp;
+        _callback(std::make_shared<Error>(
+                      EP_STATUS_CODE::NONEXISTENT_EVENT, "filter not found: " + _filterID),
+            jResp);
+        return;
+    }
+    filter->touch();
+
+    // the changes are being fetched by another poll
+    if (!filter->tryStartPolling())
+    {
+        Json::Value jResp(Json::arrayValue);
+        _callback(nullptr, jResp);
+        return;
+    }
+
+    auto fromBlock = filter->nextBlock();
+    auto toBlock = m_groupManager->getBlockNumberByGroup(filter->group());
+    auto params = filter->params();
+    if (params->toBlock() >= 0)
+    {
+        toBlock = std::min(toBlock, params->toBlock());
+    }
+    // the remaining blocks are returned by the next poll
+    auto maxBlockRange = m_logQuery->maxBlockRange();
+    if (maxBlockRange > 0)
+    {
+        toBlock = std::min(toBlock, fromBlock + maxBlockRange - 1);
+    }
+    if (fromBlock > toBlock)
+    {
+        filter->finishPolling();
+        Json::Value jResp(Json::arrayValue);
+        _callback(nullptr, jResp);
+        return;
+    }
+
+    if (filter->type() == EventFilterType::BLOCK_FILTER)
+    {
+        pollBlockHashes(filter, fromBlock, toBlock, _callback);
+        return;
+    }
+
+    pollLogs(filter, fromBlock, toBlock, m_logQuery->maxResultCount(), _callback);
+}
+
+void EventFilterManager::pollLogs(EventFilter::Ptr _filter, int64_t _fromBlock,
+    int64_t _toBlock, uint64_t _maxResultCount, Callback _callback)
+{
+    auto queryParams = std::make_shared<EventSubParams>(*_filter->params());
+    queryParams->setFromBlock(_fromBlock);
+    queryParams->setToBlock(_toBlock);
+    auto self = std::weak_ptr<EventFilterManager>(shared_from_this());
+    m_logQuery->query(_filter->group(), queryParams, _maxResultCount,
+        [self, _filter, _fromBlock, _toBlock, _maxResultCount, _callback](
+            Error::Ptr _error, Json::Value& _result) {
+            auto manager = self.lock();
+            if (_error && _error->errorCode() == EP_STATUS_CODE::INVALID_REQUEST_RANGE && manager)
+            {
+                // too many logs in the range, the rest blocks are returned by the next poll
+                if (_toBlock > _fromBlock)
+                {
+                    manager->pollLogs(_filter, _fromBlock,
+                        _fromBlock + (_toBlock - _fromBlock) / 2, _maxResultCount, _callback);
+                    return;
+                }
+                // the logs of a block are never split across the polls, the single block
+                // exceeding the limit is returned uncapped instead of being skipped
+                if (_maxResultCount > 0)
+                {
+                    EVENT_SUB(WARNING) << LOG_BADGE("EventFilterManager")
+                                       << LOG_DESC("return the block exceeding the limits")
+                                       << LOG_KV("id", _filter->id())
+                                       << LOG_KV("group", _filter->group())
+                                       << LOG_KV("blockNumber", _fromBlock);
+                    manager->pollLogs(_filter, _fromBlock, _toBlock, 0, _callback);
+                    return;
+                }
+            }
+            else if (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS)
+            {
+                _filter->setNextBlock(_toBlock + 1);
+            }
+            _filter->finishPolling();
+            _callback(_error, _result);
+        });
+}
+
+namespace
+{
+struct BlockHashesContext
+{
+    using Ptr = std::shared_ptr<BlockHashesContext>;
+    EventFilter::Ptr filter;
+    bcos::ledger::LedgerInterface::Ptr ledger;
+    EventFilterManager::Callback callback;
+    int64_t fromBlock;
+    int64_t toBlock;
+
+    bcos::Mutex x_context;
+    std::vector<std::string> hashes;
+    int64_t nextBlock;
+    int64_t inFlight = 0;
+    Error::Ptr error;
+};
+
+void fetchBlockHash(BlockHashesContext::Ptr _context, int64_t _blockNumber)
+{
+    _context->ledger->asyncGetBlockHashByNumber(
+        _blockNumber, [_context, _blockNumber](Error::Ptr _error, crypto::HashType const& _hash) {
+            int64_t nextBlock = -1;
+            bool finished = false;
+            {
+                Guard l(_context->x_context);
+                if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+                {
+                    _context->error = _error;
+                }
+                else
+                {
+                    _context->hashes[_blockNumber - _context->fromBlock] = _hash.hexPrefixed();
+                }
+                // the fetched block is replaced by the next one, keep the number in flight
+                if (!_context->error && _context->nextBlock <= _context->toBlock)
+                {
+                    nextBlock = _context->nextBlock++;
+                }
+                else
+                {
+                    finished = (--_context->inFlight == 0);
+                }
+            }
+            if (nextBlock >= 0)
+            {
+                fetchBlockHash(_context, nextBlock);
+                return;
+            }
+            if (!finished)
+            {
+                return;
+            }
+            Json::Value jResp(Json::arrayValue);
+            if (!_context->error)
+            {
+                for (auto const& hash : _context->hashes)
+                {
+                    jResp.append(hash);
+                }
+                _context->filter->setNextBlock(_context->toBlock + 1);
+            }
+            _context->filter->finishPolling();
+            _context->callback(_context->error, jResp);
+        });
+}
+}  // namespace
+
+void EventFilterManager::pollBlockHashes(
+    EventFilter::Ptr _filter, int64_t _fromBlock, int64_t _toBlock, Callback _callback)
+{
+    auto nodeService = m_groupManager->getNodeService(_filter->group(), "");
+    if (!nodeService)
+    {
+        _filter->finishPolling();
+        Json::Value jResp;
+        _callback(std::make_shared<Error>(EP_STATUS_CODE::GROUP_NOT_EXIST,
+                      "the group does not exist: " + _filter->group()),
+            jResp);
+        return;
+    }
+
+    auto context = std::make_shared<BlockHashesContext>();
+    context->filter = _filter;
+    context->ledger = nodeService->ledger();
+    context->callback = _callback;
+    context->fromBlock = _fromBlock;
+    context->toBlock = _toBlock;
+    context->nextBlock = _fromBlock;
+    context->hashes.resize(_toBlock - _fromBlock + 1);
+
+    // the blocks to fetch are taken before any fetch, so that no fetch finishes the poll early
+    std::vector<int64_t> blocks;
+    {
+        Guard l(context->x_context);
+        auto window = std::min((int64_t)m_logQuery->fetchWindow(), _toBlock - _fromBlock + 1);
+        for (int64_t i = 0; i < window; ++i)
+        {
+            blocks.push_back(context->nextBlock++);
+        }
+        context->inFlight = window;
+    }
+    for (auto blockNumber : blocks)
+    {
+        fetchBlockHash(context, blockNumber);
+    }
+}
+
+void EventFilterManager::removeExpiredFilters()
+{
+    m_filterCleaner->restart();
+    auto now = utcTime();
+    auto filterTimeout = m_filterTimeout.load();
+    std::vector<std::string> expiredFilters;
+    {
+        ReadGuard l(x_filters);
+        for (auto const& it : m_filters)
+        {
+            if (now > it.second->lastActiveTime() + filterTimeout)
+            {
+                expiredFilters.push_back(it.first);
+            }
+        }
+    }
+    if (expiredFilters.empty())
+    {
+        return;
+    }
+    WriteGuard l(x_filters);
+    for (auto const& id : expiredFilters)
+    {
+        auto it = m_filters.find(id);
+        // the filter may be polled after the check
+        if (it != m_filters.end() && now > it->second->lastActiveTime() + filterTimeout)
+        {
+            m_filters.erase(it);
+        }
+    }
+    EVENT_SUB(INFO) << LOG_BADGE("EventFilterManager") << LOG_DESC("remove expired filters")
+                    << LOG_KV("expired", expiredFilters.size())
+                    << LOG_KV("count", m_filters.size());
+}
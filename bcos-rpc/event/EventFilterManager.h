@@ -0,0 +1,147 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the polling filters with server-side cursors
+ * @file EventFilterManager.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <bcos-rpc/event/EventLogQuery.h>
+#include <bcos-rpc/event/EventSubParams.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <json/json.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace event
+{
+enum class EventFilterType : int
+{
+    LOG_FILTER = 0,
+    BLOCK_FILTER = 1,
+};
+
+class EventFilter
+{
+public:
+    using Ptr = std::shared_ptr<EventFilter>;
+
+    EventFilter(std::string const& _id, std::string const& _group, EventFilterType _type,
+        EventSubParams::ConstPtr _params, int64_t _nextBlock)
+      : m_id(_id), m_group(_group), m_type(_type), m_params(_params), m_nextBlock(_nextBlock)
+    {
+        touch();
+    }
+
+    std::string const& id() const { return m_id; }
+    std::string const& group() const { return m_group; }
+    EventFilterType type() const { return m_type; }
+    EventSubParams::ConstPtr params() const { return m_params; }
+
+    // the first block that has not been returned to the client
+    int64_t nextBlock() const { return m_nextBlock.load(); }
+    void setNextBlock(int64_t _nextBlock) { m_nextBlock.store(_nextBlock); }
+
+    // only one poll of the filter is processed at the same time
+    bool tryStartPolling() { return !m_polling.exchange(true); }
+    void finishPolling() { m_polling.store(false); }
+
+    uint64_t lastActiveTime() const { return m_lastActiveTime.load(); }
+    void touch() { m_lastActiveTime.store(utcTime()); }
+
+private:
+    std::string m_id;
+    std::string m_group;
+    EventFilterType m_type;
+    EventSubParams::ConstPtr m_params;
+    std::atomic<int64_t> m_nextBlock;
+    std::atomic_bool m_polling = {false};
+    std::atomic<uint64_t> m_lastActiveTime = {0};
+};
+
+/**
+ * @brief manage the filters polled by the clients without the event subscription, each filter
+ * keeps the cursor of the next block, the changes since the last poll are returned, and the
+ * filters not polled for filterTimeout are removed
+ */
+class EventFilterManager : public std::enable_shared_from_this<EventFilterManager>
+{
+public:
+    using Ptr = std::shared_ptr<EventFilterManager>;
+    using Callback = std::function<void(Error::Ptr, Json::Value&)>;
+
+    EventFilterManager(bcos::rpc::GroupManager::Ptr _groupManager, EventLogQuery::Ptr _logQuery);
+    virtual ~EventFilterManager();
+
+public:
+    // create the log filter, return the filter id
+    virtual std::string newFilter(std::string const& _group, EventSubParams::ConstPtr _params);
+    // create the filter for the new blocks, return the filter id
+    virtual std::string newBlockFilter(std::string const& _group);
+    // get the logs or the block hashes since the last poll
+    virtual void getFilterChanges(std::string const& _filterID, Callback _callback);
+    virtual bool uninstallFilter(std::string const& _filterID);
+
+public:
+    // the filters that have not been polled for filterTimeout ms are removed
+    uint64_t filterTimeout() const { return m_filterTimeout.load(); }
+    void setFilterTimeout(uint64_t _filterTimeout) { m_filterTimeout.store(_filterTimeout); }
+
+    // the max number of the filters
+    size_t maxFilterCount() const { return m_maxFilterCount.load(); }
+    void setMaxFilterCount(size_t _maxFilterCount) { m_maxFilterCount.store(_maxFilterCount); }
+
+    size_t filterCount() const
+    {
+        ReadGuard l(x_filters);
+        return m_filters.size();
+    }
+
+private:
+    EventFilter::Ptr getFilter(std::string const& _filterID);
+    std::string addFilter(std::string const& _group, EventFilterType _type,
+        EventSubParams::ConstPtr _params, int64_t _nextBlock);
+    // the range is halved until the logs of it are within the limits of the log query, the logs
+    // of the single block exceeding the limits are returned uncapped
+    void pollLogs(EventFilter::Ptr _filter, int64_t _fromBlock, int64_t _toBlock,
+        uint64_t _maxResultCount, Callback _callback);
+    // the hashes are fetched with at most fetchWindow blocks of the log query in flight
+    void pollBlockHashes(EventFilter::Ptr _filter, int64_t _fromBlock, int64_t _toBlock,
+        Callback _callback);
+    void removeExpiredFilters();
+
+private:
+    bcos::rpc::GroupManager::Ptr m_groupManager;
+    EventLogQuery::Ptr m_logQuery;
+
+    std::unordered_map<std::string, EventFilter::Ptr> m_filters;
+    mutable SharedMutex x_filters;
+
+    std::atomic<uint64_t> m_filterTimeout = {5 * 60 * 1000};
+    std::atomic<size_t> m_maxFilterCount = {10000};
+    std::shared_ptr<Timer> m_filterCleaner;
+};
+}  // namespace event
+}  // namespace bcos
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the bloom filter of the log addresses and topics of a block
+ * @file EventLogBloom.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/TransactionReceipt.h>
+#include <bcos-framework/libutilities/DataConvertUtility.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventLogBloom.h>
+#include <algorithm>
+#include <sys/stat.h>
+
+using namespace bcos;
+using namespace bcos::event;
+
+LogBloom LogBloom::fromBlock(bcos::protocol::Block::ConstPtr _block)
+{
+    LogBloom bloom;
+    for (std::size_t index = 0; index < _block->transactionsSize(); index++)
+    {
+        auto receipt = _block->receipt(index);
+        for (const auto& logEntry : receipt->logEntries())
+        {
+            bloom.addAddress(logEntry.address());
+            for (const auto& topic : logEntry.topics())
+            {
+                bloom.addTopic(topic);
+            }
+        }
+    }
+    return bloom;
+}
+
+uint64_t LogBloom::hash(const uint8_t* _data, std::size_t _size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < _size; i++)
+    {
+        hash ^= _data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void LogBloom::add(const uint8_t* _data, std::size_t _size)
+{
+    auto itemHash = hash(_data, _size);
+    // each 11 bits of the hash selects one of the 2048 bits
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        auto bit = (itemHash >> (i * 11)) & 0x7FF;
+        m_bits[bit / 8] |= (uint8_t)(1 << (bit % 8));
+    }
+}
+
+bool LogBloom::contains(const uint8_t* _data, std::size_t _size) const
+{
+    auto itemHash = hash(_data, _size);
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        auto bit = (itemHash >> (i * 11)) & 0x7FF;
+        if ((m_bits[bit / 8] & (uint8_t)(1 << (bit % 8))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LogBloom::empty() const
+{
+    return std::all_of(m_bits.begin(), m_bits.end(), [](uint8_t _byte) { return _byte == 0; });
+}
+
+bool LogBloom::mayMatch(EventSubParams const& _params) const
+{
+    // the same rules as the matcher: one of the addresses and one of the topics of each index
+    const auto& addresses = _params.addresses();
+    if (!addresses.empty() &&
+        std::none_of(addresses.begin(), addresses.end(),
+            [this](std::string const& _address) { return containsAddress(_address); }))
+    {
+        return false;
+    }
+    const auto& topics = _params.topics();
+    const auto& topicKeys = _params.topicKeys();
+    for (std::size_t i = 0; i < topics.size(); i++)
+    {
+        if (topics[i].empty())
+        {
+            continue;
+        }
+        // the topics not a 32 bytes hex have no key and never match
+        if (i >= topicKeys.size() ||
+            std::none_of(topicKeys[i].begin(), topicKeys[i].end(),
+                [this](bcos::crypto::HashType const& _topic) { return containsTopic(_topic); }))
+        {
+            return false;
+        }
+    }
+    // the params without addresses and topics match all the logs
+    return !empty();
+}
+
+std::string EventLogBloomIndex::fileName(std::string const& _group)
+{
+    return bcos::toHex(_group) + ".bloom";
+}
+
+EventLogBloomIndex::GroupBlooms::Ptr EventLogBloomIndex::groupBlooms(std::string const& _group)
+{
+    Guard l(x_groupBlooms);
+    auto& groupBlooms = m_groupBlooms[_group];
+    if (!groupBlooms)
+    {
+        groupBlooms = std::make_shared<GroupBlooms>();
+    }
+    return groupBlooms;
+}
+
+void EventLogBloomIndex::addBlock(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, bcos::protocol::Block::ConstPtr _block)
+{
+    if (!_block || _blockNumber < 0)
+    {
+        return;
+    }
+    auto groupBlooms = this->groupBlooms(_group);
+    {
+        Guard l(groupBlooms->x_blooms);
+        if (groupBlooms->blooms.count(_blockNumber))
+        {
+            return;
+        }
+    }
+    // computed outside the lock, the block is immutable
+    auto bloom = LogBloom::fromBlock(_block);
+    {
+        Guard l(groupBlooms->x_blooms);
+        insertWithoutLock(*groupBlooms, _blockNumber, bloom);
+    }
+    // the I/O only blocks the I/O of the same group
+    Guard l(groupBlooms->x_file);
+    storeWithoutLock(_group, *groupBlooms, _blockNumber, bloom);
+}
+
+bool EventLogBloomIndex::mayMatch(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, EventSubParams const& _params)
+{
+    auto groupBlooms = this->groupBlooms(_group);
+    LogBloom bloom;
+    bool found = false;
+    {
+        Guard l(groupBlooms->x_blooms);
+        auto it = groupBlooms->blooms.find(_blockNumber);
+        if (it != groupBlooms->blooms.end())
+        {
+            bloom = it->second;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        {
+            Guard l(groupBlooms->x_file);
+            found = loadWithoutLock(_group, *groupBlooms, _blockNumber, bloom);
+        }
+        if (!found)
+        {
+            // the block has never been fetched
+            return true;
+        }
+        Guard l(groupBlooms->x_blooms);
+        insertWithoutLock(*groupBlooms, _blockNumber, bloom);
+    }
+    if (bloom.mayMatch(_params))
+    {
+        return true;
+    }
+    m_skipCount++;
+    return false;
+}
+
+bool EventLogBloomIndex::genesisHashRequired(std::string const& _group)
+{
+    if (storagePath().empty())
+    {
+        return false;
+    }
+    auto groupBlooms = this->groupBlooms(_group);
+    Guard l(groupBlooms->x_file);
+    if (groupBlooms->genesisHashKnown || groupBlooms->genesisHashRequested)
+    {
+        return false;
+    }
+    groupBlooms->genesisHashRequested = true;
+    return true;
+}
+
+void EventLogBloomIndex::resetGenesisHashRequest(std::string const& _group)
+{
+    auto groupBlooms = this->groupBlooms(_group);
+    Guard l(groupBlooms->x_file);
+    groupBlooms->genesisHashRequested = false;
+}
+
+void EventLogBloomIndex::setGenesisHash(
+    std::string const& _group, bcos::crypto::HashType const& _genesisHash)
+{
+    auto groupBlooms = this->groupBlooms(_group);
+    Guard l(groupBlooms->x_file);
+    if (groupBlooms->genesisHashKnown && groupBlooms->genesisHash == _genesisHash)
+    {
+        return;
+    }
+    groupBlooms->genesisHash = _genesisHash;
+    groupBlooms->genesisHashKnown = true;
+    groupBlooms->genesisHashRequested = false;
+    // reopened and checked against the genesis hash
+    groupBlooms->file = nullptr;
+    groupBlooms->fileOpened = false;
+}
+
+void EventLogBloomIndex::insertWithoutLock(GroupBlooms& _groupBlooms,
+    bcos::protocol::BlockNumber _blockNumber, LogBloom const& _bloom)
+{
+    _groupBlooms.blooms[_blockNumber] = _bloom;
+    auto maxBlocksPerGroup = m_maxBlocksPerGroup.load();
+    while (_groupBlooms.blooms.size() > maxBlocksPerGroup)
+    {
+        // the lowest blocks are the least likely to be scanned again
+        _groupBlooms.blooms.erase(_groupBlooms.blooms.begin());
+    }
+}
+
+namespace
+{
+constexpr char c_bloomFileMagic[] = "LOGBLOOM";
+}  // namespace
+
+std::shared_ptr<std::fstream> EventLogBloomIndex::openFileWithoutLock(
+    std::string const& _group, GroupBlooms& _groupBlooms)
+{
+    if (_groupBlooms.fileOpened)
+    {
+        return _groupBlooms.file;
+    }
+    auto storagePath = this->storagePath();
+    // the blooms of an unknown chain are never persisted nor loaded
+    if (storagePath.empty() || !_groupBlooms.genesisHashKnown)
+    {
+        return nullptr;
+    }
+    _groupBlooms.fileOpened = true;
+    ::mkdir(storagePath.c_str(), 0755);
+    auto filePath = storagePath + "/" + fileName(_group);
+    auto mode = std::ios::in | std::ios::out | std::ios::binary;
+    auto file = std::make_shared<std::fstream>(filePath, mode);
+    std::array<char, c_headerSize> header;
+    std::copy(c_bloomFileMagic, c_bloomFileMagic + c_magicSize, header.begin());
+    std::copy(_groupBlooms.genesisHash.data(),
+        _groupBlooms.genesisHash.data() + bcos::crypto::HashType::size,
+        header.begin() + c_magicSize);
+    bool valid = false;
+    if (file->is_open())
+    {
+        std::array<char, c_headerSize> persistedHeader;
+        file->read(persistedHeader.data(), persistedHeader.size());
+        valid = (*file) && persistedHeader == header;
+        file->clear();
+        if (!valid)
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("EventLogBloomIndex")
+                               << LOG_DESC("the bloom file belongs to another chain, reset it")
+                               << LOG_KV("group", _group) << LOG_KV("path", filePath);
+        }
+    }
+    if (!valid)
+    {
+        // create or truncate the file
+        file->close();
+        std::ofstream(filePath, std::ios::out | std::ios::binary | std::ios::trunc)
+            .write(header.data(), header.size());
+        file->open(filePath, mode);
+    }
+    if (!file->is_open())
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventLogBloomIndex")
+                           << LOG_DESC("open the bloom file failed, keep the blooms in memory")
+                           << LOG_KV("group", _group) << LOG_KV("path", filePath);
+        return nullptr;
+    }
+    EVENT_SUB(INFO) << LOG_BADGE("EventLogBloomIndex") << LOG_DESC("open the bloom file")
+                    << LOG_KV("group", _group) << LOG_KV("path", filePath)
+                    << LOG_KV("genesisHash", _groupBlooms.genesisHash.abridged());
+    _groupBlooms.file = file;
+    return file;
+}
+
+bool EventLogBloomIndex::loadWithoutLock(std::string const& _group, GroupBlooms& _groupBlooms,
+    bcos::protocol::BlockNumber _blockNumber, LogBloom& _bloom)
+{
+    auto file = openFileWithoutLock(_group, _groupBlooms);
+    if (!file)
+    {
+        return false;
+    }
+    std::array<char, c_recordSize> record;
+    file->seekg((std::streamoff)c_headerSize + (std::streamoff)_blockNumber * c_recordSize);
+    file->read(record.data(), record.size());
+    if (!(*file) || record[0] != 1)
+    {
+        // beyond the end of the file or the hole of the blocks not fetched
+        file->clear();
+        return false;
+    }
+    LogBloom::Bytes bits;
+    std::copy(record.begin() + 1, record.end(), bits.begin());
+    _bloom = LogBloom(bits);
+    return true;
+}
+
+void EventLogBloomIndex::storeWithoutLock(std::string const& _group, GroupBlooms& _groupBlooms,
+    bcos::protocol::BlockNumber _blockNumber, LogBloom const& _bloom)
+{
+    auto file = openFileWithoutLock(_group, _groupBlooms);
+    if (!file)
+    {
+        return;
+    }
+    std::array<char, c_recordSize> record;
+    record[0] = 1;
+    std::copy(_bloom.bits().begin(), _bloom.bits().end(), record.begin() + 1);
+    file->seekp((std::streamoff)c_headerSize + (std::streamoff)_blockNumber * c_recordSize);
+    file->write(record.data(), record.size());
+    file->flush();
+    if (!(*file))
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventLogBloomIndex") << LOG_DESC("store the bloom failed")
+                           << LOG_KV("group", _group) << LOG_KV("blockNumber", _blockNumber);
+        file->clear();
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the bloom filter of the log addresses and topics of a block
+ * @file EventLogBloom.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-rpc/event/EventSubParams.h>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief 2048 bits set by the addresses and the topics of all the logs of a block, each item sets
+ * 3 bits; a block whose bloom misses the addresses or the topics of the params has no matched log
+ */
+class LogBloom
+{
+public:
+    static constexpr std::size_t c_bytes = 256;
+    using Bytes = std::array<uint8_t, c_bytes>;
+
+    LogBloom() { m_bits.fill(0); }
+    explicit LogBloom(Bytes const& _bits) : m_bits(_bits) {}
+
+    static LogBloom fromBlock(bcos::protocol::Block::ConstPtr _block);
+
+    void addAddress(std::string_view _address)
+    {
+        add((const uint8_t*)_address.data(), _address.size());
+    }
+    void addTopic(bcos::crypto::HashType const& _topic) { add(_topic.data(), _topic.size); }
+    bool containsAddress(std::string_view _address) const
+    {
+        return contains((const uint8_t*)_address.data(), _address.size());
+    }
+    bool containsTopic(bcos::crypto::HashType const& _topic) const
+    {
+        return contains(_topic.data(), _topic.size);
+    }
+
+    // the block without any log
+    bool empty() const;
+    // false only if no log of the block can match the params
+    bool mayMatch(EventSubParams const& _params) const;
+
+    Bytes const& bits() const { return m_bits; }
+
+private:
+    // the stable FNV-1a hash, so the blooms persisted are valid after restart
+    static uint64_t hash(const uint8_t* _data, std::size_t _size);
+    void add(const uint8_t* _data, std::size_t _size);
+    bool contains(const uint8_t* _data, std::size_t _size) const;
+
+private:
+    Bytes m_bits;
+};
+
+/**
+ * @brief the blooms of the blocks fetched by the rpc, so the blocks without the candidate logs
+ * are not fetched again by the event sub tasks and the log queries; at most maxBlocksPerGroup
+ * blooms of a group are kept in memory(the lowest blocks are evicted first), and all the blooms
+ * are persisted to <storagePath>/<hex of the group>.bloom when the storage path is set
+ *
+ * the file starts with the genesis hash of the group, the blooms are persisted only after the
+ * genesis hash is set, and the file of another chain(e.g. reset with the same group) is
+ * truncated; each group has its own locks, and the file I/O never holds the lock of the blooms
+ * in memory
+ */
+class EventLogBloomIndex
+{
+public:
+    using Ptr = std::shared_ptr<EventLogBloomIndex>;
+
+    EventLogBloomIndex() = default;
+    virtual ~EventLogBloomIndex() {}
+
+    // compute the bloom of the fetched block
+    virtual void addBlock(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        bcos::protocol::Block::ConstPtr _block);
+    // false only if the bloom of the block is known and no log of the block can match the params
+    virtual bool mayMatch(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        EventSubParams const& _params);
+
+    // true at most once until the genesis hash is set or the request is reset, if the blooms of
+    // the group should be persisted but the genesis hash of the group is unknown, the caller
+    // fetches the genesis hash and calls setGenesisHash, or resetGenesisHashRequest if failed
+    virtual bool genesisHashRequired(std::string const& _group);
+    virtual void resetGenesisHashRequest(std::string const& _group);
+    virtual void setGenesisHash(
+        std::string const& _group, bcos::crypto::HashType const& _genesisHash);
+
+public:
+    // the directory to persist the blooms, created if not exists, empty means in memory only
+    std::string storagePath() const
+    {
+        Guard l(x_storagePath);
+        return m_storagePath;
+    }
+    void setStoragePath(std::string const& _storagePath)
+    {
+        Guard l(x_storagePath);
+        m_storagePath = _storagePath;
+    }
+
+    size_t maxBlocksPerGroup() const { return m_maxBlocksPerGroup.load(); }
+    void setMaxBlocksPerGroup(size_t _maxBlocksPerGroup)
+    {
+        m_maxBlocksPerGroup.store(std::max(_maxBlocksPerGroup, (size_t)1));
+    }
+
+    // the number of the blocks skipped by the blooms
+    uint64_t skipCount() const { return m_skipCount.load(); }
+
+    // the file of the group, the group is hex encoded so that different groups never share a file
+    static std::string fileName(std::string const& _group);
+
+private:
+    struct GroupBlooms
+    {
+        using Ptr = std::shared_ptr<GroupBlooms>;
+        std::map<bcos::protocol::BlockNumber, LogBloom> blooms;
+        Mutex x_blooms;
+
+        // the members below are protected by x_file
+        bcos::crypto::HashType genesisHash;
+        bool genesisHashKnown = false;
+        bool genesisHashRequested = false;
+        // the header and the fixed size records of the persisted blooms indexed by block number
+        std::shared_ptr<std::fstream> file;
+        bool fileOpened = false;
+        Mutex x_file;
+    };
+    // the magic and the genesis hash
+    static constexpr std::size_t c_magicSize = 8;
+    static constexpr std::size_t c_headerSize = c_magicSize + bcos::crypto::HashType::size;
+    // a valid flag and the bloom
+    static constexpr std::size_t c_recordSize = 1 + LogBloom::c_bytes;
+
+    GroupBlooms::Ptr groupBlooms(std::string const& _group);
+    std::shared_ptr<std::fstream> openFileWithoutLock(
+        std::string const& _group, GroupBlooms& _groupBlooms);
+    bool loadWithoutLock(std::string const& _group, GroupBlooms& _groupBlooms,
+        bcos::protocol::BlockNumber _blockNumber, LogBloom& _bloom);
+    void storeWithoutLock(std::string const& _group, GroupBlooms& _groupBlooms,
+        bcos::protocol::BlockNumber _blockNumber, LogBloom const& _bloom);
+    void insertWithoutLock(GroupBlooms& _groupBlooms, bcos::protocol::BlockNumber _blockNumber,
+        LogBloom const& _bloom);
+
+private:
+    // only guards the lookup of the groups
+    std::unordered_map<std::string, GroupBlooms::Ptr> m_groupBlooms;
+    Mutex x_groupBlooms;
+    std::string m_storagePath;
+    mutable Mutex x_storagePath;
+
+    // 4MB per group
+    std::atomic<size_t> m_maxBlocksPerGroup = {16384};
+    std::atomic<uint64_t> m_skipCount = {0};
+};
+}  // namespace event
+}  // namespace bcos
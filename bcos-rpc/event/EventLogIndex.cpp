@@ -0,0 +1,884 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the persistent index of the log addresses and topics of the blocks
+ * @file EventLogIndex.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/ledger/LedgerInterface.h>
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/interfaces/protocol/TransactionReceipt.h>
+#include <bcos-framework/libutilities/DataConvertUtility.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventLogIndex.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <map>
+#include <numeric>
+#include <tuple>
+
+using namespace bcos;
+using namespace bcos::event;
+
+namespace
+{
+// the stable FNV-1a hash, the keys are persisted
+uint64_t fnv1a(uint8_t _domain, const uint8_t* _data, std::size_t _size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash ^= _domain;
+    hash *= 0x100000001b3ULL;
+    for (std::size_t i = 0; i < _size; i++)
+    {
+        hash ^= _data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::string segmentPath(std::string const& _dir, size_t _seq)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%08zu.seg", _seq);
+    return _dir + "/" + name;
+}
+
+bool syncDir(std::string const& _dir)
+{
+    auto fd = ::open(_dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    auto ret = ::fsync(fd);
+    ::close(fd);
+    return ret == 0;
+}
+
+// replace the file by a synced temporary file and sync the directory, so the file is either the
+// old one or the new one after a crash
+bool writeFileSynced(std::string const& _dir, std::string const& _name, std::string const& _data)
+{
+    auto path = _dir + "/" + _name;
+    auto tmpPath = path + ".tmp";
+    auto fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    size_t written = 0;
+    bool succ = true;
+    while (written < _data.size())
+    {
+        auto ret = ::write(fd, _data.data() + written, _data.size() - written);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret <= 0)
+        {
+            succ = false;
+            break;
+        }
+        written += ret;
+    }
+    succ = succ && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!succ || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        return false;
+    }
+    return syncDir(_dir);
+}
+
+// append the block of the satisfied log unless appended, return true if the limit is reached
+bool addBlock(std::vector<bcos::protocol::BlockNumber>& _blocks,
+    bcos::protocol::BlockNumber _blockNumber, size_t _limit)
+{
+    if (!_blocks.empty() && _blocks.back() == _blockNumber)
+    {
+        return false;
+    }
+    if (_blocks.size() >= _limit)
+    {
+        return true;
+    }
+    _blocks.push_back(_blockNumber);
+    return false;
+}
+}  // namespace
+
+struct EventLogIndex::BlockFetches
+{
+    // block number => the fetched block, nullptr if failed
+    std::map<bcos::protocol::BlockNumber, bcos::protocol::Block::Ptr> blocks;
+    std::mutex x_blocks;
+    std::condition_variable signal;
+};
+
+LogIndexSegment::~LogIndexSegment()
+{
+    if (m_records)
+    {
+        ::munmap((void*)m_records, m_capacity * sizeof(LogIndexRecord));
+    }
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+}
+
+LogIndexSegment::Ptr LogIndexSegment::open(
+    std::string const& _path, size_t _capacity, int64_t _nextBlock)
+{
+    auto segment = std::shared_ptr<LogIndexSegment>(new LogIndexSegment());
+    segment->m_path = _path;
+    segment->m_fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (segment->m_fd < 0)
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("LogIndexSegment") << LOG_DESC("open segment failed")
+                         << LOG_KV("path", _path) << LOG_KV("errno", errno);
+        return nullptr;
+    }
+    struct stat fileStat;
+    if (::fstat(segment->m_fd, &fileStat) != 0)
+    {
+        return nullptr;
+    }
+    size_t size = fileStat.st_size / sizeof(LogIndexRecord);
+    segment->m_capacity = std::max(_capacity, size);
+    // the range beyond the end of the file is mapped for the records appended later
+    auto addr = ::mmap(nullptr, segment->m_capacity * sizeof(LogIndexRecord), PROT_READ,
+        MAP_SHARED, segment->m_fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("LogIndexSegment") << LOG_DESC("mmap segment failed")
+                         << LOG_KV("path", _path) << LOG_KV("errno", errno);
+        return nullptr;
+    }
+    segment->m_records = (const LogIndexRecord*)addr;
+    // drop the partial record and the records of the blocks written after the last checkpoint
+    while (size > 0 && segment->m_records[size - 1].blockNumber >= _nextBlock)
+    {
+        size--;
+    }
+    if ((off_t)(size * sizeof(LogIndexRecord)) != fileStat.st_size &&
+        ::ftruncate(segment->m_fd, size * sizeof(LogIndexRecord)) != 0)
+    {
+        return nullptr;
+    }
+    segment->m_size.store(size);
+    return segment;
+}
+
+bool LogIndexSegment::append(std::vector<LogIndexRecord> const& _records)
+{
+    auto data = (const char*)_records.data();
+    size_t length = _records.size() * sizeof(LogIndexRecord);
+    size_t written = 0;
+    while (written < length)
+    {
+        auto ret = ::write(m_fd, data + written, length - written);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret <= 0)
+        {
+            EVENT_SUB(ERROR) << LOG_BADGE("LogIndexSegment") << LOG_DESC("append failed")
+                             << LOG_KV("path", m_path) << LOG_KV("errno", errno);
+            // drop the partial records
+            auto ignored = ::ftruncate(m_fd, m_size.load() * sizeof(LogIndexRecord));
+            (void)ignored;
+            return false;
+        }
+        written += ret;
+    }
+    m_size.fetch_add(_records.size());
+    return true;
+}
+
+bool LogIndexSegment::sync()
+{
+    if (::fdatasync(m_fd) != 0)
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("LogIndexSegment") << LOG_DESC("sync failed")
+                         << LOG_KV("path", m_path) << LOG_KV("errno", errno);
+        return false;
+    }
+    return true;
+}
+
+void LogIndexSegment::seal()
+{
+    auto size = m_size.load();
+    auto postings = std::make_shared<std::vector<uint32_t>>(size);
+    std::iota(postings->begin(), postings->end(), 0);
+    // the positions of a key stay in block order
+    auto records = m_records;
+    std::stable_sort(postings->begin(), postings->end(),
+        [records](uint32_t _left, uint32_t _right) {
+            return records[_left].key < records[_right].key;
+        });
+    std::atomic_store(&m_postings, std::shared_ptr<const std::vector<uint32_t>>(postings));
+}
+
+bool LogIndexSegment::queryBlocks(LogIndexKeyBits const& _keyBits, uint32_t _requiredBits,
+    bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock, size_t _limit,
+    std::vector<bcos::protocol::BlockNumber>& _blocks) const
+{
+    auto size = m_size.load();
+    if (size == 0 || m_records[size - 1].blockNumber < _fromBlock ||
+        m_records[0].blockNumber > _toBlock)
+    {
+        return false;
+    }
+    auto postings = std::atomic_load(&m_postings);
+    if (postings)
+    {
+        return lookupPostings(
+            *postings, _keyBits, _requiredBits, _fromBlock, _toBlock, _limit, _blocks);
+    }
+    return scanRecords(size, _keyBits, _requiredBits, _fromBlock, _toBlock, _limit, _blocks);
+}
+
+bool LogIndexSegment::scanRecords(size_t _size, LogIndexKeyBits const& _keyBits,
+    uint32_t _requiredBits, bcos::protocol::BlockNumber _fromBlock,
+    bcos::protocol::BlockNumber _toBlock, size_t _limit,
+    std::vector<bcos::protocol::BlockNumber>& _blocks) const
+{
+    auto records = m_records;
+    auto it = std::lower_bound(records, records + _size, _fromBlock,
+        [](LogIndexRecord const& _record, bcos::protocol::BlockNumber _blockNumber) {
+            return _record.blockNumber < _blockNumber;
+        });
+    // the records of a log are consecutive
+    const LogIndexRecord* logStart = nullptr;
+    uint32_t bits = 0;
+    for (; it != records + _size && it->blockNumber <= _toBlock; it++)
+    {
+        if (!logStart || it->blockNumber != logStart->blockNumber ||
+            it->txIndex != logStart->txIndex || it->logIndex != logStart->logIndex)
+        {
+            logStart = it;
+            bits = 0;
+        }
+        auto keyIt = _keyBits.find(it->key);
+        if (keyIt == _keyBits.end())
+        {
+            continue;
+        }
+        bits |= keyIt->second;
+        if ((bits & _requiredBits) == _requiredBits && addBlock(_blocks, it->blockNumber, _limit))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LogIndexSegment::lookupPostings(std::vector<uint32_t> const& _postings,
+    LogIndexKeyBits const& _keyBits, uint32_t _requiredBits,
+    bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock, size_t _limit,
+    std::vector<bcos::protocol::BlockNumber>& _blocks) const
+{
+    auto records = m_records;
+    // the logs with the keys in the range => the bits satisfied, ordered as the records
+    std::map<std::tuple<bcos::protocol::BlockNumber, uint32_t, uint32_t>, uint32_t> logBits;
+    for (auto const& keyBits : _keyBits)
+    {
+        auto first = std::lower_bound(_postings.begin(), _postings.end(), keyBits.first,
+            [records](uint32_t _position, uint64_t _key) { return records[_position].key < _key; });
+        auto last = std::upper_bound(first, _postings.end(), keyBits.first,
+            [records](uint64_t _key, uint32_t _position) { return _key < records[_position].key; });
+        auto it = std::lower_bound(first, last, _fromBlock,
+            [records](uint32_t _position, bcos::protocol::BlockNumber _blockNumber) {
+                return records[_position].blockNumber < _blockNumber;
+            });
+        for (; it != last && records[*it].blockNumber <= _toBlock; it++)
+        {
+            auto const& record = records[*it];
+            logBits[std::make_tuple(record.blockNumber, record.txIndex, record.logIndex)] |=
+                keyBits.second;
+        }
+    }
+    for (auto const& it : logBits)
+    {
+        if ((it.second & _requiredBits) == _requiredBits &&
+            addBlock(_blocks, std::get<0>(it.first), _limit))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t EventLogIndex::addressKey(std::string_view _address)
+{
+    return fnv1a('a', (const uint8_t*)_address.data(), _address.size());
+}
+
+uint64_t EventLogIndex::topicKey(std::size_t _index, bcos::crypto::HashType const& _topic)
+{
+    return fnv1a((uint8_t)('0' + _index), _topic.data(), _topic.size);
+}
+
+void EventLogIndex::start()
+{
+    if (m_running.load())
+    {
+        return;
+    }
+    m_running.store(true);
+    startWorking();
+    EVENT_SUB(INFO) << LOG_BADGE("EventLogIndex") << LOG_DESC("start the event log index")
+                    << LOG_KV("storagePath", m_storagePath);
+}
+
+void EventLogIndex::stop()
+{
+    if (!m_running.load())
+    {
+        return;
+    }
+    m_running.store(false);
+    wakeUp();
+    // wake up the worker waiting for the blocks
+    std::shared_ptr<BlockFetches> fetches;
+    {
+        Guard l(x_inflightFetches);
+        fetches = m_inflightFetches.lock();
+    }
+    if (fetches)
+    {
+        std::lock_guard<std::mutex> l(fetches->x_blocks);
+        fetches->signal.notify_all();
+    }
+    finishWorker();
+    stopWorking();
+    // will not restart worker, so terminate it
+    terminate();
+    EVENT_SUB(INFO) << LOG_BADGE("EventLogIndex") << LOG_DESC("stop the event log index");
+}
+
+void EventLogIndex::executeWorker()
+{
+    bool busy = false;
+    auto groupIDs = m_groupManager->sortedGroupIDs();
+    for (auto const& group : *groupIDs)
+    {
+        if (!m_running.load())
+        {
+            return;
+        }
+        busy = indexGroup(group) || busy;
+        // the segments are sealed after the blocks indexed, one per group per loop
+        auto index = groupIndex(group);
+        busy = (index && sealSegments(index)) || busy;
+    }
+    if (busy)
+    {
+        return;
+    }
+    // all the groups have been indexed to the highest block
+    std::unique_lock<std::mutex> l(x_signal);
+    m_signal.wait_for(l, std::chrono::milliseconds(m_idleCheckInterval),
+        [this]() { return m_signaled || !m_running.load(); });
+    m_signaled = false;
+}
+
+void EventLogIndex::onBlockNumberUpdated(std::string const&, bcos::protocol::BlockNumber)
+{
+    wakeUp();
+}
+
+void EventLogIndex::wakeUp()
+{
+    {
+        std::lock_guard<std::mutex> l(x_signal);
+        m_signaled = true;
+    }
+    m_signal.notify_one();
+}
+
+bcos::protocol::BlockNumber EventLogIndex::indexedBlockNumber(std::string const& _group)
+{
+    auto index = groupIndex(_group);
+    if (!index)
+    {
+        return -1;
+    }
+    return index->nextBlock.load() - 1;
+}
+
+EventLogIndex::GroupIndex::Ptr EventLogIndex::groupIndex(std::string const& _group)
+{
+    Guard l(x_groupIndexes);
+    auto it = m_groupIndexes.find(_group);
+    if (it == m_groupIndexes.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::string EventLogIndex::dirName(std::string const& _group)
+{
+    // the group names differing only in the special characters never share a directory
+    return bcos::toHex(_group);
+}
+
+EventLogIndex::GroupIndex::Ptr EventLogIndex::openGroupIndex(
+    std::string const& _group, bcos::crypto::HashType const& _genesisHash)
+{
+    auto index = std::make_shared<GroupIndex>();
+    index->dir = m_storagePath + "/" + dirName(_group);
+    ::mkdir(m_storagePath.c_str(), 0755);
+    if (::mkdir(index->dir.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("EventLogIndex") << LOG_DESC("create the index dir failed")
+                         << LOG_KV("group", _group) << LOG_KV("dir", index->dir)
+                         << LOG_KV("errno", errno);
+        return nullptr;
+    }
+
+    std::string persistedGenesisHash;
+    std::ifstream genesis(index->dir + "/genesis");
+    if (genesis)
+    {
+        genesis >> persistedGenesisHash;
+    }
+    auto genesisHash = _genesisHash.hex();
+    if (persistedGenesisHash != genesisHash)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventLogIndex")
+                           << LOG_DESC("the index belongs to another chain, reset it")
+                           << LOG_KV("group", _group) << LOG_KV("dir", index->dir)
+                           << LOG_KV("persistedGenesisHash", persistedGenesisHash)
+                           << LOG_KV("genesisHash", genesisHash);
+        // the checkpoint is removed first and the segments from the last, so the index reset
+        // partially is still empty and reset again when reopened
+        ::unlink((index->dir + "/meta").c_str());
+        size_t segments = 0;
+        struct stat fileStat;
+        while (::stat(segmentPath(index->dir, segments).c_str(), &fileStat) == 0)
+        {
+            segments++;
+        }
+        while (segments > 0)
+        {
+            ::unlink(segmentPath(index->dir, --segments).c_str());
+        }
+        if (!writeFileSynced(index->dir, "genesis", genesisHash))
+        {
+            EVENT_SUB(ERROR) << LOG_BADGE("EventLogIndex")
+                             << LOG_DESC("persist the genesis hash failed")
+                             << LOG_KV("group", _group) << LOG_KV("errno", errno);
+            return nullptr;
+        }
+    }
+
+    int64_t nextBlock = 0;
+    std::ifstream meta(index->dir + "/meta");
+    if (meta)
+    {
+        meta >> nextBlock;
+    }
+    index->nextBlock.store(std::max(nextBlock, (int64_t)0));
+
+    for (size_t seq = 0;; seq++)
+    {
+        auto path = segmentPath(index->dir, seq);
+        struct stat fileStat;
+        if (::stat(path.c_str(), &fileStat) != 0)
+        {
+            break;
+        }
+        auto segment = LogIndexSegment::open(path, c_segmentRecords, index->nextBlock.load());
+        if (!segment)
+        {
+            return nullptr;
+        }
+        index->segments.push_back(segment);
+    }
+    index->syncedSegments = index->segments.empty() ? 0 : index->segments.size() - 1;
+    EVENT_SUB(INFO) << LOG_BADGE("EventLogIndex") << LOG_DESC("open the index of the group")
+                    << LOG_KV("group", _group) << LOG_KV("dir", index->dir)
+                    << LOG_KV("nextBlock", index->nextBlock.load())
+                    << LOG_KV("segments", index->segments.size());
+    return index;
+}
+
+bool EventLogIndex::indexGroup(std::string const& _group)
+{
+    auto highestBlock = m_groupManager->getBlockNumberByGroup(_group);
+    if (highestBlock < 0)
+    {
+        return false;
+    }
+    auto index = groupIndex(_group);
+    if (!index)
+    {
+        {
+            Guard l(x_groupIndexes);
+            // the index failed to open is not retried
+            if (m_groupIndexes.count(_group))
+            {
+                return false;
+            }
+        }
+        // the group whose genesis hash is unknown is retried after the idle check interval
+        bcos::crypto::HashType genesisHash;
+        if (!fetchGenesisHash(_group, genesisHash))
+        {
+            return false;
+        }
+        index = openGroupIndex(_group, genesisHash);
+        Guard l(x_groupIndexes);
+        m_groupIndexes[_group] = index;
+        if (!index)
+        {
+            return false;
+        }
+    }
+    auto fromBlock = index->nextBlock.load();
+    auto toBlock = std::min(highestBlock, fromBlock + m_maxBlocksPerLoop.load() - 1);
+    auto fetchWindow = m_fetchWindow.load();
+    auto fetches = std::make_shared<BlockFetches>();
+    {
+        Guard l(x_inflightFetches);
+        m_inflightFetches = fetches;
+    }
+    auto nextFetch = fromBlock;
+    int64_t indexedBlocks = 0;
+    bool failed = false;
+    for (auto blockNumber = fromBlock; m_running.load() && blockNumber <= toBlock; blockNumber++)
+    {
+        // the blocks are fetched concurrently and indexed in order
+        for (; nextFetch <= toBlock && nextFetch < blockNumber + fetchWindow; nextFetch++)
+        {
+            asyncFetchBlock(_group, nextFetch, fetches);
+        }
+        bcos::protocol::Block::Ptr block;
+        bool fetched = false;
+        {
+            std::unique_lock<std::mutex> l(fetches->x_blocks);
+            // stop wakes up the wait
+            fetches->signal.wait_for(l, std::chrono::milliseconds(m_fetchTimeout), [&]() {
+                return fetches->blocks.count(blockNumber) > 0 || !m_running.load();
+            });
+            auto it = fetches->blocks.find(blockNumber);
+            fetched = (it != fetches->blocks.end());
+            if (fetched)
+            {
+                block = it->second;
+                fetches->blocks.erase(it);
+            }
+        }
+        // the blocks indexed before stopped are still checkpointed
+        if (!m_running.load())
+        {
+            break;
+        }
+        if (!fetched)
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("EventLogIndex") << LOG_DESC("fetch block timeout")
+                               << LOG_KV("group", _group) << LOG_KV("blockNumber", blockNumber);
+        }
+        // the blocks still in flight are dropped
+        if (!block || !indexBlock(index, blockNumber, block))
+        {
+            failed = true;
+            break;
+        }
+        indexedBlocks++;
+    }
+    if (indexedBlocks > 0)
+    {
+        failed = !storeNextBlock(index) || failed;
+        EVENT_SUB(DEBUG) << LOG_BADGE("EventLogIndex") << LOG_DESC("index blocks")
+                         << LOG_KV("group", _group) << LOG_KV("count", indexedBlocks)
+                         << LOG_KV("nextBlock", index->nextBlock.load())
+                         << LOG_KV("highestBlock", highestBlock);
+    }
+    // the failed group is retried after the idle check interval
+    return !failed && index->nextBlock.load() <= highestBlock;
+}
+
+bool EventLogIndex::indexBlock(GroupIndex::Ptr _groupIndex,
+    bcos::protocol::BlockNumber _blockNumber, bcos::protocol::Block::ConstPtr _block)
+{
+    std::vector<LogIndexRecord> records;
+    for (std::size_t txIndex = 0; txIndex < _block->receiptsSize(); txIndex++)
+    {
+        auto receipt = _block->receipt(txIndex);
+        uint32_t logIndex = 0;
+        for (const auto& logEntry : receipt->logEntries())
+        {
+            records.push_back(
+                {addressKey(logEntry.address()), _blockNumber, (uint32_t)txIndex, logIndex});
+            const auto& topics = logEntry.topics();
+            for (std::size_t i = 0; i < topics.size(); i++)
+            {
+                records.push_back(
+                    {topicKey(i, topics[i]), _blockNumber, (uint32_t)txIndex, logIndex});
+            }
+            logIndex++;
+        }
+    }
+    if (!records.empty())
+    {
+        LogIndexSegment::Ptr segment;
+        {
+            Guard l(_groupIndex->x_segments);
+            if (!_groupIndex->segments.empty())
+            {
+                segment = _groupIndex->segments.back();
+            }
+        }
+        // the records of a block are never split into two segments
+        if (!segment || segment->size() + records.size() > segment->capacity())
+        {
+            Guard l(_groupIndex->x_segments);
+            segment = LogIndexSegment::open(
+                segmentPath(_groupIndex->dir, _groupIndex->segments.size()),
+                std::max(c_segmentRecords, records.size()), _blockNumber);
+            if (!segment)
+            {
+                return false;
+            }
+            _groupIndex->segments.push_back(segment);
+        }
+        if (!segment->append(records))
+        {
+            return false;
+        }
+    }
+    _groupIndex->nextBlock.store(_blockNumber + 1);
+    return true;
+}
+
+bool EventLogIndex::sealSegments(GroupIndex::Ptr _groupIndex)
+{
+    LogIndexSegment::Ptr segment;
+    {
+        Guard l(_groupIndex->x_segments);
+        // only the last segment is appended
+        for (size_t i = 0; i + 1 < _groupIndex->segments.size(); i++)
+        {
+            if (!_groupIndex->segments[i]->sealed())
+            {
+                segment = _groupIndex->segments[i];
+                break;
+            }
+        }
+    }
+    if (!segment)
+    {
+        return false;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    segment->seal();
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventLogIndex") << LOG_DESC("seal the segment")
+                     << LOG_KV("dir", _groupIndex->dir) << LOG_KV("records", segment->size())
+                     << LOG_KV("timeCost(ms)",
+                            std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - startTime)
+                                .count());
+    return true;
+}
+
+void EventLogIndex::asyncFetchBlock(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, std::shared_ptr<BlockFetches> _fetches)
+{
+    auto onFetched = [_fetches, _blockNumber](bcos::protocol::Block::Ptr _block) {
+        {
+            std::lock_guard<std::mutex> l(_fetches->x_blocks);
+            _fetches->blocks[_blockNumber] = _block;
+        }
+        _fetches->signal.notify_all();
+    };
+    auto nodeService = m_groupManager->getNodeService(_group, "");
+    if (!nodeService)
+    {
+        onFetched(nullptr);
+        return;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    // only the receipts are indexed
+    nodeService->ledger()->asyncGetBlockDataByNumber(_blockNumber, bcos::ledger::RECEIPTS,
+        [onFetched, nodeService, startTime, _group, _blockNumber](
+            Error::Ptr _error, bcos::protocol::Block::Ptr _block) {
+            // feed the circuit breaker of the node
+            nodeService->onRequestResult(_error,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - startTime)
+                    .count());
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                EVENT_SUB(WARNING) << LOG_BADGE("EventLogIndex") << LOG_DESC("fetch block failed")
+                                   << LOG_KV("group", _group)
+                                   << LOG_KV("blockNumber", _blockNumber)
+                                   << LOG_KV("errorCode", _error->errorCode())
+                                   << LOG_KV("errorMessage", _error->errorMessage());
+                onFetched(nullptr);
+                return;
+            }
+            onFetched(_block);
+        });
+}
+
+bool EventLogIndex::fetchGenesisHash(
+    std::string const& _group, bcos::crypto::HashType& _genesisHash)
+{
+    auto nodeService = m_groupManager->getNodeService(_group, "");
+    if (!nodeService)
+    {
+        return false;
+    }
+    auto promise = std::make_shared<std::promise<std::pair<bool, bcos::crypto::HashType>>>();
+    auto future = promise->get_future();
+    nodeService->ledger()->asyncGetBlockHashByNumber(
+        0, [promise, _group](Error::Ptr _error, bcos::crypto::HashType const& _hash) {
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                EVENT_SUB(WARNING) << LOG_BADGE("EventLogIndex")
+                                   << LOG_DESC("fetch the genesis hash failed")
+                                   << LOG_KV("group", _group)
+                                   << LOG_KV("errorCode", _error->errorCode())
+                                   << LOG_KV("errorMessage", _error->errorMessage());
+                promise->set_value(std::make_pair(false, bcos::crypto::HashType()));
+                return;
+            }
+            promise->set_value(std::make_pair(true, _hash));
+        });
+    if (future.wait_for(std::chrono::milliseconds(m_fetchTimeout)) != std::future_status::ready)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventLogIndex")
+                           << LOG_DESC("fetch the genesis hash timeout") << LOG_KV("group", _group);
+        return false;
+    }
+    auto result = future.get();
+    _genesisHash = result.second;
+    return result.first;
+}
+
+bool EventLogIndex::storeNextBlock(GroupIndex::Ptr _groupIndex)
+{
+    // the segments appended since the last checkpoint, only the worker appends the segments
+    std::vector<LogIndexSegment::Ptr> segments;
+    {
+        Guard l(_groupIndex->x_segments);
+        auto synced = std::min(_groupIndex->syncedSegments, _groupIndex->segments.size());
+        segments.assign(_groupIndex->segments.begin() + synced, _groupIndex->segments.end());
+    }
+    for (auto const& segment : segments)
+    {
+        if (!segment->sync())
+        {
+            return false;
+        }
+    }
+    // the records after the checkpoint are dropped when opened
+    if (!writeFileSynced(
+            _groupIndex->dir, "meta", std::to_string(_groupIndex->nextBlock.load())))
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("EventLogIndex") << LOG_DESC("store the checkpoint failed")
+                         << LOG_KV("dir", _groupIndex->dir) << LOG_KV("errno", errno);
+        return false;
+    }
+    Guard l(_groupIndex->x_segments);
+    // the last segment is appended after the checkpoint
+    _groupIndex->syncedSegments += segments.empty() ? 0 : segments.size() - 1;
+    return true;
+}
+
+bool EventLogIndex::queryBlocks(std::string const& _group, EventSubParams const& _params,
+    bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock, size_t _limit,
+    std::vector<bcos::protocol::BlockNumber>& _blocks, bcos::protocol::BlockNumber& _endBlock)
+{
+    // the bit 0 for the addresses and the bit i + 1 for the topics of index i
+    LogIndexKeyBits keyBits;
+    uint32_t requiredBits = 0;
+    if (!_params.addresses().empty())
+    {
+        requiredBits |= 1;
+        for (auto const& address : _params.addresses())
+        {
+            keyBits[addressKey(address)] |= 1;
+        }
+    }
+    const auto& topics = _params.topics();
+    const auto& topicKeys = _params.topicKeys();
+    for (std::size_t i = 0; i < topics.size(); i++)
+    {
+        if (topics[i].empty())
+        {
+            continue;
+        }
+        requiredBits |= (1 << (i + 1));
+        for (std::size_t j = 0; i < topicKeys.size() && j < topicKeys[i].size(); j++)
+        {
+            keyBits[topicKey(i, topicKeys[i][j])] |= (1 << (i + 1));
+        }
+    }
+    // all the blocks are candidates
+    if (requiredBits == 0)
+    {
+        return false;
+    }
+    auto index = groupIndex(_group);
+    if (!index)
+    {
+        return false;
+    }
+    // the segments contain all the records before nextBlock
+    auto nextBlock = index->nextBlock.load();
+    if (_fromBlock >= nextBlock || _fromBlock > _toBlock)
+    {
+        return false;
+    }
+    std::vector<LogIndexSegment::Ptr> segments;
+    {
+        Guard l(index->x_segments);
+        segments = index->segments;
+    }
+
+    auto toBlock = std::min(_toBlock, nextBlock - 1);
+    auto limit = std::max(_limit, (size_t)1);
+    _blocks.clear();
+    _endBlock = toBlock;
+    for (auto const& segment : segments)
+    {
+        if (segment->queryBlocks(keyBits, requiredBits, _fromBlock, toBlock, limit, _blocks))
+        {
+            // all the logs of the last returned block have been checked
+            _endBlock = _blocks.back();
+            return true;
+        }
+    }
+    return true;
+}
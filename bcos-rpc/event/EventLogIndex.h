@@ -0,0 +1,237 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the persistent index of the log addresses and topics of the blocks
+ * @file EventLogIndex.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Worker.h>
+#include <bcos-rpc/event/EventSubParams.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace event
+{
+// the hash of the address or the topic of an index, the block, the receipt and the log
+struct LogIndexRecord
+{
+    uint64_t key;
+    int64_t blockNumber;
+    uint32_t txIndex;
+    uint32_t logIndex;
+};
+static_assert(sizeof(LogIndexRecord) == 24, "the record is persisted as 24 bytes");
+
+// the key of the params => the bits of the conditions satisfied by the key
+using LogIndexKeyBits = std::unordered_map<uint64_t, uint32_t>;
+
+/**
+ * @brief an append-only file of the records in block order, mapped into memory once and read
+ * without lock, the records appended are visible through the shared mapping; once sealed, the
+ * positions of the records are sorted by the key in memory, so a query looks up the postings of
+ * its keys instead of scanning all the records of the range
+ */
+class LogIndexSegment
+{
+public:
+    using Ptr = std::shared_ptr<LogIndexSegment>;
+    ~LogIndexSegment();
+
+    // open or create the segment, nullptr if failed
+    static Ptr open(std::string const& _path, size_t _capacity, int64_t _nextBlock);
+
+    bool append(std::vector<LogIndexRecord> const& _records);
+    // flush the appended records to the disk
+    bool sync();
+
+    // sort the postings of the keys, the segment must not be appended any more
+    void seal();
+    bool sealed() const { return std::atomic_load(&m_postings) != nullptr; }
+
+    /**
+     * @brief: append the blocks in [_fromBlock, _toBlock] with a log satisfying all the
+     * _requiredBits to _blocks, the block already at the back of _blocks is not appended again
+     * @return true if the limit is reached, all the logs of _blocks.back() have been checked
+     */
+    bool queryBlocks(LogIndexKeyBits const& _keyBits, uint32_t _requiredBits,
+        bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock,
+        size_t _limit, std::vector<bcos::protocol::BlockNumber>& _blocks) const;
+
+    const LogIndexRecord* records() const { return m_records; }
+    size_t size() const { return m_size.load(); }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    LogIndexSegment() = default;
+    bool scanRecords(size_t _size, LogIndexKeyBits const& _keyBits, uint32_t _requiredBits,
+        bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock,
+        size_t _limit, std::vector<bcos::protocol::BlockNumber>& _blocks) const;
+    bool lookupPostings(std::vector<uint32_t> const& _postings, LogIndexKeyBits const& _keyBits,
+        uint32_t _requiredBits, bcos::protocol::BlockNumber _fromBlock,
+        bcos::protocol::BlockNumber _toBlock, size_t _limit,
+        std::vector<bcos::protocol::BlockNumber>& _blocks) const;
+
+private:
+    std::string m_path;
+    int m_fd = -1;
+    const LogIndexRecord* m_records = nullptr;
+    size_t m_capacity = 0;
+    // updated after the records written
+    std::atomic<size_t> m_size = {0};
+    // the positions of the records sorted by the key and then the position, nullptr until sealed,
+    // rebuilt after restart instead of persisted
+    std::shared_ptr<const std::vector<uint32_t>> m_postings;
+};
+
+/**
+ * @brief the logs of the blocks of each group are indexed in <storagePath>/<hex of group>/ by the
+ * background worker, which follows the highest block of the group from block 0 with at most
+ * fetchWindow blocks in flight; a query over the indexed blocks returns the blocks with the
+ * candidate logs from the postings of its keys in the sealed segments, and from a scan of the
+ * records in the range of the last segment, the blocks are still fetched and matched, so the
+ * hash collisions are harmless; the full segments are sealed by the worker one per group per
+ * loop; the index persisted for another chain, whose genesis hash differs, is reset when opened
+ */
+class EventLogIndex : public bcos::Worker, public std::enable_shared_from_this<EventLogIndex>
+{
+public:
+    using Ptr = std::shared_ptr<EventLogIndex>;
+    // 24MB per segment
+    static constexpr size_t c_segmentRecords = 1024 * 1024;
+
+    EventLogIndex(std::string const& _storagePath, bcos::rpc::GroupManager::Ptr _groupManager)
+      : bcos::Worker("t_event_index", 0), m_storagePath(_storagePath), m_groupManager(_groupManager)
+    {}
+    virtual ~EventLogIndex() { stop(); }
+
+    virtual void start();
+    virtual void stop();
+    void executeWorker() override;
+
+    // wake the indexer when the highest block of the group increased
+    virtual void onBlockNumberUpdated(
+        std::string const& _group, bcos::protocol::BlockNumber _blockNumber);
+
+    // the highest indexed block of the group, -1 if none
+    bcos::protocol::BlockNumber indexedBlockNumber(std::string const& _group);
+
+    /**
+     * @brief: get the blocks in [_fromBlock, _toBlock] with the logs that may match the params
+     * @param _limit: at most _limit blocks are returned
+     * @param _blocks: the blocks in ascending order
+     * @param _endBlock: the last block answered, the blocks after it are not scanned if the
+     * limit is reached or not indexed
+     * @return false if the index cannot answer: the params without addresses and topics, the
+     * _fromBlock not indexed or the index of the group unavailable
+     */
+    virtual bool queryBlocks(std::string const& _group, EventSubParams const& _params,
+        bcos::protocol::BlockNumber _fromBlock, bcos::protocol::BlockNumber _toBlock,
+        size_t _limit, std::vector<bcos::protocol::BlockNumber>& _blocks,
+        bcos::protocol::BlockNumber& _endBlock);
+
+    std::string const& storagePath() const { return m_storagePath; }
+    // the max number of the blocks indexed per group per loop
+    int64_t maxBlocksPerLoop() const { return m_maxBlocksPerLoop.load(); }
+    void setMaxBlocksPerLoop(int64_t _maxBlocksPerLoop)
+    {
+        m_maxBlocksPerLoop.store(std::max(_maxBlocksPerLoop, (int64_t)1));
+    }
+    // the max number of the blocks fetched ahead of the block being indexed
+    int64_t fetchWindow() const { return m_fetchWindow.load(); }
+    void setFetchWindow(int64_t _fetchWindow)
+    {
+        m_fetchWindow.store(std::max(_fetchWindow, (int64_t)1));
+    }
+
+    // the directory of the index of the group under the storage path
+    static std::string dirName(std::string const& _group);
+
+    static uint64_t addressKey(std::string_view _address);
+    static uint64_t topicKey(std::size_t _index, bcos::crypto::HashType const& _topic);
+
+private:
+    struct GroupIndex
+    {
+        using Ptr = std::shared_ptr<GroupIndex>;
+        std::string dir;
+        // the segments are only appended, protected by x_segments
+        std::vector<LogIndexSegment::Ptr> segments;
+        mutable Mutex x_segments;
+        // the segments before it have been synced by the last checkpoint
+        size_t syncedSegments = 0;
+        // the next block to index
+        std::atomic<int64_t> nextBlock = {0};
+    };
+    // the blocks fetched ahead of the block being indexed
+    struct BlockFetches;
+
+    // the opened index of the group, nullptr if not opened by the worker yet or failed
+    GroupIndex::Ptr groupIndex(std::string const& _group);
+    GroupIndex::Ptr openGroupIndex(
+        std::string const& _group, bcos::crypto::HashType const& _genesisHash);
+    // index the blocks of the group up to the highest block, return true if more to index
+    bool indexGroup(std::string const& _group);
+    bool indexBlock(GroupIndex::Ptr _groupIndex, bcos::protocol::BlockNumber _blockNumber,
+        bcos::protocol::Block::ConstPtr _block);
+    // seal one of the segments before the last, return true if sealed
+    bool sealSegments(GroupIndex::Ptr _groupIndex);
+    void asyncFetchBlock(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        std::shared_ptr<BlockFetches> _fetches);
+    bool fetchGenesisHash(std::string const& _group, bcos::crypto::HashType& _genesisHash);
+    // sync the segments and then persist the next block, so the checkpoint never claims the
+    // records not on the disk
+    bool storeNextBlock(GroupIndex::Ptr _groupIndex);
+    void wakeUp();
+
+private:
+    std::string m_storagePath;
+    bcos::rpc::GroupManager::Ptr m_groupManager;
+    std::atomic_bool m_running = {false};
+
+    // group => the index, nullptr if the index of the group cannot be opened
+    std::unordered_map<std::string, GroupIndex::Ptr> m_groupIndexes;
+    mutable Mutex x_groupIndexes;
+
+    std::atomic<int64_t> m_maxBlocksPerLoop = {100};
+    std::atomic<int64_t> m_fetchWindow = {16};
+    bool m_signaled = false;
+    std::mutex x_signal;
+    std::condition_variable m_signal;
+    uint64_t m_idleCheckInterval = 1000;
+    // the fetches of the group being indexed, woken up by stop
+    std::weak_ptr<BlockFetches> m_inflightFetches;
+    Mutex x_inflightFetches;
+    // the timeout in ms to fetch a block
+    uint64_t m_fetchTimeout = 10 * 1000;
+};
+}  // namespace event
+}  // namespace bcos
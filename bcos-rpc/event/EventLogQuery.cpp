@@ -0,0 +1,265 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief stateless query of the history event logs
+ * @file EventLogQuery.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventLogQuery.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+
+class EventLogQuery::QueryContext
+{
+public:
+    using Ptr = std::shared_ptr<QueryContext>;
+
+    std::string group;
+    EventSubParams::ConstPtr params;
+    bcos::rpc::NodeService::Ptr nodeService;
+    Callback callback;
+    int64_t fromBlock;
+    int64_t toBlock;
+    uint64_t maxResultCount;
+
+    // the blocks to fetch in ascending order
+    std::vector<int64_t> blocks;
+
+    bcos::Mutex x_context;
+    // the matched logs of each block, merged in block order when all blocks are processed
+    std::vector<Json::Value> blockResults;
+    size_t nextIndex = 0;
+    int64_t finishedBlocks = 0;
+    uint64_t resultCount = 0;
+    bool done = false;
+};
+
+void EventLogQuery::query(const std::string& _group, EventSubParams::ConstPtr _params,
+    uint64_t _maxResultCount, Callback _callback)
+{
+    auto nodeService = m_groupManager->getNodeService(_group, "");
+    if (!nodeService)
+    {
+        Json::Value jResp;
+        _callback(std::make_shared<Error>(EP_STATUS_CODE::GROUP_NOT_EXIST,
+                      "the group does not exist: " + _group),
+            jResp);
+        return;
+    }
+
+    auto blockNumber = m_groupManager->getBlockNumberByGroup(_group);
+    auto fromBlock = _params->fromBlock() < 0 ? blockNumber : _params->fromBlock();
+    auto toBlock = _params->toBlock() < 0 ? blockNumber : std::min(_params->toBlock(), blockNumber);
+    if (fromBlock < 0 || fromBlock > toBlock)
+    {
+        Json::Value jResp(Json::arrayValue);
+        _callback(nullptr, jResp);
+        return;
+    }
+
+    // the candidate blocks of the indexed part of the range, the rest blocks are all fetched
+    std::vector<int64_t> blocks;
+    int64_t indexedBlock = fromBlock - 1;
+    auto maxBlockRange = m_maxBlockRange.load();
+    auto logIndex = m_logIndex;
+    if (logIndex &&
+        !logIndex->queryBlocks(_group, *_params, fromBlock, toBlock,
+            maxBlockRange > 0 ? maxBlockRange : toBlock - fromBlock + 1, blocks, indexedBlock))
+    {
+        blocks.clear();
+        indexedBlock = fromBlock - 1;
+    }
+    if (maxBlockRange > 0 && (int64_t)blocks.size() + toBlock - indexedBlock > maxBlockRange)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventLogQuery") << LOG_DESC("exceed the max block range")
+                           << LOG_KV("group", _group) << LOG_KV("fromBlock", fromBlock)
+                           << LOG_KV("toBlock", toBlock) << LOG_KV("indexedBlock", indexedBlock)
+                           << LOG_KV("maxBlockRange", maxBlockRange);
+        Json::Value jResp;
+        _callback(std::make_shared<Error>(EP_STATUS_CODE::INVALID_REQUEST_RANGE,
+                      "the block range exceeds the limit " + std::to_string(maxBlockRange)),
+            jResp);
+        return;
+    }
+    for (auto blockNumber = indexedBlock + 1; blockNumber <= toBlock; blockNumber++)
+    {
+        blocks.push_back(blockNumber);
+    }
+    if (blocks.empty())
+    {
+        Json::Value jResp(Json::arrayValue);
+        _callback(nullptr, jResp);
+        return;
+    }
+
+    auto context = std::make_shared<QueryContext>();
+    context->group = _group;
+    context->params = _params;
+    context->nodeService = nodeService;
+    context->callback = _callback;
+    context->fromBlock = fromBlock;
+    context->toBlock = toBlock;
+    context->maxResultCount = _maxResultCount;
+    context->blocks = std::move(blocks);
+    context->blockResults.resize(context->blocks.size());
+
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventLogQuery") << LOG_DESC("query")
+                     << LOG_KV("group", _group) << LOG_KV("fromBlock", fromBlock)
+                     << LOG_KV("toBlock", toBlock) << LOG_KV("blocks", context->blocks.size());
+
+    // fetch the blocks in parallel, at most fetchWindow blocks in flight
+    auto window = std::min((size_t)m_fetchWindow.load(), context->blocks.size());
+    for (size_t i = 0; i < window; ++i)
+    {
+        fetchNextBlock(context);
+    }
+}
+
+void EventLogQuery::fetchNextBlock(QueryContext::Ptr _context)
+{
+    auto bloomIndex = m_bloomIndex;
+    auto blockFeed = m_blockFeed;
+    while (true)
+    {
+        size_t index;
+        {
+            Guard l(_context->x_context);
+            if (_context->done || _context->nextIndex >= _context->blocks.size())
+            {
+                return;
+            }
+            index = _context->nextIndex++;
+        }
+        auto blockNumber = _context->blocks[index];
+
+        // the block without the candidate logs is finished without fetching
+        if (bloomIndex && !bloomIndex->mayMatch(_context->group, blockNumber, *_context->params))
+        {
+            Json::Value jBlockResult(Json::arrayValue);
+            if (onBlockProcessed(_context, index, nullptr, jBlockResult))
+            {
+                return;
+            }
+            continue;
+        }
+
+        auto self = std::weak_ptr<EventLogQuery>(shared_from_this());
+        blockFeed->asyncGetBlock(_context->group, blockNumber, _context->nodeService,
+            [self, _context, index](Error::Ptr _error, protocol::Block::ConstPtr _block) {
+                auto logQuery = self.lock();
+                if (!logQuery)
+                {
+                    return;
+                }
+                logQuery->onBlockFetched(_context, index, _error, _block);
+            });
+        return;
+    }
+}
+
+void EventLogQuery::onBlockFetched(QueryContext::Ptr _context, size_t _index,
+    Error::Ptr _error, bcos::protocol::Block::ConstPtr _block)
+{
+    auto blockNumber = _context->blocks[_index];
+    Error::Ptr error;
+    Json::Value jBlockResult(Json::arrayValue);
+    if (!_error && !_block)
+    {
+        _error = std::make_shared<Error>(-1, "the fetched block is empty");
+    }
+    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+    {
+        EVENT_SUB(ERROR) << LOG_BADGE("EventLogQuery") << LOG_DESC("asyncGetBlock")
+                         << LOG_KV("group", _context->group)
+                         << LOG_KV("blockNumber", blockNumber)
+                         << LOG_KV("errorCode", _error->errorCode())
+                         << LOG_KV("errorMessage", _error->errorMessage());
+        error = _error;
+    }
+    else
+    {
+        // the bloom of the block is added by the feed
+        m_matcher->matches(_context->params, _block, jBlockResult);
+    }
+
+    if (!onBlockProcessed(_context, _index, error, jBlockResult))
+    {
+        fetchNextBlock(_context);
+    }
+}
+
+bool EventLogQuery::onBlockProcessed(
+    QueryContext::Ptr _context, size_t _index, Error::Ptr _error, Json::Value& _blockResult)
+{
+    auto error = _error;
+    bool finished = false;
+    {
+        Guard l(_context->x_context);
+        if (_context->done)
+        {
+            return true;
+        }
+        if (!error)
+        {
+            _context->resultCount += _blockResult.size();
+            if (_context->maxResultCount > 0 &&
+                _context->resultCount > _context->maxResultCount)
+            {
+                error = std::make_shared<Error>(EP_STATUS_CODE::INVALID_REQUEST_RANGE,
+                    "the number of logs exceeds the limit " +
+                        std::to_string(_context->maxResultCount) + ", narrow the block range");
+            }
+        }
+        if (!error)
+        {
+            _context->blockResults[_index].swap(_blockResult);
+            _context->finishedBlocks++;
+        }
+        finished = error || (_context->finishedBlocks == (int64_t)_context->blockResults.size());
+        _context->done = finished;
+    }
+
+    if (!finished)
+    {
+        return false;
+    }
+
+    Json::Value jResp(Json::arrayValue);
+    if (!error)
+    {
+        for (auto& jBlockLogs : _context->blockResults)
+        {
+            for (auto& jLog : jBlockLogs)
+            {
+                jResp.append(std::move(jLog));
+            }
+        }
+    }
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventLogQuery") << LOG_DESC("query finished")
+                     << LOG_KV("group", _context->group)
+                     << LOG_KV("fromBlock", _context->fromBlock)
+                     << LOG_KV("toBlock", _context->toBlock) << LOG_KV("count", jResp.size())
+                     << LOG_KV("errorCode", error ? error->errorCode() : 0);
+    _context->callback(error, jResp);
+    return true;
+}
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief stateless query of the history event logs
+ * @file EventLogQuery.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/ledger/LedgerInterface.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <bcos-rpc/event/EventLogBloom.h>
+#include <bcos-rpc/event/EventLogIndex.h>
+#include <bcos-rpc/event/EventSubBlockFeed.h>
+#include <bcos-rpc/event/EventSubParams.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <json/json.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace bcos
+{
+namespace event
+{
+class EventSubMatcher;
+class EventLogQuery : public std::enable_shared_from_this<EventLogQuery>
+{
+public:
+    using Ptr = std::shared_ptr<EventLogQuery>;
+    using Callback = std::function<void(Error::Ptr, Json::Value&)>;
+
+    EventLogQuery(
+        bcos::rpc::GroupManager::Ptr _groupManager, std::shared_ptr<EventSubMatcher> _matcher)
+      : m_groupManager(_groupManager),
+        m_matcher(_matcher),
+        m_blockFeed(std::make_shared<EventSubBlockFeed>())
+    {}
+    virtual ~EventLogQuery() {}
+
+public:
+    /**
+     * @brief: query the logs of the blocks in [fromBlock, toBlock] matched with the params, the
+     * negative fromBlock or toBlock means the highest block of the group
+     * @param _group: the group
+     * @param _params: the query params
+     * @param _callback: called with the matched logs in block order
+     */
+    void query(const std::string& _group, EventSubParams::ConstPtr _params, Callback _callback)
+    {
+        query(_group, _params, m_maxResultCount.load(), _callback);
+    }
+    // _maxResultCount: the max number of logs of the query, 0 means unlimited
+    virtual void query(const std::string& _group, EventSubParams::ConstPtr _params,
+        uint64_t _maxResultCount, Callback _callback);
+
+public:
+    // the max number of blocks of one query, the blocks excluded by the log index are not counted
+    int64_t maxBlockRange() const { return m_maxBlockRange.load(); }
+    void setMaxBlockRange(int64_t _maxBlockRange) { m_maxBlockRange.store(_maxBlockRange); }
+
+    // the max number of logs of one query
+    uint64_t maxResultCount() const { return m_maxResultCount.load(); }
+    void setMaxResultCount(uint64_t _maxResultCount) { m_maxResultCount.store(_maxResultCount); }
+
+    // the max number of blocks fetched concurrently by one query
+    uint64_t fetchWindow() const { return m_fetchWindow.load(); }
+    void setFetchWindow(uint64_t _fetchWindow)
+    {
+        m_fetchWindow.store(std::max(_fetchWindow, (uint64_t)1));
+    }
+
+    // the blocks are fetched through the feed, which is shared with the event sub to fetch a
+    // block once and to feed the circuit breaker of the nodes
+    EventSubBlockFeed::Ptr blockFeed() const { return m_blockFeed; }
+    void setBlockFeed(EventSubBlockFeed::Ptr _blockFeed) { m_blockFeed = _blockFeed; }
+
+    // the blocks whose blooms miss the params are not fetched, nullptr means no bloom filtering
+    EventLogBloomIndex::Ptr bloomIndex() const { return m_bloomIndex; }
+    void setBloomIndex(EventLogBloomIndex::Ptr _bloomIndex) { m_bloomIndex = _bloomIndex; }
+
+    // only the candidate blocks of the indexed range are fetched, nullptr means no log index
+    EventLogIndex::Ptr logIndex() const { return m_logIndex; }
+    void setLogIndex(EventLogIndex::Ptr _logIndex) { m_logIndex = _logIndex; }
+
+private:
+    class QueryContext;
+    void fetchNextBlock(std::shared_ptr<QueryContext> _context);
+    // _index: the index of the block in the blocks of the query
+    void onBlockFetched(std::shared_ptr<QueryContext> _context, size_t _index, Error::Ptr _error,
+        bcos::protocol::Block::ConstPtr _block);
+    // return true if the query has finished
+    bool onBlockProcessed(std::shared_ptr<QueryContext> _context, size_t _index,
+        Error::Ptr _error, Json::Value& _blockResult);
+
+private:
+    bcos::rpc::GroupManager::Ptr m_groupManager;
+    std::shared_ptr<EventSubMatcher> m_matcher;
+    EventSubBlockFeed::Ptr m_blockFeed;
+    EventLogBloomIndex::Ptr m_bloomIndex;
+    EventLogIndex::Ptr m_logIndex;
+
+    std::atomic<int64_t> m_maxBlockRange = {1000};
+    std::atomic<uint64_t> m_maxResultCount = {10000};
+    std::atomic<uint64_t> m_fetchWindow = {8};
+};
+}  // namespace event
+}  // namespace bcos
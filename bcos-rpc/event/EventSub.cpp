@@ -23,17 +23,28 @@
 #include <bcos-framework/libutilities/Log.h>
 #include <bcos-rpc/event/EventSub.h>
 #include <bcos-rpc/event/EventSubMatcher.h>
+#include <bcos-rpc/event/EventSubPipeline.h>
 #include <bcos-rpc/event/EventSubRequest.h>
 #include <bcos-rpc/event/EventSubResponse.h>
 #include <bcos-rpc/event/EventSubTask.h>
 #include <chrono>
 #include <cstddef>
 #include <memory>
-#include <thread>
+#include <set>
 
 using namespace bcos;
 using namespace bcos::event;
 
+namespace
+{
+uint64_t elapsedUs(std::chrono::steady_clock::time_point const& _startTime)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startTime)
+        .count();
+}
+}  // namespace
+
 void EventSub::start()
 {
     if (m_running.load())
@@ -42,6 +53,10 @@ void EventSub::start()
         return;
     }
     m_running.store(true);
+    if (m_logIndex)
+    {
+        m_logIndex->start();
+    }
     startWorking();
 
     EVENT_SUB(INFO) << LOG_BADGE("start") << LOG_DESC("start event sub successfully");
@@ -55,11 +70,16 @@ void EventSub::stop()
         return;
     }
     m_running.store(false);
+    wakeUp();
 
     finishWorker();
     stopWorking();
     // will not restart worker, so terminate it
     terminate();
+    if (m_logIndex)
+    {
+        m_logIndex->stop();
+    }
 
     EVENT_SUB(INFO) << LOG_BADGE("stop") << LOG_DESC("stop event sub successfully");
 }
@@ -90,6 +110,12 @@ void EventSub::onRecvSubscribeEvent(std::shared_ptr<bcos::boostssl::ws::WsMessag
     }
 
     auto state = std::make_shared<EventSubTaskState>();
+    auto cursor = eventSubRequest->cursor();
+    if (cursor)
+    {
+        // resume from the block of the cursor, the logs covered by the cursor are not pushed
+        state->setCurrentBlockNumber(cursor->blockNumber());
+    }
 
     // TODO: check request parameters
     auto task = std::make_shared<EventSubTask>();
@@ -97,6 +123,7 @@ void EventSub::onRecvSubscribeEvent(std::shared_ptr<bcos::boostssl::ws::WsMessag
     task->setId(eventSubRequest->id());
     task->setParams(eventSubRequest->params());
     task->setState(state);
+    task->setCursor(cursor);
 
     auto eventSubWeakPtr = std::weak_ptr<EventSub>(shared_from_this());
     task->setCallback([eventSubWeakPtr, _session](const std::string& _id, bool _complete,
@@ -207,6 +234,12 @@ bool EventSub::sendEvents(std::shared_ptr<bcos::boostssl::ws::WsSession> _sessio
 
     auto jResp = esResp->jResp();
     jResp["result"] = _result;
+    // the client resumes after the last log pushed with the cursor
+    auto cursor = EventSubCursor::fromLog(_result[_result.size() - 1]);
+    if (cursor)
+    {
+        jResp["cursor"] = cursor->encode();
+    }
 
     Json::FastWriter writer;
     std::string strEventInfo = writer.write(jResp);
@@ -228,21 +261,28 @@ void EventSub::subscribeEventSub(EventSubTask::Ptr _task)
 {
     EVENT_SUB(INFO) << LOG_BADGE("subscribeEventSub") << LOG_KV("id", _task->id())
                     << LOG_KV("startBlk", _task->state()->currentBlockNumber());
-    std::unique_lock lock(x_addTasks);
-    m_addTasks.push_back(_task);
-    m_addTaskCount++;
+    {
+        std::unique_lock lock(x_addTasks);
+        m_addTasks.push_back(_task);
+        m_addTaskCount++;
+    }
+    wakeUp();
 }
 
 void EventSub::unsubscribeEventSub(const std::string& _id)
 {
     EVENT_SUB(INFO) << LOG_BADGE("unsubscribeEventSub") << LOG_KV("id", _id);
-    std::unique_lock lock(x_cancelTasks);
-    m_cancelTasks.push_back(_id);
-    m_cancelTaskCount++;
+    {
+        std::unique_lock lock(x_cancelTasks);
+        m_cancelTasks.push_back(_id);
+        m_cancelTaskCount++;
+    }
+    wakeUp();
 }
 
 void EventSub::executeWorker()
 {
+    waitForSignal();
     executeCancelTasks();
     executeAddTasks();
     executeEventSubTasks();
@@ -259,7 +299,10 @@ void EventSub::reportEventSubTasks()
     {
         EVENT_SUB(INFO) << LOG_BADGE("reportEventSubTasks")
                         << LOG_DESC("all event sub tasks subscribed by client")
-                        << LOG_KV("count", m_tasks.size());
+                        << LOG_KV("count", m_tasks.size())
+                        << LOG_KV("waitingTasks", waitingTaskCount())
+                        << LOG_KV("threads", m_executor->threadNum())
+                        << LOG_KV("pendingJobs", m_executor->pendingJobs());
         start = std::chrono::high_resolution_clock::now();
     }
 }
@@ -278,6 +321,8 @@ void EventSub::executeAddTasks()
         if (m_tasks.find(id) == m_tasks.end())
         {
             m_tasks[id] = task;
+            addToGroupIndex(task);
+            readyTask(task);
             EVENT_SUB(INFO) << LOG_BADGE("executeAddTasks") << LOG_KV("id", task->id());
         }
         else
@@ -295,6 +340,32 @@ void EventSub::executeAddTasks()
                     << LOG_KV("count", taskCount);
 }
 
+void EventSub::addToGroupIndex(EventSubTask::Ptr _task)
+{
+    bcos::Guard l(x_groupIndexes);
+    auto& index = m_groupIndexes[_task->group()];
+    if (!index)
+    {
+        index = std::make_shared<EventSubIndex>(m_matcher);
+    }
+    index->addTask(_task);
+}
+
+void EventSub::removeFromGroupIndex(EventSubTask::Ptr _task)
+{
+    bcos::Guard l(x_groupIndexes);
+    auto it = m_groupIndexes.find(_task->group());
+    if (it == m_groupIndexes.end())
+    {
+        return;
+    }
+    it->second->removeTask(_task->id());
+    if (it->second->size() == 0)
+    {
+        m_groupIndexes.erase(it);
+    }
+}
+
 void EventSub::executeCancelTasks()
 {
     if (m_cancelTaskCount.load() == 0)
@@ -303,11 +374,15 @@ void EventSub::executeCancelTasks()
     }
 
     std::unique_lock lock(x_cancelTasks);
+    std::set<std::string> cancelledGroups;
     for (const auto& id : m_cancelTasks)
     {
-        auto r = m_tasks.erase(id);
-        if (r)
+        auto it = m_tasks.find(id);
+        if (it != m_tasks.end())
         {
+            cancelledGroups.insert(it->second->group());
+            removeFromGroupIndex(it->second);
+            m_tasks.erase(it);
             EVENT_SUB(INFO) << LOG_BADGE("executeCancelTasks") << LOG_KV("id", id);
         }
         else
@@ -319,6 +394,16 @@ void EventSub::executeCancelTasks()
     m_cancelTaskCount.store(0);
     m_cancelTasks.clear();
 
+    // release the blocks of the groups without tasks
+    for (auto const& task : m_tasks)
+    {
+        cancelledGroups.erase(task.second->group());
+    }
+    for (auto const& group : cancelledGroups)
+    {
+        m_blockFeed->removeGroup(group);
+    }
+
     auto taskCount = m_tasks.size();
     EVENT_SUB(INFO) << LOG_BADGE("executeCancelTasks") << LOG_DESC("report event subscribe tasks ")
                     << LOG_KV("count", taskCount);
@@ -372,58 +457,39 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task, int64_t _blockNum
         _blockNumber = toBlockNumber;
     }
 
+    // the range of one loop grows with the fetch window of the task
     int64_t blockCanProcess = _blockNumber - currentBlockNumber + 1;
-    int64_t maxBlockProcessPerLoop = m_maxBlockProcessPerLoop;
+    int64_t maxBlockProcessPerLoop = m_maxBlockProcessPerLoop * _task->state()->fetchWindow();
     blockCanProcess =
         (blockCanProcess > maxBlockProcessPerLoop ? maxBlockProcessPerLoop : blockCanProcess);
+    if (blockCanProcess <= 0)
+    {
+        return 0;
+    }
 
-    _task->setWork(true);
-    class RecursiveProcess : public std::enable_shared_from_this<RecursiveProcess>
+    // the indexed range is answered by the log index in one scan, only the blocks with the
+    // candidate logs are fetched
+    std::vector<bcos::protocol::BlockNumber> blocks;
+    bcos::protocol::BlockNumber endBlockNumber = currentBlockNumber + blockCanProcess - 1;
+    if (!m_logIndex ||
+        !m_logIndex->queryBlocks(_task->group(), *_task->params(), currentBlockNumber,
+            _blockNumber, blockCanProcess, blocks, endBlockNumber))
     {
-    public:
-        void process(int64_t _blockNumber)
+        blocks.clear();
+        endBlockNumber = currentBlockNumber + blockCanProcess - 1;
+        for (auto blockNumber = currentBlockNumber; blockNumber <= endBlockNumber; blockNumber++)
         {
-            if (_blockNumber > m_endBlockNumber)
-            {  // all block has been proccessed
-                m_task->setWork(false);
-                return;
-            }
-
-            EVENT_SUB(TRACE) << LOG_BADGE("executeEventSubTask:process")
-                             << LOG_KV("id", m_task->id())
-                             << LOG_KV("fromBlock", m_task->params()->fromBlock())
-                             << LOG_KV("toBlock", m_task->params()->toBlock())
-                             << LOG_KV("blockNumber", _blockNumber);
-
-            auto eventSub = m_eventSub;
-            auto task = m_task;
-            auto p = shared_from_this();
-            eventSub->processNextBlock(
-                _blockNumber, task, [task, _blockNumber, p](Error::Ptr _error) {
-                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-                    {
-                        task->setWork(false);
-                        return;
-                    }
-                    // next block
-                    task->state()->setCurrentBlockNumber(_blockNumber + 1);
-                    p->process(_blockNumber + 1);
-                });
+            blocks.push_back(blockNumber);
         }
+    }
 
-    public:
-        bcos::protocol::BlockNumber m_endBlockNumber;
-        std::shared_ptr<EventSub> m_eventSub;
-        EventSubTask::Ptr m_task;
-    };
-
-    auto p = std::make_shared<RecursiveProcess>();
-    p->m_endBlockNumber = currentBlockNumber + blockCanProcess - 1;
-    p->m_eventSub = shared_from_this();
-    p->m_task = _task;
-    p->process(currentBlockNumber);
+    _task->setWork(true);
+    // the blocks are fetched and matched concurrently and pushed in block order
+    auto pipeline = std::make_shared<EventSubPipeline>(
+        shared_from_this(), _task, std::move(blocks), endBlockNumber);
+    pipeline->start();
 
-    return blockCanProcess;
+    return endBlockNumber - currentBlockNumber + 1;
 }
 
 int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
@@ -461,91 +527,237 @@ int64_t EventSub::executeEventSubTask(EventSubTask::Ptr _task)
         return -1;
     }
 
-    // TODO: optimize getBlockNumberByGroup instead of asyncGetBlockNumber
+    // the highest block of the group is updated by the block notifications
+    auto blockNumber = m_groupManager->getBlockNumberByGroup(group);
+    if (blockNumber >= 0)
+    {
+        if (executeEventSubTask(_task, blockNumber) == 0)
+        {
+            waitForBlock(_task, blockNumber);
+        }
+        return 0;
+    }
+
+    // the highest block of the group is unknown, query the ledger
     auto self = std::weak_ptr<EventSub>(shared_from_this());
     auto ledger = nodeService->ledger();
+    auto startTime = std::chrono::steady_clock::now();
     ledger->asyncGetBlockNumber(
-        [group, self, _task](Error::Ptr _error, protocol::BlockNumber _blockNumber) {
+        [group, self, _task, nodeService, startTime](
+            Error::Ptr _error, protocol::BlockNumber _blockNumber) {
+            // feed the circuit breaker of the node
+            nodeService->onRequestResult(_error, elapsedUs(startTime));
+            auto eventSub = self.lock();
+            if (!eventSub)
+            {
+                return;
+            }
             if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
             {
                 EVENT_SUB(ERROR) << LOG_BADGE("executeEventSubTask")
                                  << LOG_DESC("asyncGetBlockNumber error") << LOG_KV("group", group)
                                  << LOG_KV("errorCode", _error->errorCode())
                                  << LOG_KV("errorMessage", _error->errorMessage());
-
-                // error should be occur
+                eventSub->waitForBlock(_task, _blockNumber);
                 return;
             }
-
-            auto eventSub = self.lock();
-            if (eventSub)
+            if (eventSub->executeEventSubTask(_task, _blockNumber) == 0)
             {
-                eventSub->executeEventSubTask(_task, _blockNumber);
+                eventSub->waitForBlock(_task, _blockNumber);
             }
         });
 
     return 0;
 }
 
-void EventSub::processNextBlock(
-    int64_t _blockNumber, EventSubTask::Ptr _task, std::function<void(Error::Ptr _error)> _callback)
+void EventSub::matchBlock(int64_t _blockNumber, EventSubTask::Ptr _task, MatchCallback _callback)
 {
-    auto self = std::weak_ptr<EventSub>(shared_from_this());
     auto matcher = m_matcher;
 
     std::string group = _task->group();
+    auto index = groupIndex(group);
     auto nodeService = m_groupManager->getNodeService(group, "");
     if (!nodeService)
     {
         // group not exist???
         EVENT_SUB(ERROR)
-            << LOG_BADGE("processNextBlock")
+            << LOG_BADGE("matchBlock")
             << LOG_DESC("cannot get node service of the group maybe the group has been removed")
             << LOG_KV("id", _task->id()) << LOG_KV("group", _task->group());
         unsubscribeEventSub(_task->id());
+        Json::Value jResp(Json::arrayValue);
+        _callback(std::make_shared<Error>(EP_STATUS_CODE::GROUP_NOT_EXIST,
+                      "the group does not exist: " + group),
+            jResp);
         return;
     }
 
-    auto ledger = nodeService->ledger();
-    ledger->asyncGetBlockDataByNumber(_blockNumber,
-        bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
-        [matcher, _task, _blockNumber, _callback, self](
-            Error::Ptr _error, protocol::Block::Ptr _block) {
+    // the block whose bloom misses the addresses or topics of the task has no matched log
+    if (!m_blockFeed->bloomIndex()->mayMatch(group, _blockNumber, *_task->params()))
+    {
+        EVENT_SUB(TRACE) << LOG_BADGE("matchBlock") << LOG_DESC("skipped by the bloom")
+                         << LOG_KV("id", _task->id()) << LOG_KV("blockNumber", _blockNumber);
+        Json::Value jResp(Json::arrayValue);
+        _callback(nullptr, jResp);
+        return;
+    }
+
+    // the block is fetched once and shared by all the tasks of the group
+    auto executor = m_executor;
+    m_blockFeed->asyncGetBlock(group, _blockNumber, nodeService,
+        [matcher, index, executor, group, _task, _blockNumber, _callback](
+            Error::Ptr _error, protocol::Block::ConstPtr _block) {
             if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
             {
                 // Note: wait for next time
-                EVENT_SUB(ERROR) << LOG_BADGE("processNextBlock")
+                EVENT_SUB(ERROR) << LOG_BADGE("matchBlock")
                                  << LOG_DESC("asyncGetBlockDataByNumber")
                                  << LOG_KV("id", _task->id()) << LOG_KV("blockNumber", _blockNumber)
                                  << LOG_KV("errorCode", _error->errorCode())
                                  << LOG_KV("errorMessage", _error->errorMessage());
-                _callback(_error);
+                Json::Value jResp(Json::arrayValue);
+                _callback(_error, jResp);
                 return;
             }
 
-            Json::Value jResp(Json::arrayValue);
-            auto count = matcher->matches(_task->params(), _block, jResp);
-            if (count)
-            {
-                EVENT_SUB(TRACE) << LOG_BADGE("processNextBlock")
-                                 << LOG_DESC("asyncGetBlockDataByNumber")
-                                 << LOG_KV("blockNumber", _blockNumber) << LOG_KV("id", _task->id())
-                                 << LOG_KV("count", count);
+            // matched on the pool instead of the thread delivering the block
+            executor->execute(group, [matcher, index, _task, _blockNumber, _block, _callback]() {
+                Json::Value jResp(Json::arrayValue);
+                // the logs of the block are matched once for all the indexed tasks of the group
+                auto count = index ? index->matches(_task, _blockNumber, _block, jResp) :
+                                     matcher->matches(_task->params(), _block, jResp);
+                if (count)
+                {
+                    EVENT_SUB(TRACE)
+                        << LOG_BADGE("matchBlock") << LOG_DESC("asyncGetBlockDataByNumber")
+                        << LOG_KV("blockNumber", _blockNumber) << LOG_KV("id", _task->id())
+                        << LOG_KV("count", count);
+                }
+                _callback(nullptr, jResp);
+            });
+        });
+}
 
-                _task->callback()(_task->id(), false, jResp);
+void EventSub::executeEventSubTasks()
+{
+    std::deque<EventSubTask::Ptr> readyTasks;
+    {
+        std::lock_guard<std::mutex> l(x_signal);
+        auto now = utcTime();
+        if (now >= m_lastIdleCheckTime + m_idleCheckInterval)
+        {
+            m_lastIdleCheckTime = now;
+            for (auto& waitingTasks : m_waitingTasks)
+            {
+                m_readyTasks.insert(
+                    m_readyTasks.end(), waitingTasks.second.begin(), waitingTasks.second.end());
             }
+            m_waitingTasks.clear();
+        }
+        readyTasks.swap(m_readyTasks);
+    }
 
-            _callback(nullptr);
+    auto self = std::weak_ptr<EventSub>(shared_from_this());
+    for (auto& task : readyTasks)
+    {
+        // the cancelled tasks are dropped here
+        auto it = m_tasks.find(task->id());
+        if (it == m_tasks.end() || it->second != task)
+        {
+            continue;
+        }
+        // the worker only schedules the tasks, which are executed on the pool
+        m_executor->execute(task->group(), [self, task]() {
+            auto eventSub = self.lock();
+            if (eventSub)
+            {
+                eventSub->executeEventSubTask(task);
+            }
         });
+    }
 }
 
-void EventSub::executeEventSubTasks()
+void EventSub::readyTask(EventSubTask::Ptr _task)
 {
-    for (auto& task : m_tasks)
     {
-        executeEventSubTask(task.second);
+        std::lock_guard<std::mutex> l(x_signal);
+        m_readyTasks.push_back(_task);
+        m_signaled = true;
     }
+    m_signal.notify_one();
+}
 
-    // limiting speed
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+void EventSub::waitForBlock(EventSubTask::Ptr _task, bcos::protocol::BlockNumber _blockNumber)
+{
+    {
+        std::lock_guard<std::mutex> l(x_signal);
+        // checked with the lock held, so the block notified after _blockNumber is not missed
+        if (m_groupManager->getBlockNumberByGroup(_task->group()) <= _blockNumber)
+        {
+            m_waitingTasks[_task->group()].push_back(_task);
+            return;
+        }
+        m_readyTasks.push_back(_task);
+        m_signaled = true;
+    }
+    m_signal.notify_one();
+}
+
+size_t EventSub::readyTaskCount() const
+{
+    std::lock_guard<std::mutex> l(x_signal);
+    return m_readyTasks.size();
+}
+
+size_t EventSub::waitingTaskCount() const
+{
+    std::lock_guard<std::mutex> l(x_signal);
+    size_t count = 0;
+    for (auto const& it : m_waitingTasks)
+    {
+        count += it.second.size();
+    }
+    return count;
+}
+
+void EventSub::onBlockNumberUpdated(
+    std::string const& _group, bcos::protocol::BlockNumber _blockNumber)
+{
+    if (m_logIndex)
+    {
+        m_logIndex->onBlockNumberUpdated(_group, _blockNumber);
+    }
+    size_t wokenTasks = 0;
+    {
+        std::lock_guard<std::mutex> l(x_signal);
+        auto it = m_waitingTasks.find(_group);
+        if (it == m_waitingTasks.end())
+        {
+            return;
+        }
+        wokenTasks = it->second.size();
+        m_readyTasks.insert(m_readyTasks.end(), it->second.begin(), it->second.end());
+        m_waitingTasks.erase(it);
+        m_signaled = true;
+    }
+    m_signal.notify_one();
+    EVENT_SUB(TRACE) << LOG_BADGE("onBlockNumberUpdated") << LOG_KV("group", _group)
+                     << LOG_KV("blockNumber", _blockNumber) << LOG_KV("wokenTasks", wokenTasks);
+}
+
+void EventSub::wakeUp()
+{
+    {
+        std::lock_guard<std::mutex> l(x_signal);
+        m_signaled = true;
+    }
+    m_signal.notify_one();
+}
+
+void EventSub::waitForSignal()
+{
+    std::unique_lock<std::mutex> l(x_signal);
+    m_signal.wait_for(l, std::chrono::milliseconds(m_idleCheckInterval),
+        [this]() { return m_signaled || !m_running.load(); });
+    m_signaled = false;
 }
@@ -23,11 +23,18 @@
 #include <bcos-framework/interfaces/ledger/LedgerInterface.h>
 #include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/libutilities/Worker.h>
+#include <bcos-rpc/event/EventLogIndex.h>
+#include <bcos-rpc/event/EventSubBlockFeed.h>
+#include <bcos-rpc/event/EventSubExecutor.h>
+#include <bcos-rpc/event/EventSubIndex.h>
 #include <bcos-rpc/event/EventSubTask.h>
 #include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -49,7 +56,12 @@ class EventSub : bcos::Worker, public std::enable_shared_from_this<EventSub>
 public:
     using Ptr = std::shared_ptr<EventSub>;
     using ConstPtr = std::shared_ptr<const EventSub>;
-    EventSub() : bcos::Worker("t_event_sub") {}
+    // the tasks are scheduled by the worker and executed by _threadNum threads
+    explicit EventSub(size_t _threadNum = 8)
+      : bcos::Worker("t_event_sub", 0),
+        m_blockFeed(std::make_shared<EventSubBlockFeed>()),
+        m_executor(std::make_shared<EventSubExecutor>(_threadNum))
+    {}
     virtual ~EventSub() { stop(); }
 
 public:
@@ -103,14 +115,31 @@ public:
     int64_t executeEventSubTask(EventSubTask::Ptr _task, int64_t _currentBlockNumber);
     void onTaskComplete(bcos::event::EventSubTask::Ptr _task);
     bool checkConnAvailable(bcos::event::EventSubTask::Ptr _task);
-    void processNextBlock(int64_t _blockNumber, bcos::event::EventSubTask::Ptr _task,
-        std::function<void(Error::Ptr _error)> _callback);
+    // fetch the block and match the logs for the task, _callback is called with the matched
+    // logs on the executor, or directly if the block is skipped by the bloom or failed
+    using MatchCallback = std::function<void(Error::Ptr, Json::Value&)>;
+    virtual void matchBlock(int64_t _blockNumber, bcos::event::EventSubTask::Ptr _task,
+        MatchCallback _callback);
+    // the task is executed by the worker as soon as possible
+    void readyTask(bcos::event::EventSubTask::Ptr _task);
+    // the task is executed when the highest block of the group exceeds _blockNumber
+    void waitForBlock(
+        bcos::event::EventSubTask::Ptr _task, bcos::protocol::BlockNumber _blockNumber);
+    void addToGroupIndex(bcos::event::EventSubTask::Ptr _task);
+    void removeFromGroupIndex(bcos::event::EventSubTask::Ptr _task);
+    // the number of the tasks to be executed by the worker and the tasks waiting for new blocks
+    size_t readyTaskCount() const;
+    size_t waitingTaskCount() const;
 
 public:
     std::shared_ptr<EventSubMatcher> matcher() const { return m_matcher; }
     void setMatcher(std::shared_ptr<EventSubMatcher> _matcher) { m_matcher = _matcher; }
 
     void setIoc(std::shared_ptr<boost::asio::io_context> _ioc) { m_ioc = _ioc; }
+    // called when the highest block of the group increased, wakes the tasks waiting for the block
+    virtual void onBlockNumberUpdated(
+        std::string const& _group, bcos::protocol::BlockNumber _blockNumber);
+
     std::shared_ptr<boost::asio::io_context> ioc() const { return m_ioc; }
 
     int64_t maxBlockProcessPerLoop() const { return m_maxBlockProcessPerLoop; }
@@ -119,6 +148,55 @@ public:
         m_maxBlockProcessPerLoop = _maxBlockProcessPerLoop;
     }
 
+    // the fetch window of a catching up task is adapted in [minFetchWindow, maxFetchWindow]:
+    // increased by one for each block fetched within targetFetchLatency(in microseconds), and
+    // halved for each block fetched slower or failed
+    int64_t minFetchWindow() const { return m_minFetchWindow.load(); }
+    void setMinFetchWindow(int64_t _minFetchWindow)
+    {
+        m_minFetchWindow.store(std::max(_minFetchWindow, (int64_t)1));
+    }
+    int64_t maxFetchWindow() const { return m_maxFetchWindow.load(); }
+    void setMaxFetchWindow(int64_t _maxFetchWindow)
+    {
+        m_maxFetchWindow.store(std::max(_maxFetchWindow, (int64_t)1));
+    }
+    uint64_t targetFetchLatency() const { return m_targetFetchLatency.load(); }
+    void setTargetFetchLatency(uint64_t _targetFetchLatency)
+    {
+        m_targetFetchLatency.store(_targetFetchLatency);
+    }
+
+    // the matched logs of the blocks are pushed in one frame before the estimated frame size
+    // crosses maxPushBytes, so a large block is split into frames by log and only a single log
+    // larger than maxPushBytes exceeds it; the frame is also pushed when the task stops catching
+    // up, or when a block is pushed or a range is finished after the oldest log waited
+    // maxPushLatency(in milliseconds), there is no timer, so the logs of a task catching up may
+    // wait longer for a slow block fetch
+    uint64_t maxPushBytes() const { return m_maxPushBytes.load(); }
+    void setMaxPushBytes(uint64_t _maxPushBytes) { m_maxPushBytes.store(_maxPushBytes); }
+    uint64_t maxPushLatency() const { return m_maxPushLatency.load(); }
+    void setMaxPushLatency(uint64_t _maxPushLatency) { m_maxPushLatency.store(_maxPushLatency); }
+
+    // the blocks shared by the tasks of the same group
+    EventSubBlockFeed::Ptr blockFeed() const { return m_blockFeed; }
+    // the pool executing the tasks and matching the blocks, shared fairly by the groups
+    EventSubExecutor::Ptr executor() const { return m_executor; }
+    // the persistent log index answering the historical ranges, nullptr if disabled
+    EventLogIndex::Ptr logIndex() const { return m_logIndex; }
+    void setLogIndex(EventLogIndex::Ptr _logIndex) { m_logIndex = _logIndex; }
+    // the index of the tasks of the group, nullptr if the group has no task
+    EventSubIndex::Ptr groupIndex(std::string const& _group) const
+    {
+        bcos::Guard l(x_groupIndexes);
+        auto it = m_groupIndexes.find(_group);
+        if (it == m_groupIndexes.end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
     bcos::rpc::GroupManager::Ptr groupManager() { return m_groupManager; }
     void setGroupManager(bcos::rpc::GroupManager::Ptr _groupManager)
     {
@@ -134,6 +212,12 @@ public:
         m_messageFactory = _messageFactory;
     }
 
+private:
+    // wake up the worker to execute the ready tasks, the added and the cancelled tasks
+    void wakeUp();
+    // wait at most idleCheckInterval ms for the worker to be woken up
+    void waitForSignal();
+
 private:
     // group manager
     bcos::rpc::GroupManager::Ptr m_groupManager;
@@ -143,6 +227,13 @@ private:
     std::shared_ptr<EventSubMatcher> m_matcher;
     // message factory
     std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> m_messageFactory;
+    // the blocks fetched once for all the tasks of a group
+    EventSubBlockFeed::Ptr m_blockFeed;
+    EventSubExecutor::Ptr m_executor;
+    EventLogIndex::Ptr m_logIndex;
+    // group => the index of the tasks, updated by the worker and read by the block callbacks
+    std::unordered_map<std::string, EventSubIndex::Ptr> m_groupIndexes;
+    mutable bcos::Mutex x_groupIndexes;
 
 private:
     std::atomic<bool> m_running{false};
@@ -164,8 +255,26 @@ private:
     // all subscribe event tasks
     std::unordered_map<std::string, EventSubTask::Ptr> m_tasks;
 
-    //
+    // the blocks processed by a task per loop for each block of its fetch window
     int64_t m_maxBlockProcessPerLoop = 10;
+    std::atomic<int64_t> m_minFetchWindow = {1};
+    std::atomic<int64_t> m_maxFetchWindow = {32};
+    std::atomic<uint64_t> m_targetFetchLatency = {500 * 1000};
+    std::atomic<uint64_t> m_maxPushBytes = {256 * 1024};
+    std::atomic<uint64_t> m_maxPushLatency = {200};
+
+    // the tasks to be executed by the worker: the new tasks, the tasks catching up and the tasks
+    // woken by the new blocks, every task is in m_readyTasks, m_waitingTasks or being executed
+    std::deque<EventSubTask::Ptr> m_readyTasks;
+    // group => the tasks that have processed the highest block of the group
+    std::unordered_map<std::string, std::vector<EventSubTask::Ptr>> m_waitingTasks;
+    bool m_signaled = false;
+    mutable std::mutex x_signal;
+    std::condition_variable m_signal;
+    // all the waiting tasks are rechecked every idleCheckInterval ms, in case of the missed
+    // block notifications and the failed tasks
+    uint64_t m_idleCheckInterval = 1000;
+    uint64_t m_lastIdleCheckTime = 0;
 };
 
 class EventSubFactory : public std::enable_shared_from_this<EventSubFactory>
@@ -174,9 +283,9 @@ public:
     using Ptr = std::shared_ptr<EventSubFactory>;
 
 public:
-    EventSub::Ptr buildEventSub()
+    EventSub::Ptr buildEventSub(size_t _threadNum = 8)
     {
-        auto es = std::make_shared<EventSub>();
+        auto es = std::make_shared<EventSub>(_threadNum);
         return es;
     }
 };
@@ -0,0 +1,230 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the blocks fetched once and shared by all the event sub tasks of a group
+ * @file EventSubBlockFeed.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventSubBlockFeed.h>
+#include <chrono>
+
+using namespace bcos;
+using namespace bcos::event;
+
+void EventSubBlockFeed::asyncGetBlock(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, bcos::rpc::NodeService::Ptr _nodeService,
+    BlockCallback _callback)
+{
+    bcos::protocol::Block::ConstPtr cachedBlock = nullptr;
+    {
+        Guard l(x_groupBlocks);
+        auto& groupBlocks = m_groupBlocks[_group];
+        auto it = groupBlocks.find(_blockNumber);
+        if (it != groupBlocks.end())
+        {
+            auto entry = it->second;
+            entry->lastAccessTime = utcTime();
+            m_hitCount++;
+            if (!entry->block)
+            {
+                // the block is being fetched, wait for the fetch
+                entry->waiters.emplace_back(std::move(_callback));
+                return;
+            }
+            cachedBlock = entry->block;
+        }
+        else
+        {
+            auto entry = std::make_shared<BlockEntry>();
+            entry->lastAccessTime = utcTime();
+            entry->waiters.emplace_back(std::move(_callback));
+            groupBlocks[_blockNumber] = entry;
+            m_fetchCount++;
+        }
+    }
+    if (cachedBlock)
+    {
+        _callback(nullptr, cachedBlock);
+        return;
+    }
+    fetchBlock(_group, _blockNumber, _nodeService);
+}
+
+void EventSubBlockFeed::fetchBlock(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, bcos::rpc::NodeService::Ptr _nodeService)
+{
+    if (m_bloomIndex->genesisHashRequired(_group))
+    {
+        fetchGenesisHash(_group, _nodeService);
+    }
+    auto self = std::weak_ptr<EventSubBlockFeed>(shared_from_this());
+    auto startTime = std::chrono::steady_clock::now();
+    auto ledger = _nodeService->ledger();
+    ledger->asyncGetBlockDataByNumber(_blockNumber,
+        bcos::ledger::RECEIPTS | bcos::ledger::TRANSACTIONS,
+        [self, _group, _blockNumber, _nodeService, startTime](
+            Error::Ptr _error, protocol::Block::Ptr _block) {
+            // feed the circuit breaker of the node
+            _nodeService->onRequestResult(_error,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - startTime)
+                    .count());
+            auto feed = self.lock();
+            if (!feed)
+            {
+                return;
+            }
+            feed->onBlockFetched(_group, _blockNumber, _error, _block);
+        });
+}
+
+void EventSubBlockFeed::fetchGenesisHash(
+    std::string const& _group, bcos::rpc::NodeService::Ptr _nodeService)
+{
+    auto bloomIndex = m_bloomIndex;
+    _nodeService->ledger()->asyncGetBlockHashByNumber(
+        0, [bloomIndex, _group](Error::Ptr _error, crypto::HashType const& _hash) {
+            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+            {
+                EVENT_SUB(WARNING) << LOG_BADGE("EventSubBlockFeed")
+                                   << LOG_DESC("fetch the genesis hash failed")
+                                   << LOG_KV("group", _group)
+                                   << LOG_KV("errorCode", _error->errorCode())
+                                   << LOG_KV("errorMessage", _error->errorMessage());
+                // requested again by the next fetch
+                bloomIndex->resetGenesisHashRequest(_group);
+                return;
+            }
+            bloomIndex->setGenesisHash(_group, _hash);
+        });
+}
+
+void EventSubBlockFeed::onBlockFetched(std::string const& _group,
+    bcos::protocol::BlockNumber _blockNumber, Error::Ptr _error, bcos::protocol::Block::Ptr _block)
+{
+    auto failed = (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS);
+    if (!failed && !_block)
+    {
+        failed = true;
+        _error = std::make_shared<Error>(-1, "the fetched block is empty");
+    }
+    std::vector<BlockCallback> waiters;
+    {
+        Guard l(x_groupBlocks);
+        auto groupIt = m_groupBlocks.find(_group);
+        if (groupIt != m_groupBlocks.end())
+        {
+            auto& groupBlocks = groupIt->second;
+            auto it = groupBlocks.find(_blockNumber);
+            if (it != groupBlocks.end())
+            {
+                waiters.swap(it->second->waiters);
+                if (failed)
+                {
+                    // the failed block is fetched again next time
+                    groupBlocks.erase(it);
+                }
+                else
+                {
+                    it->second->block = _block;
+                    evictWithoutLock(groupBlocks);
+                }
+            }
+        }
+    }
+    if (failed)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubBlockFeed") << LOG_DESC("fetch block failed")
+                           << LOG_KV("group", _group) << LOG_KV("blockNumber", _blockNumber)
+                           << LOG_KV("waiters", waiters.size())
+                           << LOG_KV("errorCode", _error->errorCode())
+                           << LOG_KV("errorMessage", _error->errorMessage());
+        for (auto const& waiter : waiters)
+        {
+            waiter(_error, nullptr);
+        }
+        return;
+    }
+    // the bloom is computed once when the block is fetched
+    m_bloomIndex->addBlock(_group, _blockNumber, _block);
+    if (m_blockHandler)
+    {
+        m_blockHandler(_group, _block);
+    }
+    EVENT_SUB(TRACE) << LOG_BADGE("EventSubBlockFeed") << LOG_DESC("block fetched")
+                     << LOG_KV("group", _group) << LOG_KV("blockNumber", _blockNumber)
+                     << LOG_KV("waiters", waiters.size());
+    for (auto const& waiter : waiters)
+    {
+        waiter(nullptr, _block);
+    }
+}
+
+void EventSubBlockFeed::evictWithoutLock(GroupBlocks& _groupBlocks)
+{
+    auto maxBlocksPerGroup = m_maxBlocksPerGroup.load();
+    while (_groupBlocks.size() > maxBlocksPerGroup)
+    {
+        // evict the least recently used fetched block, the blocks being fetched are kept
+        auto evicted = _groupBlocks.end();
+        for (auto it = _groupBlocks.begin(); it != _groupBlocks.end(); it++)
+        {
+            if (!it->second->block)
+            {
+                continue;
+            }
+            if (evicted == _groupBlocks.end() ||
+                it->second->lastAccessTime < evicted->second->lastAccessTime)
+            {
+                evicted = it;
+            }
+        }
+        if (evicted == _groupBlocks.end())
+        {
+            return;
+        }
+        _groupBlocks.erase(evicted);
+    }
+}
+
+void EventSubBlockFeed::removeGroup(std::string const& _group)
+{
+    Guard l(x_groupBlocks);
+    auto groupIt = m_groupBlocks.find(_group);
+    if (groupIt == m_groupBlocks.end())
+    {
+        return;
+    }
+    auto& groupBlocks = groupIt->second;
+    for (auto it = groupBlocks.begin(); it != groupBlocks.end();)
+    {
+        // the waiters of the blocks being fetched must be called
+        if (it->second->block)
+        {
+            it = groupBlocks.erase(it);
+            continue;
+        }
+        it++;
+    }
+    if (groupBlocks.empty())
+    {
+        m_groupBlocks.erase(groupIt);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the blocks fetched once and shared by all the event sub tasks of a group
+ * @file EventSubBlockFeed.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <bcos-rpc/event/EventLogBloom.h>
+#include <bcos-rpc/jsonrpc/groupmgr/NodeService.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief the recently fetched blocks(with the transactions and receipts) of each group, the
+ * requests for a block being fetched wait for the same fetch, so a block is fetched once for all
+ * the tasks instead of once per task; the least recently used blocks beyond maxBlocksPerGroup are
+ * evicted, the evicted blocks are released after the tasks using them finished
+ */
+class EventSubBlockFeed : public std::enable_shared_from_this<EventSubBlockFeed>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubBlockFeed>;
+    using BlockCallback = std::function<void(Error::Ptr, bcos::protocol::Block::ConstPtr)>;
+    using BlockHandler =
+        std::function<void(std::string const&, bcos::protocol::Block::ConstPtr)>;
+
+    EventSubBlockFeed() : m_bloomIndex(std::make_shared<EventLogBloomIndex>()) {}
+    virtual ~EventSubBlockFeed() {}
+
+    /**
+     * @brief: get the block with the transactions and receipts
+     * @param _group: the group
+     * @param _blockNumber: the block number
+     * @param _nodeService: the node to fetch the block if the block is not cached or being fetched
+     * @param _callback: called with the shared block, the block must not be modified
+     */
+    virtual void asyncGetBlock(std::string const& _group,
+        bcos::protocol::BlockNumber _blockNumber, bcos::rpc::NodeService::Ptr _nodeService,
+        BlockCallback _callback);
+
+    // release the fetched blocks of the group without tasks, the blocks being fetched are kept
+    virtual void removeGroup(std::string const& _group);
+
+public:
+    size_t maxBlocksPerGroup() const { return m_maxBlocksPerGroup.load(); }
+    void setMaxBlocksPerGroup(size_t _maxBlocksPerGroup)
+    {
+        m_maxBlocksPerGroup.store(std::max(_maxBlocksPerGroup, (size_t)1));
+    }
+
+    // called once for each fetched block, set before the feed is used
+    void setBlockHandler(BlockHandler _blockHandler) { m_blockHandler = std::move(_blockHandler); }
+
+    // the blooms of the fetched blocks, shared with the log queries
+    EventLogBloomIndex::Ptr bloomIndex() const { return m_bloomIndex; }
+
+    // the statistics of the feed
+    uint64_t fetchCount() const { return m_fetchCount.load(); }
+    uint64_t hitCount() const { return m_hitCount.load(); }
+
+protected:
+    // fetch the block from the node, answered by onBlockFetched
+    virtual void fetchBlock(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        bcos::rpc::NodeService::Ptr _nodeService);
+    void onBlockFetched(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        Error::Ptr _error, bcos::protocol::Block::Ptr _block);
+
+private:
+    struct BlockEntry
+    {
+        using Ptr = std::shared_ptr<BlockEntry>;
+        bcos::protocol::Block::ConstPtr block;
+        // the callbacks waiting for the block being fetched
+        std::vector<BlockCallback> waiters;
+        uint64_t lastAccessTime = 0;
+    };
+    // blockNumber => the fetched block or the block being fetched
+    using GroupBlocks = std::map<bcos::protocol::BlockNumber, BlockEntry::Ptr>;
+
+    void evictWithoutLock(GroupBlocks& _groupBlocks);
+    // the persisted blooms of the group are identified by its genesis hash
+    void fetchGenesisHash(std::string const& _group, bcos::rpc::NodeService::Ptr _nodeService);
+
+private:
+    std::unordered_map<std::string, GroupBlocks> m_groupBlocks;
+    mutable Mutex x_groupBlocks;
+    EventLogBloomIndex::Ptr m_bloomIndex;
+    BlockHandler m_blockHandler;
+
+    std::atomic<size_t> m_maxBlocksPerGroup = {64};
+    std::atomic<uint64_t> m_fetchCount = {0};
+    std::atomic<uint64_t> m_hitCount = {0};
+};
+}  // namespace event
+}  // namespace bcos
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the position of the last log pushed to the client, to resume the event sub
+ * @file EventSubCursor.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <json/json.h>
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief the cursor is pushed to the client as an opaque string with the logs, the client
+ * subscribes with it again to receive the logs after it exactly once
+ */
+class EventSubCursor
+{
+public:
+    using Ptr = std::shared_ptr<EventSubCursor>;
+    using ConstPtr = std::shared_ptr<const EventSubCursor>;
+
+    EventSubCursor() = default;
+    EventSubCursor(
+        bcos::protocol::BlockNumber _blockNumber, uint32_t _txIndex, uint32_t _logIndex)
+      : m_blockNumber(_blockNumber), m_txIndex(_txIndex), m_logIndex(_logIndex)
+    {}
+
+    bcos::protocol::BlockNumber blockNumber() const { return m_blockNumber; }
+    uint32_t txIndex() const { return m_txIndex; }
+    uint32_t logIndex() const { return m_logIndex; }
+
+    // the log at the position has been pushed
+    bool covers(
+        bcos::protocol::BlockNumber _blockNumber, uint64_t _txIndex, uint64_t _logIndex) const
+    {
+        if (_blockNumber != m_blockNumber)
+        {
+            return _blockNumber < m_blockNumber;
+        }
+        if (_txIndex != m_txIndex)
+        {
+            return _txIndex < m_txIndex;
+        }
+        return _logIndex <= m_logIndex;
+    }
+
+    // remove the pushed logs from the logs of a block
+    void removeCovered(Json::Value& _logs) const
+    {
+        Json::Value logs(Json::arrayValue);
+        for (auto& jLog : _logs)
+        {
+            if (!covers(jLog["blockNumber"].asInt64(), jLog["transactionIndex"].asUInt64(),
+                    jLog["logIndex"].asUInt64()))
+            {
+                logs.append(std::move(jLog));
+            }
+        }
+        _logs.swap(logs);
+    }
+
+    // version 1: "01" + blockNumber(16 hex) + txIndex(8 hex) + logIndex(8 hex)
+    std::string encode() const
+    {
+        char buffer[40];
+        snprintf(buffer, sizeof(buffer), "01%016" PRIx64 "%08" PRIx32 "%08" PRIx32,
+            (uint64_t)m_blockNumber, m_txIndex, m_logIndex);
+        return std::string(buffer);
+    }
+
+    static Ptr decode(std::string const& _cursor)
+    {
+        if (_cursor.size() != 34 || _cursor.compare(0, 2, "01") != 0 ||
+            !std::all_of(_cursor.begin(), _cursor.end(), [](char _c) { return ::isxdigit(_c); }))
+        {
+            return nullptr;
+        }
+        auto blockNumber = (int64_t)std::stoull(_cursor.substr(2, 16), nullptr, 16);
+        if (blockNumber < 0)
+        {
+            return nullptr;
+        }
+        return std::make_shared<EventSubCursor>(blockNumber,
+            (uint32_t)std::stoul(_cursor.substr(18, 8), nullptr, 16),
+            (uint32_t)std::stoul(_cursor.substr(26, 8), nullptr, 16));
+    }
+
+    // the cursor of a log returned by the matcher
+    static Ptr fromLog(Json::Value const& _log)
+    {
+        if (!_log.isObject() || !_log.isMember("blockNumber") ||
+            !_log.isMember("transactionIndex") || !_log.isMember("logIndex"))
+        {
+            return nullptr;
+        }
+        return std::make_shared<EventSubCursor>(_log["blockNumber"].asInt64(),
+            _log["transactionIndex"].asUInt(), _log["logIndex"].asUInt());
+    }
+
+private:
+    bcos::protocol::BlockNumber m_blockNumber = -1;
+    uint32_t m_txIndex = 0;
+    uint32_t m_logIndex = 0;
+};
+}  // namespace event
+}  // namespace bcos
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief execute the event sub jobs of all the groups on a thread pool fairly
+ * @file EventSubExecutor.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventSubExecutor.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+
+void EventSubExecutor::execute(std::string const& _key, Job _job)
+{
+    {
+        Guard l(x_jobs);
+        auto& jobs = m_jobs[_key];
+        if (jobs.empty())
+        {
+            m_keys.push_back(_key);
+        }
+        jobs.emplace_back(std::move(_job));
+        m_pendingJobs++;
+    }
+    // one pool task for each job, the pool task runs the job of the next key instead of this job
+    auto self = std::weak_ptr<EventSubExecutor>(shared_from_this());
+    m_pool->enqueue([self]() {
+        auto executor = self.lock();
+        if (!executor)
+        {
+            return;
+        }
+        executor->executeNextJob();
+    });
+}
+
+void EventSubExecutor::executeNextJob()
+{
+    Job job;
+    std::string key;
+    {
+        Guard l(x_jobs);
+        if (m_keys.empty())
+        {
+            return;
+        }
+        key = std::move(m_keys.front());
+        m_keys.pop_front();
+        auto it = m_jobs.find(key);
+        if (it == m_jobs.end())
+        {
+            return;
+        }
+        job = std::move(it->second.front());
+        it->second.pop_front();
+        if (it->second.empty())
+        {
+            m_jobs.erase(it);
+        }
+        else
+        {
+            // the other keys are taken before the next job of this key
+            m_keys.push_back(key);
+        }
+        m_pendingJobs--;
+    }
+    try
+    {
+        job();
+    }
+    catch (std::exception const& e)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubExecutor") << LOG_DESC("job exception")
+                           << LOG_KV("key", key)
+                           << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief execute the event sub jobs of all the groups on a thread pool fairly
+ * @file EventSubExecutor.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief the jobs are queued by the key(the group), the idle threads of the pool take the jobs of
+ * the keys in round robin, so the jobs of a busy group run on all the idle threads while the jobs
+ * of the other groups are never queued behind the whole backlog of the busy group; the jobs of
+ * the same key may run concurrently, the caller keeps the order of the jobs of one task
+ */
+class EventSubExecutor : public std::enable_shared_from_this<EventSubExecutor>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubExecutor>;
+    using Job = std::function<void()>;
+
+    explicit EventSubExecutor(size_t _threadNum)
+      : m_threadNum(std::max(_threadNum, (size_t)1)),
+        m_pool(std::make_shared<ThreadPool>("t_event_exec", m_threadNum))
+    {}
+    virtual ~EventSubExecutor() {}
+
+    virtual void execute(std::string const& _key, Job _job);
+
+    size_t threadNum() const { return m_threadNum; }
+    // the jobs queued and not started
+    uint64_t pendingJobs() const { return m_pendingJobs.load(); }
+
+private:
+    // run one job of the next key
+    void executeNextJob();
+
+private:
+    size_t m_threadNum;
+    std::shared_ptr<ThreadPool> m_pool;
+
+    // key => the queued jobs of the key
+    std::unordered_map<std::string, std::deque<Job>> m_jobs;
+    // the keys with queued jobs in round robin order
+    std::deque<std::string> m_keys;
+    mutable Mutex x_jobs;
+    std::atomic<uint64_t> m_pendingJobs = {0};
+};
+}  // namespace event
+}  // namespace bcos
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the index from the address and topic0 to the event sub tasks of a group
+ * @file EventSubIndex.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/EventSubIndex.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+
+using namespace bcos;
+using namespace bcos::event;
+
+void EventSubIndex::addTask(EventSubTask::Ptr _task)
+{
+    Guard l(x_taskIndex);
+    if (!m_taskIDs.insert(_task->id()).second)
+    {
+        return;
+    }
+    m_pendingUpdates.emplace_back(_task->id(), _task->params());
+    m_hasPendingUpdates.store(true);
+}
+
+void EventSubIndex::removeTask(std::string const& _id)
+{
+    Guard l(x_taskIndex);
+    if (!m_taskIDs.erase(_id))
+    {
+        return;
+    }
+    m_pendingUpdates.emplace_back(_id, nullptr);
+    m_hasPendingUpdates.store(true);
+}
+
+EventSubIndex::TaskIndex::ConstPtr EventSubIndex::taskIndex()
+{
+    if (!m_hasPendingUpdates.load())
+    {
+        return std::atomic_load(&m_taskIndex);
+    }
+    Guard l(x_taskIndex);
+    if (m_pendingUpdates.empty())
+    {
+        return m_taskIndex;
+    }
+    // the blocks being matched keep the old index
+    auto updatedIndex = std::make_shared<TaskIndex>(*m_taskIndex);
+    for (auto const& update : m_pendingUpdates)
+    {
+        if (update.second)
+        {
+            indexTask(*updatedIndex, update.first, update.second);
+            continue;
+        }
+        unindexTask(*updatedIndex, update.first);
+    }
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventSubIndex") << LOG_DESC("apply the queued updates")
+                     << LOG_KV("updates", m_pendingUpdates.size())
+                     << LOG_KV("tasks", updatedIndex->taskParams.size());
+    m_pendingUpdates.clear();
+    m_hasPendingUpdates.store(false);
+    std::atomic_store(&m_taskIndex, TaskIndex::ConstPtr(std::move(updatedIndex)));
+    return m_taskIndex;
+}
+
+void EventSubIndex::indexTask(
+    TaskIndex& _taskIndex, std::string const& _id, EventSubParams::ConstPtr _params)
+{
+    _taskIndex.taskParams[_id] = _params;
+    if (!_params->addresses().empty())
+    {
+        for (auto const& address : _params->addresses())
+        {
+            _taskIndex.addressIndex[address].insert(_id);
+        }
+    }
+    else if (!_params->topics().empty() && !_params->topics()[0].empty())
+    {
+        // the task with only the invalid topic0 matches nothing and is not indexed
+        for (auto const& topic : _params->topicKeys()[0])
+        {
+            _taskIndex.topicIndex[topic].insert(_id);
+        }
+    }
+    else
+    {
+        _taskIndex.wildcardTasks.insert(_id);
+    }
+}
+
+void EventSubIndex::unindexTask(TaskIndex& _taskIndex, std::string const& _id)
+{
+    auto it = _taskIndex.taskParams.find(_id);
+    if (it == _taskIndex.taskParams.end())
+    {
+        return;
+    }
+    auto params = it->second;
+    _taskIndex.taskParams.erase(it);
+    removeFromIndex(_taskIndex.addressIndex, params->addresses(), _id);
+    if (!params->topicKeys().empty())
+    {
+        removeFromIndex(_taskIndex.topicIndex, params->topicKeys()[0], _id);
+    }
+    _taskIndex.wildcardTasks.erase(_id);
+}
+
+uint32_t EventSubIndex::matches(EventSubTask::Ptr _task, bcos::protocol::BlockNumber _blockNumber,
+    bcos::protocol::Block::ConstPtr _block, Json::Value& _result)
+{
+    BlockMatches::Ptr blockMatches;
+    {
+        Guard l(x_blockMatches);
+        auto it = m_blockMatches.find(_blockNumber);
+        // the history blocks lower than the cached blocks are matched by the task itself
+        auto cacheable = (m_blockMatches.size() < m_maxCachedBlocks.load() ||
+                          _blockNumber > m_blockMatches.begin()->first);
+        if (it == m_blockMatches.end() && cacheable)
+        {
+            it = m_blockMatches.emplace(_blockNumber, std::make_shared<BlockMatches>()).first;
+            while (m_blockMatches.size() > m_maxCachedBlocks.load())
+            {
+                m_blockMatches.erase(m_blockMatches.begin());
+            }
+        }
+        if (it != m_blockMatches.end())
+        {
+            blockMatches = it->second;
+        }
+    }
+    if (blockMatches)
+    {
+        // the first task reaching the block matches the block for all the indexed tasks without
+        // blocking the subscribes, the unsubscribes and the tasks of the other blocks
+        std::call_once(blockMatches->matched, [this, &_block, &blockMatches]() {
+            matchBlock(taskIndex(), *m_matcher, _block, *blockMatches);
+        });
+        if (blockMatches->taskIndex->taskParams.count(_task->id()))
+        {
+            auto resultIt = blockMatches->results.find(_task->id());
+            if (resultIt == blockMatches->results.end())
+            {
+                return 0;
+            }
+            for (auto index : resultIt->second)
+            {
+                _result.append(blockMatches->logs[index]);
+            }
+            return resultIt->second.size();
+        }
+    }
+    // the task added after the block matched, or the matches of the block evicted
+    return m_matcher->matches(_task->params(), _block, _result);
+}
+
+void EventSubIndex::matchBlock(TaskIndex::ConstPtr _taskIndex, EventSubMatcher& _matcher,
+    bcos::protocol::Block::ConstPtr _block, BlockMatches& _blockMatches)
+{
+    _blockMatches.taskIndex = _taskIndex;
+    auto const& taskIndex = *_taskIndex;
+    for (std::size_t txIndex = 0; txIndex < _block->transactionsSize(); txIndex++)
+    {
+        auto receipt = _block->receipt(txIndex);
+        auto tx = _block->transaction(txIndex);
+        std::size_t logIndex = 0;
+        for (auto const& logEntry : receipt->logEntries())
+        {
+            // the position of the log in _blockMatches.logs, -1 until the log is matched
+            int64_t logPosition = -1;
+            auto addressIt = taskIndex.addressIndex.find(std::string_view(logEntry.address()));
+            if (addressIt != taskIndex.addressIndex.end())
+            {
+                matchLog(taskIndex, _matcher, addressIt->second, receipt, tx, txIndex, logEntry,
+                    logIndex, logPosition, _blockMatches);
+            }
+            auto const& topics = logEntry.topics();
+            if (!topics.empty())
+            {
+                auto topicIt = taskIndex.topicIndex.find(topics[0]);
+                if (topicIt != taskIndex.topicIndex.end())
+                {
+                    matchLog(taskIndex, _matcher, topicIt->second, receipt, tx, txIndex, logEntry,
+                        logIndex, logPosition, _blockMatches);
+                }
+            }
+            matchLog(taskIndex, _matcher, taskIndex.wildcardTasks, receipt, tx, txIndex, logEntry,
+                logIndex, logPosition, _blockMatches);
+            logIndex++;
+        }
+    }
+}
+
+void EventSubIndex::matchLog(TaskIndex const& _taskIndex, EventSubMatcher& _matcher,
+    std::set<std::string> const& _candidates,
+    bcos::protocol::TransactionReceipt::ConstPtr _receipt,
+    bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex,
+    const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex, int64_t& _logPosition,
+    BlockMatches& _blockMatches)
+{
+    for (auto const& id : _candidates)
+    {
+        auto paramsIt = _taskIndex.taskParams.find(id);
+        if (paramsIt == _taskIndex.taskParams.end() ||
+            !_matcher.matches(paramsIt->second, _logEntry))
+        {
+            continue;
+        }
+        // the json of the log is built once for all the matched tasks
+        if (_logPosition < 0)
+        {
+            _logPosition = _blockMatches.logs.size();
+            _blockMatches.logs.emplace_back(
+                EventSubMatcher::logToJson(_receipt, _tx, _txIndex, _logEntry, _logIndex));
+        }
+        _blockMatches.results[id].emplace_back((uint32_t)_logPosition);
+    }
+}
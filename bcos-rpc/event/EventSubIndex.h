@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the index from the address and topic0 to the event sub tasks of a group
+ * @file EventSubIndex.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-rpc/event/EventSubTask.h>
+#include <json/json.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace bcos
+{
+namespace event
+{
+class EventSubMatcher;
+/**
+ * @brief each task of a group is indexed by its addresses, or by its topic0 if without
+ * addresses, or as a wildcard task if without both; the logs of a block are scanned once and only
+ * tested against the candidate tasks, the matched logs of all the indexed tasks are kept for the
+ * recent blocks, so the cost of a block is O(logs + matches) instead of O(tasks * logs)
+ *
+ * the added and removed tasks are queued and applied to a copy of the index when the next block
+ * is matched, so all the subscribes and unsubscribes of a worker loop cost one copy of the index
+ * instead of one copy each; the block is scanned with the snapshot of the index outside any lock,
+ * and the json of each matched log is built once and shared by the matched tasks
+ */
+class EventSubIndex
+{
+public:
+    using Ptr = std::shared_ptr<EventSubIndex>;
+    explicit EventSubIndex(std::shared_ptr<EventSubMatcher> _matcher)
+      : m_matcher(_matcher), m_taskIndex(std::make_shared<TaskIndex>())
+    {}
+    virtual ~EventSubIndex() {}
+
+    virtual void addTask(EventSubTask::Ptr _task);
+    virtual void removeTask(std::string const& _id);
+    // the number of the tasks including the queued ones
+    size_t size() const
+    {
+        Guard l(x_taskIndex);
+        return m_taskIDs.size();
+    }
+
+    /**
+     * @brief: the logs of the block matched with the task
+     * @param _task: the task
+     * @param _blockNumber: the number of the block
+     * @param _block: the block with the transactions and receipts
+     * @param _result: the matched logs are appended
+     * @return uint32_t: the number of the matched logs
+     */
+    virtual uint32_t matches(EventSubTask::Ptr _task, bcos::protocol::BlockNumber _blockNumber,
+        bcos::protocol::Block::ConstPtr _block, Json::Value& _result);
+
+    // the max number of the blocks whose matched logs are kept
+    size_t maxCachedBlocks() const { return m_maxCachedBlocks.load(); }
+    void setMaxCachedBlocks(size_t _maxCachedBlocks)
+    {
+        m_maxCachedBlocks.store(std::max(_maxCachedBlocks, (size_t)1));
+    }
+
+private:
+    // the immutable snapshot of the index, replaced as a whole when a task is added or removed
+    struct TaskIndex
+    {
+        using ConstPtr = std::shared_ptr<const TaskIndex>;
+        // taskID => the params of the task
+        std::unordered_map<std::string, EventSubParams::ConstPtr> taskParams;
+        // address => the tasks with the address, looked up by the address of the log without copy
+        std::map<std::string, std::set<std::string>, std::less<>> addressIndex;
+        // topic0 => the tasks without addresses but with the topic0
+        std::unordered_map<bcos::crypto::HashType, std::set<std::string>> topicIndex;
+        // the tasks without addresses and topic0
+        std::set<std::string> wildcardTasks;
+    };
+    struct BlockMatches
+    {
+        using Ptr = std::shared_ptr<BlockMatches>;
+        // the block is matched once by the first task reaching it, the others wait for it
+        std::once_flag matched;
+        // the index that the block is matched with
+        TaskIndex::ConstPtr taskIndex;
+        // the json of the matched logs, shared by the matched tasks
+        std::vector<Json::Value> logs;
+        // taskID => the indexes of the matched logs, the tasks without matched logs are omitted
+        std::unordered_map<std::string, std::vector<uint32_t>> results;
+    };
+    // the snapshot of the index with the queued updates applied
+    TaskIndex::ConstPtr taskIndex();
+    static void indexTask(
+        TaskIndex& _taskIndex, std::string const& _id, EventSubParams::ConstPtr _params);
+    static void unindexTask(TaskIndex& _taskIndex, std::string const& _id);
+    static void matchBlock(TaskIndex::ConstPtr _taskIndex, EventSubMatcher& _matcher,
+        bcos::protocol::Block::ConstPtr _block, BlockMatches& _blockMatches);
+    static void matchLog(TaskIndex const& _taskIndex, EventSubMatcher& _matcher,
+        std::set<std::string> const& _candidates,
+        bcos::protocol::TransactionReceipt::ConstPtr _receipt,
+        bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex,
+        const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex, int64_t& _logPosition,
+        BlockMatches& _blockMatches);
+    template <typename Index, typename Keys>
+    static void removeFromIndex(Index& _index, Keys const& _keys, std::string const& _id)
+    {
+        for (auto const& key : _keys)
+        {
+            auto it = _index.find(key);
+            if (it == _index.end())
+            {
+                continue;
+            }
+            it->second.erase(_id);
+            if (it->second.empty())
+            {
+                _index.erase(it);
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<EventSubMatcher> m_matcher;
+
+    // read without lock, replaced by the thread holding x_taskIndex
+    std::shared_ptr<const TaskIndex> m_taskIndex;
+    // the tasks added or removed since the snapshot in order, the removed task has no params
+    std::vector<std::pair<std::string, EventSubParams::ConstPtr>> m_pendingUpdates;
+    std::atomic_bool m_hasPendingUpdates = {false};
+    // the ids of the tasks including the queued ones
+    std::unordered_set<std::string> m_taskIDs;
+    mutable Mutex x_taskIndex;
+
+    // blockNumber => the matched logs of the indexed tasks
+    std::map<bcos::protocol::BlockNumber, BlockMatches::Ptr> m_blockMatches;
+    std::atomic<size_t> m_maxCachedBlocks = {16};
+    // only guards m_blockMatches, the blocks are matched outside the lock
+    Mutex x_blockMatches;
+};
+}  // namespace event
+}  // namespace bcos
@@ -50,20 +50,7 @@ uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
         if (matches(_params, logEntry))
         {
             count++;
-
-            Json::Value jResp;
-            jResp["blockNumber"] = _receipt->blockNumber();
-            jResp["address"] = std::string(logEntry.address());
-            jResp["data"] = toHexStringWithPrefix(logEntry.data());
-            jResp["logIndex"] = (uint64_t)logIndex;
-            jResp["transactionHash"] = _tx->hash().hexPrefixed();
-            jResp["transactionIndex"] = (uint64_t)_txIndex;
-            jResp["topics"] = Json::Value(Json::arrayValue);
-            for (const auto& topic : logEntry.topics())
-            {
-                jResp["topics"].append(topic.hexPrefixed());
-            }
-            _result.append(jResp);
+            _result.append(logToJson(_receipt, _tx, _txIndex, logEntry, logIndex));
         }
 
         logIndex += 1;
@@ -72,6 +59,25 @@ uint32_t EventSubMatcher::matches(EventSubParams::ConstPtr _params,
     return count;
 }
 
+Json::Value EventSubMatcher::logToJson(bcos::protocol::TransactionReceipt::ConstPtr _receipt,
+    bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex,
+    const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex)
+{
+    Json::Value jResp;
+    jResp["blockNumber"] = _receipt->blockNumber();
+    jResp["address"] = std::string(_logEntry.address());
+    jResp["data"] = toHexStringWithPrefix(_logEntry.data());
+    jResp["logIndex"] = (uint64_t)_logIndex;
+    jResp["transactionHash"] = _tx->hash().hexPrefixed();
+    jResp["transactionIndex"] = (uint64_t)_txIndex;
+    jResp["topics"] = Json::Value(Json::arrayValue);
+    for (const auto& topic : _logEntry.topics())
+    {
+        jResp["topics"].append(topic.hexPrefixed());
+    }
+    return jResp;
+}
+
 bool EventSubMatcher::matches(
     EventSubParams::ConstPtr _params, const bcos::protocol::LogEntry& _logEntry)
 {
@@ -82,17 +88,18 @@ bool EventSubMatcher::matches(
     //                    << LOG_KV("logEntry topics", _logEntry.topics().size());
 
     // An empty address array matches all values otherwise log.address must be in addresses
-    if (!addresses.empty() && !addresses.count(std::string(_logEntry.address())))
+    // Note: the addresses and topics are compared without allocation
+    if (!addresses.empty() && !_params->hasAddress(_logEntry.address()))
     {
         return false;
     }
 
     bool isMatch = true;
+    const auto& logTopics = _logEntry.topics();
     for (unsigned i = 0; i < EVENT_LOG_TOPICS_MAX_INDEX; ++i)
     {
-        const auto& logTopics = _logEntry.topics();
         if (topics.size() > i && !topics[i].empty() &&
-            (logTopics.size() <= i || !topics[i].count(logTopics[i].hex())))
+            (logTopics.size() <= i || !_params->hasTopic(i, logTopics[i])))
         {
             isMatch = false;
             break;
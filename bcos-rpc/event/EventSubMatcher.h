@@ -47,6 +47,11 @@ public:
         bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex, Json::Value& _result);
     uint32_t matches(EventSubParams::ConstPtr _params, bcos::protocol::Block::ConstPtr _block,
         Json::Value& _result);
+
+    // the json of the matched log pushed to the client
+    static Json::Value logToJson(bcos::protocol::TransactionReceipt::ConstPtr _receipt,
+        bcos::protocol::Transaction::ConstPtr _tx, std::size_t _txIndex,
+        const bcos::protocol::LogEntry& _logEntry, std::size_t _logIndex);
 };
 
 }  // namespace event
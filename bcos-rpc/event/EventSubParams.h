@@ -19,9 +19,13 @@
  */
 
 #pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
 #include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
 #include <bcos-rpc/event/Common.h>
+#include <algorithm>
+#include <cctype>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace bcos
@@ -44,7 +48,14 @@ public:
 
     void setFromBlock(int64_t _fromBlock) { m_fromBlock = _fromBlock; }
     void setToBlock(int64_t _toBlock) { m_toBlock = _toBlock; }
-    void addAddress(const std::string& _address) { m_addresses.insert(_address); }
+    void addAddress(const std::string& _address)
+    {
+        if (m_addresses.insert(_address).second)
+        {
+            m_addressKeys.insert(
+                std::lower_bound(m_addressKeys.begin(), m_addressKeys.end(), _address), _address);
+        }
+    }
     bool addTopic(std::size_t _index, const std::string& _topic)
     {
         if (_index >= EVENT_LOG_TOPICS_MAX_INDEX)
@@ -52,16 +63,72 @@ public:
             return false;
         }
 
-        m_topics.resize(_index + 1);
+        if (m_topics.size() <= _index)
+        {
+            m_topics.resize(_index + 1);
+            m_topicKeys.resize(_index + 1);
+        }
         m_topics[_index].insert(_topic);
+        // the topic not a 32 bytes hex never matches, only the string is kept
+        if (!isTopicHex(_topic))
+        {
+            return true;
+        }
+        auto topicKey = bcos::crypto::HashType(std::string(stripHexPrefix(_topic)));
+        auto& topicKeys = m_topicKeys[_index];
+        auto it = std::lower_bound(topicKeys.begin(), topicKeys.end(), topicKey);
+        if (it == topicKeys.end() || *it != topicKey)
+        {
+            topicKeys.insert(it, topicKey);
+        }
         return true;
     }
 
+    // the lookups of the matcher, compare the raw bytes without allocation
+    bool hasAddress(std::string_view _address) const
+    {
+        auto it = std::lower_bound(m_addressKeys.begin(), m_addressKeys.end(), _address,
+            [](std::string const& _key, std::string_view _value) { return _key < _value; });
+        return it != m_addressKeys.end() && *it == _address;
+    }
+    bool hasTopic(std::size_t _index, bcos::crypto::HashType const& _topic) const
+    {
+        if (_index >= m_topicKeys.size())
+        {
+            return false;
+        }
+        return std::binary_search(m_topicKeys[_index].begin(), m_topicKeys[_index].end(), _topic);
+    }
+    // the binary topics of each index in ascending order
+    const std::vector<std::vector<bcos::crypto::HashType>>& topicKeys() const
+    {
+        return m_topicKeys;
+    }
+
+    // the hex of 32 bytes in any case, with or without the 0x prefix
+    static bool isTopicHex(const std::string& _topic)
+    {
+        auto hex = stripHexPrefix(_topic);
+        return hex.size() == 2 * bcos::crypto::HashType::size &&
+               std::all_of(hex.begin(), hex.end(), [](char _c) { return ::isxdigit(_c); });
+    }
+    static std::string_view stripHexPrefix(std::string_view _hex)
+    {
+        if (_hex.size() >= 2 && _hex[0] == '0' && (_hex[1] == 'x' || _hex[1] == 'X'))
+        {
+            _hex.remove_prefix(2);
+        }
+        return _hex;
+    }
+
 private:
     bcos::protocol::BlockNumber m_fromBlock = -1;
     bcos::protocol::BlockNumber m_toBlock = -1;
     std::set<std::string> m_addresses;
     std::vector<std::set<std::string>> m_topics;
+    // the flat sorted copies of m_addresses and m_topics for the matcher
+    std::vector<std::string> m_addressKeys;
+    std::vector<std::vector<bcos::crypto::HashType>> m_topicKeys;
 };
 
 }  // namespace event
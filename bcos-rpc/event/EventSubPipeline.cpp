@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief process a range of blocks of an event sub task with concurrent fetches
+ * @file EventSubPipeline.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventSub.h>
+#include <bcos-rpc/event/EventSubPipeline.h>
+#include <chrono>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+
+void EventSubPipeline::fetchBlocks()
+{
+    auto eventSub = m_eventSub.lock();
+    {
+        Guard l(x_pipeline);
+        // the blocks skipped by the bloom are matched synchronously, fetch them in the loop
+        // instead of recursively
+        if (m_fetching)
+        {
+            return;
+        }
+        m_stopped = m_stopped || !eventSub;
+        m_fetching = (eventSub != nullptr);
+    }
+    if (!eventSub)
+    {
+        tryFinish();
+        return;
+    }
+    auto self = shared_from_this();
+    while (true)
+    {
+        std::vector<size_t> indexes;
+        {
+            Guard l(x_pipeline);
+            auto window = m_task->state()->fetchWindow();
+            while (!m_stopped && m_failedIndex == std::numeric_limits<size_t>::max() &&
+                   m_inflight < window && m_nextFetch < m_blocks.size())
+            {
+                indexes.push_back(m_nextFetch++);
+                m_inflight++;
+            }
+            if (indexes.empty())
+            {
+                m_fetching = false;
+                break;
+            }
+        }
+        for (auto index : indexes)
+        {
+            auto blockNumber = m_blocks[index];
+            EVENT_SUB(TRACE) << LOG_BADGE("EventSubPipeline") << LOG_DESC("fetch block")
+                             << LOG_KV("id", m_task->id()) << LOG_KV("blockNumber", blockNumber)
+                             << LOG_KV("toBlock", m_toBlock);
+            auto startTime = std::chrono::steady_clock::now();
+            eventSub->matchBlock(blockNumber, m_task,
+                [self, index, startTime](Error::Ptr _error, Json::Value& _result) {
+                    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - startTime)
+                                       .count();
+                    self->onBlockMatched(index, _error, _result, latency);
+                });
+        }
+    }
+    // the blocks finished while fetching skipped tryFinish
+    tryFinish();
+}
+
+void EventSubPipeline::onBlockMatched(
+    size_t _index, Error::Ptr _error, Json::Value& _result, uint64_t _latencyUs)
+{
+    auto failed = (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS);
+    {
+        Guard l(x_pipeline);
+        m_inflight--;
+        if (auto eventSub = m_eventSub.lock())
+        {
+            adjustWindowWithoutLock(*eventSub, failed, _latencyUs);
+        }
+        if (failed)
+        {
+            m_failedIndex = std::min(m_failedIndex, _index);
+        }
+        else
+        {
+            m_results[_index].swap(_result);
+        }
+    }
+    if (failed)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubPipeline") << LOG_DESC("process block failed")
+                           << LOG_KV("id", m_task->id()) << LOG_KV("blockNumber", m_blocks[_index])
+                           << LOG_KV("errorCode", _error->errorCode())
+                           << LOG_KV("errorMessage", _error->errorMessage());
+    }
+    deliverResults();
+    fetchBlocks();
+    tryFinish();
+}
+
+void EventSubPipeline::deliverResults()
+{
+    while (true)
+    {
+        auto eventSub = m_eventSub.lock();
+        bcos::protocol::BlockNumber blockNumber;
+        Json::Value result;
+        {
+            Guard l(x_pipeline);
+            m_stopped = m_stopped || !eventSub;
+            if (m_delivering || m_stopped || m_nextDeliver >= m_failedIndex)
+            {
+                return;
+            }
+            auto it = m_results.find(m_nextDeliver);
+            if (it == m_results.end())
+            {
+                return;
+            }
+            blockNumber = m_blocks[it->first];
+            result.swap(it->second);
+            m_results.erase(it);
+            m_delivering = true;
+        }
+        // the logs pushed before the task resumed from the cursor
+        auto cursor = m_task->cursor();
+        if (cursor && blockNumber <= cursor->blockNumber())
+        {
+            cursor->removeCovered(result);
+        }
+        auto pushed = true;
+        if (result.size() > 0)
+        {
+            auto pushBuffer = m_task->pushBuffer();
+            auto maxPushBytes = eventSub->maxPushBytes();
+            for (auto& jLog : result)
+            {
+                // flush before the log crosses the limit, so the logs of a large block are split
+                // into frames, and only a single log larger than the limit exceeds it
+                auto logBytes = EventSubPushBuffer::estimateBytes(jLog);
+                if (!pushBuffer->empty() && pushBuffer->bytes() + logBytes > maxPushBytes)
+                {
+                    pushed = flushPushBuffer();
+                    if (!pushed)
+                    {
+                        break;
+                    }
+                }
+                pushBuffer->append(jLog, logBytes);
+            }
+            if (pushed && (pushBuffer->bytes() >= maxPushBytes ||
+                              pushBuffer->age() >= eventSub->maxPushLatency()))
+            {
+                pushed = flushPushBuffer();
+            }
+        }
+        if (pushed)
+        {
+            m_task->state()->setCurrentBlockNumber(blockNumber + 1);
+        }
+        Guard l(x_pipeline);
+        m_delivering = false;
+        m_nextDeliver++;
+        m_stopped = !pushed;
+    }
+}
+
+void EventSubPipeline::tryFinish()
+{
+    auto eventSub = m_eventSub.lock();
+    bool failed = false;
+    bool delivered = false;
+    {
+        Guard l(x_pipeline);
+        m_stopped = m_stopped || !eventSub;
+        if (m_finished || m_fetching || m_delivering || m_inflight > 0)
+        {
+            return;
+        }
+        failed = (m_failedIndex != std::numeric_limits<size_t>::max());
+        if (!m_stopped && !failed && m_nextDeliver < m_blocks.size())
+        {
+            return;
+        }
+        m_finished = true;
+        m_results.clear();
+        delivered = !m_stopped && m_nextDeliver == std::min(m_failedIndex, m_blocks.size());
+    }
+    if (delivered)
+    {
+        // the blocks not in the list before the failed block or toBlock have no candidate log
+        m_task->state()->setCurrentBlockNumber(failed ? m_blocks[m_failedIndex] : m_toBlock + 1);
+    }
+    if (!m_stopped)
+    {
+        // keep buffering only if the task continues catching up right away
+        auto blockNumber = eventSub->groupManager()->getBlockNumberByGroup(m_task->group());
+        auto catchingUp = !failed && !m_task->isCompleted() &&
+                          m_task->state()->currentBlockNumber() <= blockNumber;
+        if (!catchingUp || m_task->pushBuffer()->age() >= eventSub->maxPushLatency())
+        {
+            // the disconnected session is checked by the worker
+            flushPushBuffer();
+        }
+    }
+    m_task->setWork(false);
+    if (!eventSub)
+    {
+        EVENT_SUB(DEBUG) << LOG_BADGE("EventSubPipeline")
+                         << LOG_DESC("the event sub is released, stop the task")
+                         << LOG_KV("id", m_task->id());
+        return;
+    }
+    if (failed)
+    {
+        // retry when the next block is notified or the idle check
+        eventSub->waitForBlock(
+            m_task, eventSub->groupManager()->getBlockNumberByGroup(m_task->group()));
+        return;
+    }
+    // the worker checks whether the task has more blocks to process or has been disconnected
+    eventSub->readyTask(m_task);
+}
+
+bool EventSubPipeline::flushPushBuffer()
+{
+    auto logs = m_task->pushBuffer()->take();
+    if (logs.empty())
+    {
+        return true;
+    }
+    EVENT_SUB(TRACE) << LOG_BADGE("EventSubPipeline") << LOG_DESC("push logs")
+                     << LOG_KV("id", m_task->id()) << LOG_KV("count", logs.size());
+    return m_task->callback()(m_task->id(), false, logs);
+}
+
+void EventSubPipeline::adjustWindowWithoutLock(
+    EventSub const& _eventSub, bool _failed, uint64_t _latencyUs)
+{
+    auto window = m_task->state()->fetchWindow();
+    if (_failed || _latencyUs > _eventSub.targetFetchLatency())
+    {
+        window = std::max(_eventSub.minFetchWindow(), window / 2);
+    }
+    else
+    {
+        window = std::min(_eventSub.maxFetchWindow(), window + 1);
+    }
+    m_task->state()->setFetchWindow(window);
+}
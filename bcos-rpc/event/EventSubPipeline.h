@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief process a range of blocks of an event sub task with concurrent fetches
+ * @file EventSubPipeline.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <bcos-rpc/event/EventSubTask.h>
+#include <json/json.h>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace bcos
+{
+namespace event
+{
+class EventSub;
+/**
+ * @brief the blocks of a range ending at toBlock are fetched and matched with at most fetchWindow
+ * blocks in flight, the matched logs are pushed strictly in block order; after a failed block
+ * the pipeline stops fetching, and the logs of the blocks before it are still pushed, so the task
+ * continues from the failed block next time; the blocks of the range not in the list have no
+ * candidate log, the task continues from toBlock + 1 when all the blocks are pushed; the logs
+ * of the blocks are buffered in the task and pushed in batches
+ *
+ * the pipeline holds the event sub weakly and locks it in each callback, so the pool thread
+ * answering the last block never drops the last reference and joins the pool from itself, the
+ * pipeline stops when the event sub is released
+ */
+class EventSubPipeline : public std::enable_shared_from_this<EventSubPipeline>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubPipeline>;
+
+    EventSubPipeline(std::shared_ptr<EventSub> _eventSub, EventSubTask::Ptr _task,
+        std::vector<bcos::protocol::BlockNumber> _blocks, bcos::protocol::BlockNumber _toBlock)
+      : m_eventSub(_eventSub), m_task(_task), m_blocks(std::move(_blocks)), m_toBlock(_toBlock)
+    {}
+    virtual ~EventSubPipeline() {}
+
+    void start() { fetchBlocks(); }
+
+private:
+    void fetchBlocks();
+    void onBlockMatched(
+        size_t _index, Error::Ptr _error, Json::Value& _result, uint64_t _latencyUs);
+    // push the matched logs in block order, only one thread pushes at a time
+    void deliverResults();
+    void tryFinish();
+    // push the buffered logs of the task in one frame, false if the session is disconnected
+    bool flushPushBuffer();
+    void adjustWindowWithoutLock(EventSub const& _eventSub, bool _failed, uint64_t _latencyUs);
+
+private:
+    std::weak_ptr<EventSub> m_eventSub;
+    EventSubTask::Ptr m_task;
+    // the blocks to process in ascending order
+    std::vector<bcos::protocol::BlockNumber> m_blocks;
+    bcos::protocol::BlockNumber m_toBlock;
+
+    // the indexes of m_blocks
+    size_t m_nextFetch = 0;
+    size_t m_nextDeliver = 0;
+    size_t m_failedIndex = std::numeric_limits<size_t>::max();
+    int64_t m_inflight = 0;
+    // the matched logs of the blocks finished out of order
+    std::map<size_t, Json::Value> m_results;
+    bool m_fetching = false;
+    bool m_delivering = false;
+    // the session of the task has been disconnected
+    bool m_stopped = false;
+    bool m_finished = false;
+    mutable Mutex x_pipeline;
+};
+}  // namespace event
+}  // namespace bcos
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the matched logs of the blocks of a task waiting to be pushed in one frame
+ * @file EventSubPushBuffer.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#include <bcos-rpc/event/EventSubPushBuffer.h>
+
+using namespace bcos;
+using namespace bcos::event;
+
+namespace
+{
+// the fields of a log except the data and the topics: the address, the block number, the
+// transaction hash, the indexes and the json punctuation
+constexpr size_t c_logFixedBytes = 256;
+// a hex topic with the quotes and the comma
+constexpr size_t c_topicBytes = 69;
+}  // namespace
+
+void EventSubPushBuffer::append(Json::Value& _log, size_t _bytes)
+{
+    Guard l(x_logs);
+    if (m_logs.empty())
+    {
+        m_firstAppendTime = std::chrono::steady_clock::now();
+    }
+    m_bytes += _bytes;
+    m_logs.append(std::move(_log));
+}
+
+Json::Value EventSubPushBuffer::take()
+{
+    Guard l(x_logs);
+    Json::Value logs(Json::arrayValue);
+    logs.swap(m_logs);
+    m_bytes = 0;
+    return logs;
+}
+
+bool EventSubPushBuffer::empty() const
+{
+    Guard l(x_logs);
+    return m_logs.empty();
+}
+
+size_t EventSubPushBuffer::bytes() const
+{
+    Guard l(x_logs);
+    return m_bytes;
+}
+
+uint64_t EventSubPushBuffer::age() const
+{
+    Guard l(x_logs);
+    if (m_logs.empty())
+    {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_firstAppendTime)
+        .count();
+}
+
+size_t EventSubPushBuffer::estimateBytes(Json::Value const& _log)
+{
+    size_t bytes = c_logFixedBytes;
+    // the data is estimated without copying the string
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (_log.isMember("data") && _log["data"].getString(&begin, &end))
+    {
+        bytes += end - begin;
+    }
+    if (_log.isMember("topics"))
+    {
+        bytes += _log["topics"].size() * c_topicBytes;
+    }
+    return bytes;
+}
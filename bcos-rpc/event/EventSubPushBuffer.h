@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the matched logs of the blocks of a task waiting to be pushed in one frame
+ * @file EventSubPushBuffer.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <json/json.h>
+#include <chrono>
+#include <memory>
+
+namespace bcos
+{
+namespace event
+{
+/**
+ * @brief the logs of the blocks are accumulated in block order, the owner flushes them before the
+ * estimated frame size crosses the threshold or when the age of the oldest log exceeds it
+ */
+class EventSubPushBuffer
+{
+public:
+    using Ptr = std::shared_ptr<EventSubPushBuffer>;
+
+    EventSubPushBuffer() : m_logs(Json::arrayValue) {}
+    virtual ~EventSubPushBuffer() {}
+
+    // move a log to the end of the buffer, _bytes is the estimated size of the log
+    void append(Json::Value& _log, size_t _bytes);
+    // take all the logs buffered
+    Json::Value take();
+
+    bool empty() const;
+    // the estimated size of the serialized logs
+    size_t bytes() const;
+    // the milliseconds since the oldest log buffered
+    uint64_t age() const;
+
+    // the estimated size of a serialized log
+    static size_t estimateBytes(Json::Value const& _log);
+
+private:
+    Json::Value m_logs;
+    size_t m_bytes = 0;
+    std::chrono::steady_clock::time_point m_firstAppendTime;
+    mutable Mutex x_logs;
+};
+}  // namespace event
+}  // namespace bcos
@@ -23,6 +23,7 @@
 #include <bcos-rpc/event/EventSubRequest.h>
 #include <bcos-rpc/event/EventSubTask.h>
 #include <json/json.h>
+#include <algorithm>
 #include <exception>
 
 using namespace bcos;
@@ -113,6 +114,7 @@ std::string EventSubRequest::generateJson() const
     {
     "id": "",
     "group": "",
+    "cursor": "",
     "params": {
         "fromBlock": -1,
         "toBlock": -1,
@@ -130,6 +132,11 @@ std::string EventSubRequest::generateJson() const
     jResult["id"] = id();
     // group
     jResult["group"] = group();
+    // cursor, optional
+    if (m_cursor)
+    {
+        jResult["cursor"] = m_cursor->encode();
+    }
 
     Json::Value jParams;
     // fromBlock
@@ -211,69 +218,25 @@ bool EventSubRequest::fromJson(const std::string& _request)
                 break;
             }
 
-            auto& jParams = root["params"];
-            if (jParams.isMember("fromBlock"))
-            {
-                params->setFromBlock(jParams["fromBlock"].asInt64());
-            }
+            paramsFromJson(root["params"], params);
 
-            if (jParams.isMember("toBlock"))
+            // the cursor overrides the fromBlock of the params
+            EventSubCursor::Ptr cursor;
+            if (root.isMember("cursor") && !root["cursor"].asString().empty())
             {
-                params->setToBlock(jParams["toBlock"].asInt64());
-            }
-
-            if (jParams.isMember("addresses"))
-            {
-                auto& jAddresses = jParams["addresses"];
-                for (Json::Value::ArrayIndex index = 0; index < jAddresses.size(); ++index)
+                cursor = EventSubCursor::decode(root["cursor"].asString());
+                if (!cursor)
                 {
-                    std::string address = jAddresses[index].asString();
-                    if ((address.compare(0, 2, "0x") == 0) || (address.compare(0, 2, "0X") == 0))
-                    {
-                        address = address.substr(2);
-                    }
-                    std::transform(address.begin(), address.end(), address.begin(), ::tolower);
-                    params->addAddress(address);
-                }
-            }
-
-            if (jParams.isMember("topics"))
-            {
-                auto& jTopics = jParams["topics"];
-
-                for (Json::Value::ArrayIndex index = 0; index < jTopics.size(); ++index)
-                {
-                    auto& jIndex = jTopics[index];
-                    if (jIndex.isNull())
-                    {
-                        continue;
-                    }
-
-                    if (jIndex.isArray())
-                    {  // array topics
-                        for (Json::Value::ArrayIndex innerIndex = 0; innerIndex < jIndex.size();
-                             ++innerIndex)
-                        {
-                            std::string topic = jIndex[innerIndex].asString();
-                            if ((topic.compare(0, 2, "0x") == 0) ||
-                                (topic.compare(0, 2, "0XC") == 0))
-                            {
-                                topic = topic.substr(2);
-                            }
-                            std::transform(topic.begin(), topic.end(), topic.begin(), ::tolower);
-                            params->addTopic(index, topic);
-                        }
-                    }
-                    else
-                    {  // single topic, string value
-                        params->addTopic(index, jIndex.asString());
-                    }
+                    errorMessage = "invalid \'cursor\' field";
+                    break;
                 }
+                params->setFromBlock(cursor->blockNumber());
             }
 
             setId(id);
             setGroup(group);
             setParams(params);
+            setCursor(cursor);
 
             EVENT_REQUEST(INFO) << LOG_BADGE("fromJson")
                                 << LOG_DESC("parse event sub request success")
@@ -296,3 +259,61 @@ bool EventSubRequest::fromJson(const std::string& _request)
 
     return false;
 }
+
+void EventSubRequest::paramsFromJson(const Json::Value& _jParams, EventSubParams::Ptr _params)
+{
+    auto normalize = [](std::string _hex) {
+        if ((_hex.compare(0, 2, "0x") == 0) || (_hex.compare(0, 2, "0X") == 0))
+        {
+            _hex = _hex.substr(2);
+        }
+        std::transform(_hex.begin(), _hex.end(), _hex.begin(), ::tolower);
+        return _hex;
+    };
+
+    if (_jParams.isMember("fromBlock"))
+    {
+        _params->setFromBlock(_jParams["fromBlock"].asInt64());
+    }
+
+    if (_jParams.isMember("toBlock"))
+    {
+        _params->setToBlock(_jParams["toBlock"].asInt64());
+    }
+
+    if (_jParams.isMember("addresses"))
+    {
+        auto& jAddresses = _jParams["addresses"];
+        for (Json::Value::ArrayIndex index = 0; index < jAddresses.size(); ++index)
+        {
+            _params->addAddress(normalize(jAddresses[index].asString()));
+        }
+    }
+
+    if (_jParams.isMember("topics"))
+    {
+        auto& jTopics = _jParams["topics"];
+
+        for (Json::Value::ArrayIndex index = 0; index < jTopics.size(); ++index)
+        {
+            auto& jIndex = jTopics[index];
+            if (jIndex.isNull())
+            {
+                continue;
+            }
+
+            if (jIndex.isArray())
+            {  // array topics
+                for (Json::Value::ArrayIndex innerIndex = 0; innerIndex < jIndex.size();
+                     ++innerIndex)
+                {
+                    _params->addTopic(index, normalize(jIndex[innerIndex].asString()));
+                }
+            }
+            else
+            {  // single topic, string value
+                _params->addTopic(index, normalize(jIndex.asString()));
+            }
+        }
+    }
+}
@@ -19,7 +19,9 @@
  */
 
 #pragma once
+#include <bcos-rpc/event/EventSubCursor.h>
 #include <bcos-rpc/event/EventSubParams.h>
+#include <json/json.h>
 
 namespace bcos
 {
@@ -59,12 +61,20 @@ public:
     void setParams(std::shared_ptr<EventSubParams> _params) { m_params = _params; }
     std::shared_ptr<EventSubParams> params() const { return m_params; }
 
+    // the cursor of the last log received, the sub resumes after it instead of fromBlock
+    void setCursor(EventSubCursor::ConstPtr _cursor) { m_cursor = _cursor; }
+    EventSubCursor::ConstPtr cursor() const { return m_cursor; }
+
     std::string generateJson() const override;
     bool fromJson(const std::string& _request) override;
 
+    // parse the fromBlock, toBlock, addresses and topics of the params object
+    static void paramsFromJson(const Json::Value& _jParams, EventSubParams::Ptr _params);
+
 private:
     std::shared_ptr<EventSubParams> m_params;
     std::shared_ptr<EventSubTaskState> m_state;
+    EventSubCursor::ConstPtr m_cursor;
 };
 
 }  // namespace event
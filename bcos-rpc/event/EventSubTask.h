@@ -21,7 +21,9 @@
 #pragma once
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventSubCursor.h>
 #include <bcos-rpc/event/EventSubParams.h>
+#include <bcos-rpc/event/EventSubPushBuffer.h>
 #include <json/json.h>
 #include <json/value.h>
 #include <functional>
@@ -47,8 +49,13 @@ public:
         }
     }
 
+    // the number of the blocks fetched concurrently when catching up, adapted to the latency
+    int64_t fetchWindow() const { return m_fetchWindow.load(); }
+    void setFetchWindow(int64_t _fetchWindow) { m_fetchWindow.store(_fetchWindow); }
+
 private:
     std::atomic<int64_t> m_currentBlockNumber = -1;
+    std::atomic<int64_t> m_fetchWindow = 4;
 };
 
 class EventSubTask
@@ -77,6 +84,13 @@ public:
     void setState(std::shared_ptr<EventSubTaskState> _state) { m_state = _state; }
     std::shared_ptr<EventSubTaskState> state() const { return m_state; }
 
+    // the logs covered by the cursor subscribed with have been pushed before, nullptr if none
+    void setCursor(EventSubCursor::ConstPtr _cursor) { m_cursor = _cursor; }
+    EventSubCursor::ConstPtr cursor() const { return m_cursor; }
+
+    // the matched logs not pushed yet
+    EventSubPushBuffer::Ptr pushBuffer() const { return m_pushBuffer; }
+
     void setCallback(Callback _callback) { m_callback = _callback; }
     Callback callback() const { return m_callback; }
 
@@ -102,6 +116,8 @@ private:
     std::shared_ptr<bcos::boostssl::ws::WsSession> m_session;
     std::shared_ptr<EventSubParams> m_params;
     std::shared_ptr<EventSubTaskState> m_state;
+    EventSubCursor::ConstPtr m_cursor;
+    EventSubPushBuffer::Ptr m_pushBuffer = std::make_shared<EventSubPushBuffer>();
 
 private:
     Callback m_callback;
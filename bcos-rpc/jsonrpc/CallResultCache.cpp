@@ -0,0 +1,135 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief block-scoped cache for the result of the read-only call
+ * @file CallResultCache.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/jsonrpc/CallResultCache.h>
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+std::string CallResultCache::normalizeAddress(std::string const& _address)
+{
+    std::string address = _address;
+    if ((address.compare(0, 2, "0x") == 0) || (address.compare(0, 2, "0X") == 0))
+    {
+        address = address.substr(2);
+    }
+    std::transform(address.begin(), address.end(), address.begin(), ::tolower);
+    return address;
+}
+
+void CallResultCache::setAllowlist(std::set<std::string> const& _contracts)
+{
+    std::set<std::string> allowlist;
+    for (auto const& contract : _contracts)
+    {
+        allowlist.insert(normalizeAddress(contract));
+    }
+    WriteGuard l(x_allowlist);
+    m_allowlist.swap(allowlist);
+}
+
+bool CallResultCache::cacheable(std::string const& _to) const
+{
+    ReadGuard l(x_allowlist);
+    if (m_allowlist.empty())
+    {
+        return true;
+    }
+    return m_allowlist.count(normalizeAddress(_to));
+}
+
+bool CallResultCache::get(std::string const& _groupID, std::string const& _to,
+    bcos::crypto::HashType const& _dataHash, bcos::protocol::BlockNumber _blockNumber,
+    Json::Value& _result) const
+{
+    auto key = toKey(_to, _dataHash);
+    ReadGuard l(x_groupResults);
+    auto it = m_groupResults.find(_groupID);
+    if (it == m_groupResults.end() || it->second.blockNumber != _blockNumber)
+    {
+        return false;
+    }
+    auto const& results = it->second.results;
+    auto resultIt = results.find(key);
+    if (resultIt == results.end())
+    {
+        return false;
+    }
+    _result = resultIt->second;
+    return true;
+}
+
+void CallResultCache::insert(std::string const& _groupID, std::string const& _to,
+    bcos::crypto::HashType const& _dataHash, bcos::protocol::BlockNumber _blockNumber,
+    Json::Value const& _result)
+{
+    auto key = toKey(_to, _dataHash);
+    auto resultSize = key.size() + _result["output"].asString().size();
+    WriteGuard l(x_groupResults);
+    auto& groupResults = m_groupResults[_groupID];
+    // the result of the expired block
+    if (groupResults.blockNumber > _blockNumber)
+    {
+        return;
+    }
+    if (groupResults.blockNumber < _blockNumber)
+    {
+        m_size -= groupResults.size;
+        groupResults.results.clear();
+        groupResults.size = 0;
+        groupResults.blockNumber = _blockNumber;
+    }
+    if (groupResults.results.count(key))
+    {
+        return;
+    }
+    // the cache is dropped every block, so the results beyond the capacity are not cached,
+    // checked under the lock of the insert so the concurrent inserts never exceed the capacity
+    if (m_size.load() + resultSize > m_capacity.load())
+    {
+        RPC_IMPL_LOG(TRACE) << LOG_BADGE("CallResultCache") << LOG_DESC("exceed the capacity")
+                            << LOG_KV("group", _groupID) << LOG_KV("size", m_size.load());
+        return;
+    }
+    groupResults.results[key] = _result;
+    groupResults.size += resultSize;
+    m_size += resultSize;
+}
+
+void CallResultCache::onBlockNumberUpdated(
+    std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber)
+{
+    WriteGuard l(x_groupResults);
+    auto it = m_groupResults.find(_groupID);
+    if (it == m_groupResults.end() || it->second.blockNumber >= _blockNumber)
+    {
+        return;
+    }
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("CallResultCache") << LOG_DESC("clear expired results")
+                        << LOG_KV("group", _groupID)
+                        << LOG_KV("cachedBlock", it->second.blockNumber)
+                        << LOG_KV("block", _blockNumber)
+                        << LOG_KV("results", it->second.results.size());
+    m_size -= it->second.size;
+    m_groupResults.erase(it);
+}
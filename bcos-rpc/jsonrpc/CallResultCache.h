@@ -0,0 +1,97 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief block-scoped cache for the result of the read-only call
+ * @file CallResultCache.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <json/json.h>
+#include <atomic>
+#include <set>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace rpc
+{
+/**
+ * @brief cache the result of call for the highest block of the group,
+ * all the cached results of the group are dropped when the group reaches a new block
+ */
+class CallResultCache
+{
+public:
+    using Ptr = std::shared_ptr<CallResultCache>;
+    CallResultCache() = default;
+    virtual ~CallResultCache() {}
+
+    // disabled by default, rpc.call_cache_enable of config.ini
+    bool enabled() const { return m_enabled.load(); }
+    void setEnabled(bool _enabled) { m_enabled.store(_enabled); }
+
+    // the max bytes of the cached results
+    uint64_t capacity() const { return m_capacity.load(); }
+    void setCapacity(uint64_t _capacity) { m_capacity.store(_capacity); }
+    uint64_t size() const { return m_size.load(); }
+
+    // only the calls to the contracts in the allowlist will be cached,
+    // all the contracts are cacheable when the allowlist is empty
+    void setAllowlist(std::set<std::string> const& _contracts);
+    bool cacheable(std::string const& _to) const;
+
+    bool get(std::string const& _groupID, std::string const& _to,
+        bcos::crypto::HashType const& _dataHash, bcos::protocol::BlockNumber _blockNumber,
+        Json::Value& _result) const;
+    void insert(std::string const& _groupID, std::string const& _to,
+        bcos::crypto::HashType const& _dataHash, bcos::protocol::BlockNumber _blockNumber,
+        Json::Value const& _result);
+
+    // called when the highest block number of the group has been increased
+    void onBlockNumberUpdated(
+        std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber);
+
+private:
+    static std::string normalizeAddress(std::string const& _address);
+    static std::string toKey(std::string const& _to, bcos::crypto::HashType const& _dataHash)
+    {
+        return normalizeAddress(_to) + "_" + _dataHash.hex();
+    }
+
+    struct GroupCallResults
+    {
+        bcos::protocol::BlockNumber blockNumber = -1;
+        uint64_t size = 0;
+        std::unordered_map<std::string, Json::Value> results;
+    };
+
+private:
+    std::atomic_bool m_enabled = {false};
+    std::atomic<uint64_t> m_capacity = {64 * 1024 * 1024};
+    std::atomic<uint64_t> m_size = {0};
+
+    // groupID => the call results of the highest block
+    std::unordered_map<std::string, GroupCallResults> m_groupResults;
+    mutable SharedMutex x_groupResults;
+
+    std::set<std::string> m_allowlist;
+    mutable SharedMutex x_allowlist;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -0,0 +1,177 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief content-addressed cache for the contract code
+ * @file CodeCache.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/jsonrpc/CodeCache.h>
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+std::string CodeCache::toKey(std::string const& _groupID, std::string const& _address)
+{
+    std::string address = _address;
+    if ((address.compare(0, 2, "0x") == 0) || (address.compare(0, 2, "0X") == 0))
+    {
+        address = address.substr(2);
+    }
+    std::transform(address.begin(), address.end(), address.begin(), ::tolower);
+    return _groupID + "_" + address;
+}
+
+bool CodeCache::expired(
+    bcos::protocol::BlockNumber _cachedBlockNumber, bcos::protocol::BlockNumber _blockNumber) const
+{
+    // the entry cached at a higher block is not visible to the lower block
+    if (_cachedBlockNumber > _blockNumber)
+    {
+        return true;
+    }
+    auto maxBlockAge = m_maxBlockAge.load();
+    return (maxBlockAge >= 0 && _blockNumber - _cachedBlockNumber > maxBlockAge);
+}
+
+void CodeCache::setCapacity(uint64_t _capacity)
+{
+    m_capacity.store(_capacity);
+    Guard l(x_codeCache);
+    evictIfNeeded();
+}
+
+CodeCache::CodePtr CodeCache::get(std::string const& _groupID, std::string const& _address,
+    bcos::protocol::BlockNumber _blockNumber)
+{
+    if (!enabled())
+    {
+        return nullptr;
+    }
+    auto key = toKey(_groupID, _address);
+    Guard l(x_codeCache);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return nullptr;
+    }
+    if (expired(it->second.blockNumber, _blockNumber))
+    {
+        // the expired entry of the lower block will be replaced by the refetched code
+        return nullptr;
+    }
+    auto blobIt = m_codeBlobs.find(it->second.codeHash);
+    if (blobIt == m_codeBlobs.end())
+    {
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruIt);
+    return blobIt->second.code;
+}
+
+void CodeCache::insert(std::string const& _groupID, std::string const& _address,
+    bcos::protocol::BlockNumber _blockNumber, bcos::crypto::HashType const& _codeHash,
+    std::string const& _hexCode)
+{
+    // the contract may be deployed later, the empty code is never cached
+    if (!enabled() || _hexCode.empty() || _hexCode.size() > m_capacity.load())
+    {
+        return;
+    }
+    auto key = toKey(_groupID, _address);
+    Guard l(x_codeCache);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+        // keep the entry of the higher block
+        if (it->second.blockNumber > _blockNumber)
+        {
+            return;
+        }
+        removeEntry(it);
+    }
+    auto& blob = m_codeBlobs[_codeHash];
+    if (!blob.code)
+    {
+        blob.code = std::make_shared<const std::string>(_hexCode);
+        m_size += _hexCode.size();
+    }
+    blob.refCount++;
+    m_lru.push_front(key);
+    m_entries[key] = CodeEntry{_codeHash, _blockNumber, m_lru.begin()};
+    evictIfNeeded();
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("CodeCache") << LOG_DESC("insert")
+                        << LOG_KV("group", _groupID) << LOG_KV("address", _address)
+                        << LOG_KV("block", _blockNumber) << LOG_KV("size", m_size.load());
+}
+
+void CodeCache::invalidate(std::string const& _groupID, std::string const& _address)
+{
+    auto key = toKey(_groupID, _address);
+    Guard l(x_codeCache);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    removeEntry(it);
+    RPC_IMPL_LOG(DEBUG) << LOG_BADGE("CodeCache") << LOG_DESC("invalidate the redeployed code")
+                        << LOG_KV("group", _groupID) << LOG_KV("address", _address);
+}
+
+void CodeCache::onBlock(std::string const& _groupID, bcos::protocol::Block::ConstPtr _block)
+{
+    if (!enabled() || !_block)
+    {
+        return;
+    }
+    for (std::size_t index = 0; index < _block->receiptsSize(); index++)
+    {
+        auto receipt = _block->receipt(index);
+        if (receipt && !receipt->contractAddress().empty())
+        {
+            invalidate(_groupID, std::string(receipt->contractAddress()));
+        }
+    }
+}
+
+void CodeCache::removeEntry(std::unordered_map<std::string, CodeEntry>::iterator _it)
+{
+    auto blobIt = m_codeBlobs.find(_it->second.codeHash);
+    if (blobIt != m_codeBlobs.end() && (--blobIt->second.refCount) == 0)
+    {
+        m_size -= blobIt->second.code->size();
+        m_codeBlobs.erase(blobIt);
+    }
+    m_lru.erase(_it->second.lruIt);
+    m_entries.erase(_it);
+}
+
+void CodeCache::evictIfNeeded()
+{
+    while (m_size.load() > m_capacity.load() && !m_lru.empty())
+    {
+        auto it = m_entries.find(m_lru.back());
+        if (it == m_entries.end())
+        {
+            m_lru.pop_back();
+            continue;
+        }
+        removeEntry(it);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief content-addressed cache for the contract code
+ * @file CodeCache.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+#include <list>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace rpc
+{
+/**
+ * @brief cache the hex encoded code of the contracts, the code is stored once by its hash and
+ * shared by all the (group, address) entries referring to it, the least recently used entries
+ * are evicted when the cached code exceeds the capacity
+ */
+class CodeCache
+{
+public:
+    using Ptr = std::shared_ptr<CodeCache>;
+    using CodePtr = std::shared_ptr<const std::string>;
+    CodeCache() = default;
+    virtual ~CodeCache() {}
+
+    bool enabled() const { return m_enabled.load(); }
+    void setEnabled(bool _enabled) { m_enabled.store(_enabled); }
+
+    // the max bytes of the cached code
+    uint64_t capacity() const { return m_capacity.load(); }
+    void setCapacity(uint64_t _capacity);
+    uint64_t size() const { return m_size.load(); }
+
+    // the entries cached more than maxBlockAge blocks ago are refetched, which bounds the staleness
+    // of the code destroyed or redeployed without a deploy signal, -1 means never expire for the
+    // chains without them
+    bcos::protocol::BlockNumber maxBlockAge() const { return m_maxBlockAge.load(); }
+    void setMaxBlockAge(bcos::protocol::BlockNumber _maxBlockAge)
+    {
+        m_maxBlockAge.store(_maxBlockAge);
+    }
+
+    // get the hex encoded code cached no later than the given block, return nullptr if missed
+    CodePtr get(std::string const& _groupID, std::string const& _address,
+        bcos::protocol::BlockNumber _blockNumber);
+    void insert(std::string const& _groupID, std::string const& _address,
+        bcos::protocol::BlockNumber _blockNumber, bcos::crypto::HashType const& _codeHash,
+        std::string const& _hexCode);
+
+    // the deploy signal, remove the entry of the contract deployed at the address again
+    void invalidate(std::string const& _groupID, std::string const& _address);
+    // invalidate the contracts deployed by the receipts of the block
+    void onBlock(std::string const& _groupID, bcos::protocol::Block::ConstPtr _block);
+
+private:
+    static std::string toKey(std::string const& _groupID, std::string const& _address);
+    bool expired(bcos::protocol::BlockNumber _cachedBlockNumber,
+        bcos::protocol::BlockNumber _blockNumber) const;
+
+    struct CodeBlob
+    {
+        CodePtr code;
+        size_t refCount = 0;
+    };
+    struct CodeEntry
+    {
+        bcos::crypto::HashType codeHash;
+        bcos::protocol::BlockNumber blockNumber;
+        // the position in the lru list
+        std::list<std::string>::iterator lruIt;
+    };
+    // remove the entry and release the code if no entry refers to it, called with the lock held
+    void removeEntry(std::unordered_map<std::string, CodeEntry>::iterator _it);
+    void evictIfNeeded();
+
+private:
+    std::atomic_bool m_enabled = {true};
+    std::atomic<uint64_t> m_capacity = {32 * 1024 * 1024};
+    std::atomic<uint64_t> m_size = {0};
+    std::atomic<bcos::protocol::BlockNumber> m_maxBlockAge = {10};
+
+    // codeHash => the shared hex encoded code
+    std::unordered_map<bcos::crypto::HashType, CodeBlob, std::hash<bcos::crypto::HashType>>
+        m_codeBlobs;
+    // group_address => the code entry
+    std::unordered_map<std::string, CodeEntry> m_entries;
+    // the keys of the entries, the most recently used at the front
+    std::list<std::string> m_lru;
+    mutable Mutex x_codeCache;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -0,0 +1,153 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache the json of the group info by the version of the group info
+ * @file GroupInfoCache.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include "GroupInfoCache.h"
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/ws/ProtocolVersion.h>
+using namespace bcos;
+using namespace bcos::rpc;
+
+CachedGroupInfo::ConstPtr GroupInfoCache::groupInfo(std::string const& _groupID)
+{
+    // load the version before the group info, the json built from a newer group info with an
+    // older version is rebuilt next time, but an older group info is never cached as newer
+    auto version = m_groupManager->groupInfoVersion(_groupID);
+    auto cached = cachedGroupInfo(_groupID, version);
+    if (cached)
+    {
+        return cached;
+    }
+    Guard l(x_buildGroupInfo);
+    // built by another thread
+    cached = cachedGroupInfo(_groupID, version);
+    if (cached)
+    {
+        return cached;
+    }
+    auto groupInfo = m_groupManager->getGroupInfo(_groupID);
+    if (!groupInfo)
+    {
+        WriteGuard writeGuard(x_groupInfos);
+        m_groupInfos.erase(_groupID);
+        return nullptr;
+    }
+    auto updatedGroupInfo = std::make_shared<CachedGroupInfo>();
+    updatedGroupInfo->version = version;
+    groupInfoToJson(updatedGroupInfo->json, groupInfo);
+    updatedGroupInfo->data = serialize(updatedGroupInfo->json);
+    {
+        WriteGuard writeGuard(x_groupInfos);
+        m_groupInfos[_groupID] = updatedGroupInfo;
+    }
+    RPC_IMPL_LOG(DEBUG) << LOG_DESC("GroupInfoCache: rebuild the group info")
+                        << LOG_KV("group", _groupID) << LOG_KV("version", version)
+                        << LOG_KV("size", updatedGroupInfo->data->size());
+    return updatedGroupInfo;
+}
+
+CachedGroupInfo::ConstPtr GroupInfoCache::groupInfoList()
+{
+    auto version = m_groupManager->groupInfoListVersion();
+    auto cached = std::atomic_load(&m_groupInfoList);
+    if (cached && cached->version >= version)
+    {
+        return cached;
+    }
+    Guard l(x_buildGroupInfoList);
+    cached = std::atomic_load(&m_groupInfoList);
+    if (cached && cached->version >= version)
+    {
+        return cached;
+    }
+    auto updatedGroupInfoList = std::make_shared<CachedGroupInfo>();
+    updatedGroupInfoList->version = version;
+    // splice the serialized group info, the groups not updated are neither copied nor rebuilt
+    std::string data = "[";
+    auto groupIDs = m_groupManager->sortedGroupIDs();
+    for (auto const& groupID : *groupIDs)
+    {
+        auto cachedGroupInfo = groupInfo(groupID);
+        if (!cachedGroupInfo)
+        {
+            continue;
+        }
+        if (data.size() > 1)
+        {
+            data.append(",");
+        }
+        appendSerialized(data, *cachedGroupInfo->data);
+    }
+    data.append("]\n");
+    updatedGroupInfoList->data = std::make_shared<bcos::bytes>(data.begin(), data.end());
+    std::atomic_store(
+        &m_groupInfoList, CachedGroupInfo::ConstPtr(std::move(updatedGroupInfoList)));
+    return std::atomic_load(&m_groupInfoList);
+}
+
+std::shared_ptr<bcos::bytes> GroupInfoCache::handshakeResponse(
+    int _protocolVersion, bool _onlyGroupID)
+{
+    auto version = m_groupManager->groupInfoListVersion();
+    auto key = std::make_pair(_protocolVersion, _onlyGroupID);
+    Guard l(x_handshakeResponses);
+    // the response built from a newer group info list by another thread is kept
+    auto it = m_handshakeResponses.find(key);
+    if (it != m_handshakeResponses.end() && it->second->version >= version)
+    {
+        return it->second->data;
+    }
+    ws::ProtocolVersion protocolVersion;
+    protocolVersion.setProtocolVersion(_protocolVersion);
+    auto result = protocolVersion.toJson();
+    // only the serialized response is kept
+    auto response = std::make_shared<CachedGroupInfo>();
+    if (_onlyGroupID)
+    {
+        // the group info is fetched by getGroupInfo when used
+        response->version = version;
+        result["groupList"] = Json::Value(Json::arrayValue);
+        auto groupIDs = m_groupManager->sortedGroupIDs();
+        for (auto const& groupID : *groupIDs)
+        {
+            result["groupList"].append(groupID);
+        }
+        response->data = serialize(result);
+    }
+    else
+    {
+        auto groupInfoList = this->groupInfoList();
+        response->version = groupInfoList->version;
+        // splice the serialized group info list into the protocol version object
+        Json::FastWriter writer;
+        auto data = writer.write(result);
+        // remove the closing "}\n"
+        data.resize(data.size() - 2);
+        if (data.size() > 1)
+        {
+            data.append(",");
+        }
+        data.append("\"groupInfoList\":");
+        appendSerialized(data, *groupInfoList->data);
+        data.append("}\n");
+        response->data = std::make_shared<bcos::bytes>(data.begin(), data.end());
+    }
+    m_handshakeResponses[key] = response;
+    return response->data;
+}
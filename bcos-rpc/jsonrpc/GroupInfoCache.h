@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cache the json of the group info by the version of the group info
+ * @file GroupInfoCache.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <json/json.h>
+#include <map>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace rpc
+{
+struct CachedGroupInfo
+{
+    using ConstPtr = std::shared_ptr<const CachedGroupInfo>;
+    // the version of the group info or the group info list that the json is built from
+    uint64_t version = 0;
+    // the json of the group info, null for the group info list, whose data is spliced from the
+    // serialized group info
+    Json::Value json;
+    // the serialized json, shared by the messages sent to the sessions, must not be modified
+    std::shared_ptr<bcos::bytes> data;
+};
+
+/**
+ * @brief the json of the group info(including the large genesisConfig and iniConfig) is built and
+ * serialized once per version of the group info, instead of once per getGroupInfoList request,
+ * handshake or session; the json is rebuilt by only one thread when the version changes
+ */
+class GroupInfoCache
+{
+public:
+    using Ptr = std::shared_ptr<GroupInfoCache>;
+    explicit GroupInfoCache(GroupManager::Ptr _groupManager)
+      : m_groupManager(std::move(_groupManager))
+    {}
+    virtual ~GroupInfoCache() {}
+
+    // return nullptr if the group does not exist
+    virtual CachedGroupInfo::ConstPtr groupInfo(std::string const& _groupID);
+    // the serialized json array of all the group info in ascending order of the groupID
+    virtual CachedGroupInfo::ConstPtr groupInfoList();
+    // the serialized handshake response with the protocol version and the group info list, or
+    // only the groupIDs if _onlyGroupID is true, which keeps the handshake small for many groups
+    virtual std::shared_ptr<bcos::bytes> handshakeResponse(
+        int _protocolVersion, bool _onlyGroupID = false);
+
+    static std::shared_ptr<bcos::bytes> serialize(Json::Value const& _json)
+    {
+        Json::FastWriter writer;
+        auto result = writer.write(_json);
+        return std::make_shared<bcos::bytes>(result.begin(), result.end());
+    }
+    // append the json serialized by Json::FastWriter without the ending line feed
+    static void appendSerialized(std::string& _output, bcos::bytes const& _data)
+    {
+        auto end = _data.end();
+        if (!_data.empty() && _data.back() == '\n')
+        {
+            end--;
+        }
+        _output.append(_data.begin(), end);
+    }
+
+private:
+    CachedGroupInfo::ConstPtr cachedGroupInfo(std::string const& _groupID, uint64_t _version) const
+    {
+        ReadGuard l(x_groupInfos);
+        auto it = m_groupInfos.find(_groupID);
+        if (it == m_groupInfos.end() || it->second->version < _version)
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+private:
+    GroupManager::Ptr m_groupManager;
+
+    // groupID => the json of the group info
+    std::unordered_map<std::string, CachedGroupInfo::ConstPtr> m_groupInfos;
+    mutable SharedMutex x_groupInfos;
+    Mutex x_buildGroupInfo;
+
+    // read without lock, replaced by the thread holding x_buildGroupInfoList
+    CachedGroupInfo::ConstPtr m_groupInfoList;
+    Mutex x_buildGroupInfoList;
+
+    // (protocolVersion, onlyGroupID) => the handshake response
+    std::map<std::pair<int, bool>, CachedGroupInfo::ConstPtr> m_handshakeResponses;
+    Mutex x_handshakeResponses;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -25,6 +25,7 @@
 #include <bcos-framework/libprotocol/TransactionStatus.h>
 #include <bcos-framework/libutilities/Base64.h>
 #include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/event/EventSubRequest.h>
 #include <bcos-rpc/jsonrpc/Common.h>
 #include <bcos-rpc/jsonrpc/JsonRpcImpl_2_0.h>
 #include <boost/archive/iterators/base64_from_binary.hpp>
@@ -34,6 +35,8 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <atomic>
+#include <chrono>
 #include <string>
 
 using namespace std;
@@ -91,8 +94,32 @@ void JsonRpcImpl_2_0::initMethod()
         &JsonRpcImpl_2_0::getGroupInfoI, this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getGroupInfoList"] = std::bind(
         &JsonRpcImpl_2_0::getGroupInfoListI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["getGroupListByPage"] = std::bind(
+        &JsonRpcImpl_2_0::getGroupListByPageI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["getGroupInfoListByPage"] = std::bind(&JsonRpcImpl_2_0::getGroupInfoListByPageI,
+        this, std::placeholders::_1, std::placeholders::_2);
     m_methodToFunc["getGroupNodeInfo"] = std::bind(
         &JsonRpcImpl_2_0::getGroupNodeInfoI, this, std::placeholders::_1, std::placeholders::_2);
+    // the group info is answered by the serialized json cached in m_groupInfoCache
+    m_methodToSerializedFunc["getGroupInfo"] = std::bind(&JsonRpcImpl_2_0::getSerializedGroupInfo,
+        this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToSerializedFunc["getGroupInfoList"] =
+        std::bind(&JsonRpcImpl_2_0::getSerializedGroupInfoList, this, std::placeholders::_1,
+            std::placeholders::_2);
+    m_methodToSerializedFunc["getGroupInfoListByPage"] =
+        std::bind(&JsonRpcImpl_2_0::getSerializedGroupInfoListByPage, this, std::placeholders::_1,
+            std::placeholders::_2);
+
+    m_methodToFunc["getLogs"] =
+        std::bind(&JsonRpcImpl_2_0::getLogsI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["newFilter"] = std::bind(
+        &JsonRpcImpl_2_0::newFilterI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["newBlockFilter"] = std::bind(
+        &JsonRpcImpl_2_0::newBlockFilterI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["getFilterChanges"] = std::bind(
+        &JsonRpcImpl_2_0::getFilterChangesI, this, std::placeholders::_1, std::placeholders::_2);
+    m_methodToFunc["uninstallFilter"] = std::bind(
+        &JsonRpcImpl_2_0::uninstallFilterI, this, std::placeholders::_1, std::placeholders::_2);
 
     for (const auto& method : m_methodToFunc)
     {
@@ -268,6 +295,19 @@ std::string JsonRpcImpl_2_0::toStringResponse(const JsonResponse& _jsonResponse)
     return resp;
 }
 
+std::string JsonRpcImpl_2_0::toSerializedResponsePrefix(const JsonResponse& _jsonResponse)
+{
+    Json::Value jResp;
+    jResp["jsonrpc"] = _jsonResponse.jsonrpc;
+    jResp["id"] = _jsonResponse.id;
+    Json::FastWriter writer;
+    std::string resp = writer.write(jResp);
+    // remove the closing "}\n"
+    resp.resize(resp.size() - 2);
+    resp.append(",\"result\":");
+    return resp;
+}
+
 Json::Value JsonRpcImpl_2_0::toJsonResponse(const JsonResponse& _jsonResponse)
 {
     Json::Value jResp;
@@ -301,6 +341,15 @@ void JsonRpcImpl_2_0::onRPCRequest(const std::string& _requestBody, Sender _send
         response.id = request.id;
 
         const auto& method = request.method;
+        auto serializedIt = m_methodToSerializedFunc.find(method);
+        if (serializedIt != m_methodToSerializedFunc.end())
+        {
+            auto strResp = toSerializedResponsePrefix(response);
+            serializedIt->second(request.params, strResp);
+            strResp.append("}\n");
+            _sender(strResp);
+            return;
+        }
         auto it = m_methodToFunc.find(method);
         if (it == m_methodToFunc.end())
         {
@@ -494,30 +543,58 @@ void JsonRpcImpl_2_0::call(std::string const& _groupID, std::string const& _node
                         << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "call");
+    // only the calls routed by the rpc to the nodes with the highest block can hit the cache
+    auto blockNumber = m_groupManager->getBlockNumberByGroup(_groupID);
+    auto callResultCache = m_callResultCache;
+    bool useCache = _nodeName.empty() && blockNumber >= 0 && callResultCache->enabled() &&
+                    callResultCache->cacheable(_to);
+    bcos::crypto::HashType dataHash;
+    if (useCache)
+    {
+        dataHash = nodeService->blockFactory()->cryptoSuite()->hash(
+            bcos::bytesConstRef((bcos::byte const*)_data.data(), _data.size()));
+        Json::Value jResp;
+        if (callResultCache->get(_groupID, _to, dataHash, blockNumber, jResp))
+        {
+            RPC_IMPL_LOG(TRACE) << LOG_DESC("call: hit the cache") << LOG_KV("to", _to)
+                                << LOG_KV("group", _groupID) << LOG_KV("block", blockNumber);
+            _respFunc(nullptr, jResp);
+            return;
+        }
+    }
     auto transactionFactory = nodeService->blockFactory()->transactionFactory();
     auto transaction =
         transactionFactory->createTransaction(0, _to, *decodeData(_data), u256(0), 0, "", "", 0);
 
-    nodeService->scheduler()->call(
-        transaction, [_to, _respFunc](Error::Ptr&& _error,
-                         protocol::TransactionReceipt::Ptr&& _transactionReceiptPtr) {
-            Json::Value jResp;
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                jResp["blockNumber"] = _transactionReceiptPtr->blockNumber();
-                jResp["status"] = _transactionReceiptPtr->status();
-                jResp["output"] = toHexStringWithPrefix(_transactionReceiptPtr->output());
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("call") << LOG_KV("to", _to)
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
+    auto sender = [_groupID, _to, transaction, useCache, callResultCache, dataHash, blockNumber](
+                      NodeService::Ptr _nodeService, RespFunc _respFunc) {
+        _nodeService->scheduler()->call(transaction,
+            [_groupID, _to, _respFunc, useCache, callResultCache, dataHash, blockNumber](
+                Error::Ptr&& _error, protocol::TransactionReceipt::Ptr&& _transactionReceiptPtr) {
+                Json::Value jResp;
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
+                {
+                    jResp["blockNumber"] = _transactionReceiptPtr->blockNumber();
+                    jResp["status"] = _transactionReceiptPtr->status();
+                    jResp["output"] = toHexStringWithPrefix(_transactionReceiptPtr->output());
+                    // the call has been executed on the state of the highest block
+                    if (useCache && _transactionReceiptPtr->blockNumber() == blockNumber)
+                    {
+                        callResultCache->insert(_groupID, _to, dataHash, blockNumber, jResp);
+                    }
+                }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("call") << LOG_KV("to", _to)
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+                }
 
-            _respFunc(_error, jResp);
-        });
+                _respFunc(_error, jResp);
+            });
+    };
+    sendRequest("call", _groupID, _nodeName.empty(), nodeService, sender, _respFunc);
 }
 
 void JsonRpcImpl_2_0::sendTransaction(std::string const& _groupID, std::string const& _nodeName,
@@ -533,9 +610,10 @@ void JsonRpcImpl_2_0::sendTransaction(std::string const& _groupID, std::string c
     auto txHash = tx->hash();  // FIXME: try pass tx to backend?
     RPC_IMPL_LOG(TRACE) << LOG_DESC("sendTransaction") << LOG_KV("group", _groupID)
                         << LOG_KV("node", _nodeName) << LOG_KV("hash", txHash.abridged());
+    auto submitNode = std::weak_ptr<NodeService>(nodeService);
     auto submitCallback =
         [_groupID, _requireProof, tx, transactionDataPtr, respFunc = std::move(_respFunc), txHash,
-            self](Error::Ptr _error,
+            self, submitNode](Error::Ptr _error,
             bcos::protocol::TransactionSubmitResult::Ptr _transactionSubmitResult) {
             auto rpc = self.lock();
             if (!rpc)
@@ -576,6 +654,15 @@ void JsonRpcImpl_2_0::sendTransaction(std::string const& _groupID, std::string c
                     jResp["errorMessage"] = errorMsg.str();
                 }
                 toJsonResp(jResp, hexPreTxHash, _transactionSubmitResult->transactionReceipt());
+                // route the following reads of the transaction to the node that committed it
+                auto receipt = _transactionSubmitResult->transactionReceipt();
+                auto blockNumber = receipt->blockNumber();
+                rpc->m_writeSessionTracker->onTransactionCommitted(
+                    _groupID, txHash, submitNode.lock(), blockNumber);
+                if (!receipt->contractAddress().empty())
+                {
+                    rpc->m_codeCache->invalidate(_groupID, std::string(receipt->contractAddress()));
+                }
                 jResp["input"] = toHexStringWithPrefix(tx->input());
                 jResp["to"] = string(tx->to());
                 jResp["from"] = toHexStringWithPrefix(tx->sender());
@@ -625,14 +712,23 @@ void JsonRpcImpl_2_0::getTransaction(std::string const& _groupID, std::string co
                         << LOG_KV("requireProof", _requireProof) << LOG_KV("group", _groupID)
                         << LOG_KV("node", _nodeName);
 
-    bcos::crypto::HashListPtr hashListPtr = std::make_shared<bcos::crypto::HashList>();
-    hashListPtr->push_back(bcos::crypto::HashType(_txHash));
+    auto hash = bcos::crypto::HashType(_txHash);
+    routeTransactionRead(_groupID, _nodeName, hash, "getTransaction", _respFunc,
+        [this, _txHash, _requireProof, _respFunc](NodeService::Ptr _nodeService, bool) {
+            getTransactionFromNode(_nodeService, _txHash, _requireProof, _respFunc);
+        });
+}
 
-    auto nodeService = getNodeService(_groupID, _nodeName, "getTransaction");
-    auto ledger = nodeService->ledger();
+void JsonRpcImpl_2_0::getTransactionFromNode(NodeService::Ptr _nodeService,
+    std::string const& _txHash, bool _requireProof, RespFunc _respFunc)
+{
+    auto ledger = _nodeService->ledger();
     checkService(ledger, "ledger");
+    auto respFunc = trackRequest(_nodeService, _respFunc);
+    auto hashListPtr = std::make_shared<bcos::crypto::HashList>();
+    hashListPtr->push_back(bcos::crypto::HashType(_txHash));
     ledger->asyncGetBatchTxsByHashList(hashListPtr, _requireProof,
-        [_txHash, _requireProof, _respFunc](Error::Ptr _error,
+        [_txHash, _requireProof, respFunc](Error::Ptr _error,
             bcos::protocol::TransactionsPtr _transactionsPtr,
             std::shared_ptr<std::map<std::string, ledger::MerkleProofPtr>> _transactionProofsPtr) {
             Json::Value jResp;
@@ -666,7 +762,7 @@ void JsonRpcImpl_2_0::getTransaction(std::string const& _groupID, std::string co
                     << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
             }
 
-            _respFunc(_error, jResp);
+            respFunc(_error, jResp);
         });
 }
 
@@ -680,62 +776,71 @@ void JsonRpcImpl_2_0::getTransactionReceipt(std::string const& _groupID,
 
     auto hash = bcos::crypto::HashType(_txHash);
 
-    auto nodeService = getNodeService(_groupID, _nodeName, "getTransactionReceipt");
-    auto ledger = nodeService->ledger();
-    checkService(ledger, "ledger");
     auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
-    ledger->asyncGetTransactionReceiptByHash(hash, _requireProof,
-        [_groupID, _nodeName, _txHash, hash, _requireProof, _respFunc, self](Error::Ptr _error,
-            protocol::TransactionReceipt::ConstPtr _transactionReceiptPtr,
-            ledger::MerkleProofPtr _merkleProofPtr) {
-            auto rpc = self.lock();
-            if (!rpc)
-            {
-                return;
-            }
-            Json::Value jResp;
-            if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getTransactionReceipt") << LOG_KV("txHash", _txHash)
-                    << LOG_KV("requireProof", _requireProof)
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-
-                _respFunc(_error, jResp);
-                return;
-            }
-
-            toJsonResp(jResp, hash.hexPrefixed(), _transactionReceiptPtr);
+    auto sender = [_txHash, hash, _requireProof, self](
+                      NodeService::Ptr _nodeService, RespFunc _respFunc) {
+        _nodeService->ledger()->asyncGetTransactionReceiptByHash(hash, _requireProof,
+            [_nodeService, _txHash, hash, _requireProof, _respFunc, self](
+                Error::Ptr _error, protocol::TransactionReceipt::ConstPtr _transactionReceiptPtr,
+                ledger::MerkleProofPtr _merkleProofPtr) {
+                auto rpc = self.lock();
+                if (!rpc)
+                {
+                    return;
+                }
+                Json::Value jResp;
+                if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getTransactionReceipt") << LOG_KV("txHash", _txHash)
+                        << LOG_KV("requireProof", _requireProof)
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+
+                    _respFunc(_error, jResp);
+                    return;
+                }
 
-            RPC_IMPL_LOG(TRACE) << LOG_DESC("getTransactionReceipt") << LOG_KV("txHash", _txHash)
-                                << LOG_KV("requireProof", _requireProof)
-                                << LOG_KV("merkleProofPtr", _merkleProofPtr);
+                toJsonResp(jResp, hash.hexPrefixed(), _transactionReceiptPtr);
 
-            if (_requireProof && _merkleProofPtr)
-            {
-                addProofToResponse(jResp, "receiptProof", _merkleProofPtr);
-            }
+                RPC_IMPL_LOG(TRACE)
+                    << LOG_DESC("getTransactionReceipt") << LOG_KV("txHash", _txHash)
+                    << LOG_KV("requireProof", _requireProof)
+                    << LOG_KV("merkleProofPtr", _merkleProofPtr);
 
-            // fetch transaction proof
-            rpc->getTransaction(_groupID, _nodeName, _txHash, _requireProof,
-                [jResp, _txHash, _respFunc](bcos::Error::Ptr _error, Json::Value& _jTx) {
-                    auto jRespCopy = jResp;
-                    if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-                    {
-                        RPC_IMPL_LOG(WARNING)
-                            << LOG_BADGE("getTransactionReceipt") << LOG_DESC("getTransaction")
-                            << LOG_KV("hexPreTxHash", _txHash)
-                            << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                            << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-                    }
-                    jRespCopy["input"] = _jTx["input"];
-                    jRespCopy["from"] = _jTx["from"];
-                    jRespCopy["to"] = _jTx["to"];
-                    jRespCopy["transactionProof"] = _jTx["transactionProof"];
+                if (_requireProof && _merkleProofPtr)
+                {
+                    addProofToResponse(jResp, "receiptProof", _merkleProofPtr);
+                }
 
-                    _respFunc(nullptr, jRespCopy);
-                });
+                // fetch the transaction from the node answered the receipt, which is the node
+                // winning the hedge or the node the read is pinned to
+                rpc->getTransactionFromNode(_nodeService, _txHash, _requireProof,
+                    [jResp, _txHash, _respFunc](bcos::Error::Ptr _error, Json::Value& _jTx) {
+                        auto jRespCopy = jResp;
+                        if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
+                        {
+                            RPC_IMPL_LOG(WARNING)
+                                << LOG_BADGE("getTransactionReceipt")
+                                << LOG_DESC("getTransaction") << LOG_KV("hexPreTxHash", _txHash)
+                                << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                                << LOG_KV("errorMessage",
+                                       _error ? _error->errorMessage() : "success");
+                        }
+                        jRespCopy["input"] = _jTx["input"];
+                        jRespCopy["from"] = _jTx["from"];
+                        jRespCopy["to"] = _jTx["to"];
+                        jRespCopy["transactionProof"] = _jTx["transactionProof"];
+
+                        _respFunc(nullptr, jRespCopy);
+                    });
+            });
+    };
+    routeTransactionRead(_groupID, _nodeName, hash, "getTransactionReceipt", _respFunc,
+        [this, _groupID, sender, _respFunc](NodeService::Ptr _nodeService, bool _hedgeable) {
+            checkService(_nodeService->ledger(), "ledger");
+            sendRequest(
+                "getTransactionReceipt", _groupID, _hedgeable, _nodeService, sender, _respFunc);
         });
 }
 
@@ -749,6 +854,7 @@ void JsonRpcImpl_2_0::getBlockByHash(std::string const& _groupID, std::string co
     auto nodeService = getNodeService(_groupID, _nodeName, "getBlockByHash");
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
+    _respFunc = trackRequest(nodeService, _respFunc);
     auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
     ledger->asyncGetBlockNumberByHash(bcos::crypto::HashType(_blockHash),
         [_groupID, _nodeName, _blockHash, _onlyHeader, _onlyTxHash, _respFunc, self](
@@ -784,34 +890,37 @@ void JsonRpcImpl_2_0::getBlockByNumber(std::string const& _groupID, std::string
                         << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getBlockByNumber");
-    auto ledger = nodeService->ledger();
-    checkService(ledger, "ledger");
-    ledger->asyncGetBlockDataByNumber(_blockNumber,
-        _onlyHeader ? bcos::ledger::HEADER : bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS,
-        [_blockNumber, _onlyHeader, _onlyTxHash, _respFunc](
-            Error::Ptr _error, protocol::Block::Ptr _block) {
-            Json::Value jResp;
-            if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getBlockByNumber") << LOG_KV("blockNumber", _blockNumber)
-                    << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
-            else
-            {
-                if (_onlyHeader)
+    checkService(nodeService->ledger(), "ledger");
+    auto sender = [_blockNumber, _onlyHeader, _onlyTxHash](
+                      NodeService::Ptr _nodeService, RespFunc _respFunc) {
+        _nodeService->ledger()->asyncGetBlockDataByNumber(_blockNumber,
+            _onlyHeader ? bcos::ledger::HEADER : bcos::ledger::HEADER | bcos::ledger::TRANSACTIONS,
+            [_blockNumber, _onlyHeader, _onlyTxHash, _respFunc](
+                Error::Ptr _error, protocol::Block::Ptr _block) {
+                Json::Value jResp;
+                if (_error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS)
                 {
-                    toJsonResp(jResp, _block ? _block->blockHeader() : nullptr);
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getBlockByNumber") << LOG_KV("blockNumber", _blockNumber)
+                        << LOG_KV("onlyHeader", _onlyHeader) << LOG_KV("onlyTxHash", _onlyTxHash)
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
                 }
                 else
                 {
-                    toJsonResp(jResp, _block, _onlyTxHash);
+                    if (_onlyHeader)
+                    {
+                        toJsonResp(jResp, _block ? _block->blockHeader() : nullptr);
+                    }
+                    else
+                    {
+                        toJsonResp(jResp, _block, _onlyTxHash);
+                    }
                 }
-            }
-            _respFunc(_error, jResp);
-        });
+                _respFunc(_error, jResp);
+            });
+    };
+    sendRequest("getBlockByNumber", _groupID, _nodeName.empty(), nodeService, sender, _respFunc);
 }
 
 void JsonRpcImpl_2_0::getBlockHashByNumber(std::string const& _groupID,
@@ -823,6 +932,7 @@ void JsonRpcImpl_2_0::getBlockHashByNumber(std::string const& _groupID,
     auto nodeService = getNodeService(_groupID, _nodeName, "getBlockHashByNumber");
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
+    _respFunc = trackRequest(nodeService, _respFunc);
     ledger->asyncGetBlockHashByNumber(
         _blockNumber, [_respFunc](Error::Ptr _error, crypto::HashType const& _hashValue) {
             if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
@@ -847,6 +957,7 @@ void JsonRpcImpl_2_0::getBlockNumber(
     auto nodeService = getNodeService(_groupID, _nodeName, "getBlockNumber");
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
+    _respFunc = trackRequest(nodeService, _respFunc);
     ledger->asyncGetBlockNumber([_respFunc](Error::Ptr _error, protocol::BlockNumber _blockNumber) {
         if (_error && (_error->errorCode() != bcos::protocol::CommonError::SUCCESS))
         {
@@ -869,31 +980,57 @@ void JsonRpcImpl_2_0::getCode(std::string const& _groupID, std::string const& _n
                         << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getCode");
-
-    auto scheduler = nodeService->scheduler();
-    scheduler->getCode(
-        std::string_view(_contractAddress), [_contractAddress, callback = std::move(_callback)](
-                                                Error::Ptr _error, bcos::bytes _codeData) {
-            std::string code;
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                if (!_codeData.empty())
+    // the code is cached only for the requests routed by the rpc
+    auto blockNumber = m_groupManager->getBlockNumberByGroup(_groupID);
+    auto codeCache = m_codeCache;
+    bool useCache = _nodeName.empty() && blockNumber >= 0 && codeCache->enabled();
+    if (useCache)
+    {
+        auto cachedCode = codeCache->get(_groupID, _contractAddress, blockNumber);
+        if (cachedCode)
+        {
+            RPC_IMPL_LOG(TRACE) << LOG_BADGE("getCode: hit the cache")
+                                << LOG_KV("contractAddress", _contractAddress)
+                                << LOG_KV("group", _groupID) << LOG_KV("block", blockNumber);
+            Json::Value jResp = *cachedCode;
+            _callback(nullptr, jResp);
+            return;
+        }
+    }
+    auto cryptoSuite = nodeService->blockFactory()->cryptoSuite();
+    auto sender = [_groupID, _contractAddress, useCache, codeCache, cryptoSuite, blockNumber](
+                      NodeService::Ptr _nodeService, RespFunc _respFunc) {
+        _nodeService->scheduler()->getCode(std::string_view(_contractAddress),
+            [_groupID, _contractAddress, useCache, codeCache, cryptoSuite, blockNumber,
+                callback = std::move(_respFunc)](Error::Ptr _error, bcos::bytes _codeData) {
+                std::string code;
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
                 {
-                    code = toHexStringWithPrefix(
-                        bcos::bytesConstRef(_codeData.data(), _codeData.size()));
+                    if (!_codeData.empty())
+                    {
+                        auto codeRef = bcos::bytesConstRef(_codeData.data(), _codeData.size());
+                        code = toHexStringWithPrefix(codeRef);
+                        if (useCache)
+                        {
+                            codeCache->insert(_groupID, _contractAddress, blockNumber,
+                                cryptoSuite->hash(codeRef), code);
+                        }
+                    }
+                }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getCode")
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success")
+                        << LOG_KV("contractAddress", _contractAddress);
                 }
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getCode") << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success")
-                    << LOG_KV("contractAddress", _contractAddress);
-            }
 
-            Json::Value jResp = code;
-            callback(_error, jResp);
-        });
+                Json::Value jResp = code;
+                callback(_error, jResp);
+            });
+    };
+    sendRequest("getCode", _groupID, _nodeName.empty(), nodeService, sender, _callback);
 }
 
 void JsonRpcImpl_2_0::getSealerList(
@@ -904,34 +1041,42 @@ void JsonRpcImpl_2_0::getSealerList(
 
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getSealerList");
+    if (responseWithLedgerSnapshot(_groupID, _nodeName, SNAPSHOT_SEALER_LIST, _respFunc))
+    {
+        return;
+    }
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
-    ledger->asyncGetNodeListByType(bcos::ledger::CONSENSUS_SEALER,
-        [_respFunc](Error::Ptr _error, consensus::ConsensusNodeListPtr _consensusNodeListPtr) {
-            Json::Value jResp = Json::Value(Json::arrayValue);
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                if (_consensusNodeListPtr)
+    _respFunc = trackRequest(nodeService, _respFunc);
+    auto query = [ledger](RespFunc _onQueried) {
+        ledger->asyncGetNodeListByType(bcos::ledger::CONSENSUS_SEALER,
+            [_onQueried](Error::Ptr _error, consensus::ConsensusNodeListPtr _consensusNodeListPtr) {
+                Json::Value jResp = Json::Value(Json::arrayValue);
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
                 {
-                    for (const auto& consensusNodePtr : *_consensusNodeListPtr)
+                    if (_consensusNodeListPtr)
                     {
-                        Json::Value node;
-                        node["nodeID"] = consensusNodePtr->nodeID()->hex();
-                        node["weight"] = consensusNodePtr->weight();
-                        jResp.append(node);
+                        for (const auto& consensusNodePtr : *_consensusNodeListPtr)
+                        {
+                            Json::Value node;
+                            node["nodeID"] = consensusNodePtr->nodeID()->hex();
+                            node["weight"] = consensusNodePtr->weight();
+                            jResp.append(node);
+                        }
                     }
                 }
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getSealerList")
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getSealerList")
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+                }
 
-            _respFunc(_error, jResp);
-        });
+                _onQueried(_error, jResp);
+            });
+    };
+    queryLedgerSnapshot(_groupID, _nodeName.empty(), SNAPSHOT_SEALER_LIST, query, _respFunc);
 }
 
 void JsonRpcImpl_2_0::getObserverList(
@@ -941,31 +1086,39 @@ void JsonRpcImpl_2_0::getObserverList(
                         << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getObserverList");
+    if (responseWithLedgerSnapshot(_groupID, _nodeName, SNAPSHOT_OBSERVER_LIST, _respFunc))
+    {
+        return;
+    }
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
-    ledger->asyncGetNodeListByType(bcos::ledger::CONSENSUS_OBSERVER,
-        [_respFunc](Error::Ptr _error, consensus::ConsensusNodeListPtr _consensusNodeListPtr) {
-            Json::Value jResp = Json::Value(Json::arrayValue);
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                if (_consensusNodeListPtr)
+    _respFunc = trackRequest(nodeService, _respFunc);
+    auto query = [ledger](RespFunc _onQueried) {
+        ledger->asyncGetNodeListByType(bcos::ledger::CONSENSUS_OBSERVER,
+            [_onQueried](Error::Ptr _error, consensus::ConsensusNodeListPtr _consensusNodeListPtr) {
+                Json::Value jResp = Json::Value(Json::arrayValue);
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
                 {
-                    for (const auto& consensusNodePtr : *_consensusNodeListPtr)
+                    if (_consensusNodeListPtr)
                     {
-                        jResp.append(consensusNodePtr->nodeID()->hex());
+                        for (const auto& consensusNodePtr : *_consensusNodeListPtr)
+                        {
+                            jResp.append(consensusNodePtr->nodeID()->hex());
+                        }
                     }
                 }
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getObserverList")
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getObserverList")
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+                }
 
-            _respFunc(_error, jResp);
-        });
+                _onQueried(_error, jResp);
+            });
+    };
+    queryLedgerSnapshot(_groupID, _nodeName.empty(), SNAPSHOT_OBSERVER_LIST, query, _respFunc);
 }
 
 void JsonRpcImpl_2_0::getPbftView(
@@ -977,6 +1130,7 @@ void JsonRpcImpl_2_0::getPbftView(
     auto nodeService = getNodeService(_groupID, _nodeName, "getPbftView");
     auto consensus = nodeService->consensus();
     checkService(consensus, "consensus");
+    _respFunc = trackRequest(nodeService, _respFunc);
     consensus->asyncGetPBFTView(
         [_respFunc](Error::Ptr _error, bcos::consensus::ViewType _viewValue) {
             Json::Value jResp;
@@ -1005,6 +1159,7 @@ void JsonRpcImpl_2_0::getPendingTxSize(
     auto nodeService = getNodeService(_groupID, _nodeName, "getPendingTxSize");
     auto txpool = nodeService->txpool();
     checkService(txpool, "txpool");
+    _respFunc = trackRequest(nodeService, _respFunc);
     txpool->asyncGetPendingTransactionSize([_respFunc](Error::Ptr _error, size_t _pendingTxSize) {
         Json::Value jResp;
         if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
@@ -1032,6 +1187,7 @@ void JsonRpcImpl_2_0::getSyncStatus(
     auto nodeService = getNodeService(_groupID, _nodeName, "getSyncStatus");
     auto sync = nodeService->sync();
     checkService(sync, "sync");
+    _respFunc = trackRequest(nodeService, _respFunc);
     sync->asyncGetSyncInfo([_respFunc](Error::Ptr _error, std::string _syncStatus) {
         Json::Value jResp;
         if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
@@ -1058,6 +1214,7 @@ void JsonRpcImpl_2_0::getConsensusStatus(
     auto nodeService = getNodeService(_groupID, _nodeName, "getConsensusStatus");
     auto consensus = nodeService->consensus();
     checkService(consensus, "consensus");
+    _respFunc = trackRequest(nodeService, _respFunc);
     consensus->asyncGetConsensusStatus(
         [_respFunc](Error::Ptr _error, std::string _consensusStatus) {
             Json::Value jResp;
@@ -1083,26 +1240,36 @@ void JsonRpcImpl_2_0::getSystemConfigByKey(std::string const& _groupID,
                         << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getSystemConfigByKey");
+    auto snapshotItem = SNAPSHOT_SYSTEM_CONFIG_PREFIX + _keyValue;
+    if (responseWithLedgerSnapshot(_groupID, _nodeName, snapshotItem, _respFunc))
+    {
+        return;
+    }
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
-    ledger->asyncGetSystemConfigByKey(_keyValue,
-        [_respFunc](Error::Ptr _error, std::string _value, protocol::BlockNumber _blockNumber) {
-            Json::Value jResp;
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                jResp["blockNumber"] = _blockNumber;
-                jResp["value"] = _value;
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("asyncGetSystemConfigByKey")
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
+    _respFunc = trackRequest(nodeService, _respFunc);
+    auto query = [ledger, _keyValue](RespFunc _onQueried) {
+        ledger->asyncGetSystemConfigByKey(_keyValue,
+            [_onQueried](
+                Error::Ptr _error, std::string _value, protocol::BlockNumber _blockNumber) {
+                Json::Value jResp;
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
+                {
+                    jResp["blockNumber"] = _blockNumber;
+                    jResp["value"] = _value;
+                }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("asyncGetSystemConfigByKey")
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+                }
 
-            _respFunc(_error, jResp);
-        });
+                _onQueried(_error, jResp);
+            });
+    };
+    queryLedgerSnapshot(_groupID, _nodeName.empty(), snapshotItem, query, _respFunc);
 }
 
 void JsonRpcImpl_2_0::getTotalTransactionCount(
@@ -1112,28 +1279,36 @@ void JsonRpcImpl_2_0::getTotalTransactionCount(
                         << LOG_KV("node", _nodeName);
 
     auto nodeService = getNodeService(_groupID, _nodeName, "getTotalTransactionCount");
+    if (responseWithLedgerSnapshot(_groupID, _nodeName, SNAPSHOT_TOTAL_TX_COUNT, _respFunc))
+    {
+        return;
+    }
     auto ledger = nodeService->ledger();
     checkService(ledger, "ledger");
-    ledger->asyncGetTotalTransactionCount(
-        [_respFunc](Error::Ptr _error, int64_t _totalTxCount, int64_t _failedTxCount,
-            protocol::BlockNumber _latestBlockNumber) {
-            Json::Value jResp;
-            if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
-            {
-                jResp["blockNumber"] = _latestBlockNumber;
-                jResp["transactionCount"] = _totalTxCount;
-                jResp["failedTransactionCount"] = _failedTxCount;
-            }
-            else
-            {
-                RPC_IMPL_LOG(ERROR)
-                    << LOG_BADGE("getTotalTransactionCount")
-                    << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
-                    << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
-            }
+    _respFunc = trackRequest(nodeService, _respFunc);
+    auto query = [ledger](RespFunc _onQueried) {
+        ledger->asyncGetTotalTransactionCount(
+            [_onQueried](Error::Ptr _error, int64_t _totalTxCount, int64_t _failedTxCount,
+                protocol::BlockNumber _latestBlockNumber) {
+                Json::Value jResp;
+                if (!_error || (_error->errorCode() == bcos::protocol::CommonError::SUCCESS))
+                {
+                    jResp["blockNumber"] = _latestBlockNumber;
+                    jResp["transactionCount"] = _totalTxCount;
+                    jResp["failedTransactionCount"] = _failedTxCount;
+                }
+                else
+                {
+                    RPC_IMPL_LOG(ERROR)
+                        << LOG_BADGE("getTotalTransactionCount")
+                        << LOG_KV("errorCode", _error ? _error->errorCode() : 0)
+                        << LOG_KV("errorMessage", _error ? _error->errorMessage() : "success");
+                }
 
-            _respFunc(_error, jResp);
-        });
+                _onQueried(_error, jResp);
+            });
+    };
+    queryLedgerSnapshot(_groupID, _nodeName.empty(), SNAPSHOT_TOTAL_TX_COUNT, query, _respFunc);
 }
 void JsonRpcImpl_2_0::getPeers(RespFunc _respFunc)
 {
@@ -1158,6 +1333,142 @@ void JsonRpcImpl_2_0::getPeers(RespFunc _respFunc)
         });
 }
 
+bool JsonRpcImpl_2_0::responseWithLedgerSnapshot(std::string const& _groupID,
+    std::string const& _nodeName, std::string const& _item, RespFunc const& _respFunc)
+{
+    // the request to the specified node should be responsed by the node
+    if (!_nodeName.empty())
+    {
+        return false;
+    }
+    auto blockNumber = m_groupManager->getBlockNumberByGroup(_groupID);
+    if (blockNumber < 0)
+    {
+        return false;
+    }
+    Json::Value jResp;
+    if (!m_ledgerSnapshotCache->get(_groupID, blockNumber, _item, jResp))
+    {
+        return false;
+    }
+    RPC_IMPL_LOG(TRACE) << LOG_DESC("responseWithLedgerSnapshot") << LOG_KV("item", _item)
+                        << LOG_KV("group", _groupID) << LOG_KV("block", blockNumber);
+    _respFunc(nullptr, jResp);
+    return true;
+}
+
+void JsonRpcImpl_2_0::queryLedgerSnapshot(std::string const& _groupID, bool _cacheable,
+    std::string const& _item, std::function<void(RespFunc)> _query, RespFunc _respFunc)
+{
+    if (!_cacheable)
+    {
+        _query(_respFunc);
+        return;
+    }
+    // the concurrent misses of the item share one query keyed on the notified block number
+    m_ledgerSnapshotCache->query(_groupID, _item, _query, _respFunc);
+}
+
+void JsonRpcImpl_2_0::sendRequest(std::string const& _method, std::string const& _groupID,
+    bool _hedgeable, NodeService::Ptr _nodeService, RequestSender _sender, RespFunc _respFunc)
+{
+    auto trackedSender = [_sender](NodeService::Ptr _nodeService, RespFunc _respFunc) {
+        _sender(_nodeService, trackRequest(_nodeService, _respFunc));
+    };
+    // the request to the specified node should not be hedged
+    if (!_hedgeable || !m_requestHedger->enabled())
+    {
+        trackedSender(_nodeService, _respFunc);
+        return;
+    }
+    m_requestHedger->execute(_method, _groupID, _nodeService, trackedSender, _respFunc);
+}
+
+void JsonRpcImpl_2_0::routeTransactionRead(std::string const& _groupID,
+    std::string const& _nodeName, bcos::crypto::HashType const& _txHash,
+    std::string const& _command, RespFunc _respFunc,
+    std::function<void(NodeService::Ptr, bool)> _onRouted)
+{
+    if (!_nodeName.empty() || !m_writeSessionTracker->enabled())
+    {
+        _onRouted(getNodeService(_groupID, _nodeName, _command), _nodeName.empty());
+        return;
+    }
+    auto self = std::weak_ptr<JsonRpcImpl_2_0>(shared_from_this());
+    m_writeSessionTracker->route(_groupID, _txHash,
+        [self, _groupID, _command, _respFunc, _onRouted](NodeService::Ptr _nodeService) {
+            auto rpc = self.lock();
+            if (!rpc)
+            {
+                return;
+            }
+            // the route may be called back by the timer, so the exceptions are responded here
+            try
+            {
+                // the read pinned to the node that committed the transaction is not hedged
+                auto hedgeable = (_nodeService == nullptr);
+                if (!_nodeService)
+                {
+                    _nodeService = rpc->getNodeService(_groupID, "", _command);
+                }
+                _onRouted(_nodeService, hedgeable);
+            }
+            catch (JsonRpcException const& e)
+            {
+                Json::Value jResp;
+                _respFunc(std::make_shared<Error>(e.code(), e.msg()), jResp);
+            }
+        });
+}
+
+namespace
+{
+// the outstanding request is released once: by the response, or when the response function is
+// destroyed without being called, e.g. the request throws before it is sent
+class TrackedRequest
+{
+public:
+    explicit TrackedRequest(NodeService::Ptr _nodeService)
+      : m_nodeService(_nodeService), m_startTime(std::chrono::steady_clock::now())
+    {
+        m_nodeService->onRequestStart();
+    }
+    ~TrackedRequest()
+    {
+        if (!m_finished.exchange(true))
+        {
+            m_nodeService->onRequestCancel();
+        }
+    }
+
+    void finish(Error::Ptr const& _error)
+    {
+        if (m_finished.exchange(true))
+        {
+            return;
+        }
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_startTime)
+                           .count();
+        m_nodeService->onRequestFinish(latency, CircuitBreaker::isNodeFailure(_error));
+    }
+
+private:
+    NodeService::Ptr m_nodeService;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::atomic_bool m_finished = {false};
+};
+}  // namespace
+
+RespFunc JsonRpcImpl_2_0::trackRequest(NodeService::Ptr _nodeService, RespFunc _respFunc)
+{
+    auto trackedRequest = std::make_shared<TrackedRequest>(_nodeService);
+    return [trackedRequest, _respFunc](Error::Ptr _error, Json::Value& _result) {
+        trackedRequest->finish(_error);
+        _respFunc(_error, _result);
+    };
+}
+
 NodeService::Ptr JsonRpcImpl_2_0::getNodeService(
     std::string const& _groupID, std::string const& _nodeName, std::string const& _command)
 {
@@ -1189,15 +1500,16 @@ void JsonRpcImpl_2_0::getGroupList(RespFunc _respFunc)
     _respFunc(nullptr, response);
 }
 
-// get the group information of the given group
+// get the group information of the given group, the json-rpc requests are answered by
+// getSerializedGroupInfo instead, this copies the cached json for the callers of the interface
 void JsonRpcImpl_2_0::getGroupInfo(std::string const& _groupID, RespFunc _respFunc)
 {
-    auto groupInfo = m_groupManager->getGroupInfo(_groupID);
+    auto groupInfo = m_groupInfoCache->groupInfo(_groupID);
     Json::Value response;
     if (groupInfo)
     {
         // can only recover the deleted group
-        groupInfoToJson(response, groupInfo);
+        response = groupInfo->json;
     }
     _respFunc(nullptr, response);
 }
@@ -1205,9 +1517,111 @@ void JsonRpcImpl_2_0::getGroupInfo(std::string const& _groupID, RespFunc _respFu
 // get all the group info list
 void JsonRpcImpl_2_0::getGroupInfoList(RespFunc _respFunc)
 {
-    auto groupInfoList = m_groupManager->groupInfoList();
     Json::Value response(Json::arrayValue);
-    groupInfoListToJson(response, groupInfoList);
+    auto groupIDs = m_groupManager->sortedGroupIDs();
+    for (auto const& groupID : *groupIDs)
+    {
+        auto groupInfo = m_groupInfoCache->groupInfo(groupID);
+        if (groupInfo)
+        {
+            response.append(groupInfo->json);
+        }
+    }
+    _respFunc(nullptr, response);
+}
+
+void JsonRpcImpl_2_0::getSerializedGroupInfo(Json::Value const& _req, std::string& _response)
+{
+    auto groupInfo = m_groupInfoCache->groupInfo(_req[0u].asString());
+    if (!groupInfo)
+    {
+        _response.append("null");
+        return;
+    }
+    GroupInfoCache::appendSerialized(_response, *groupInfo->data);
+}
+
+void JsonRpcImpl_2_0::getSerializedGroupInfoList(Json::Value const&, std::string& _response)
+{
+    GroupInfoCache::appendSerialized(_response, *(m_groupInfoCache->groupInfoList()->data));
+}
+
+// params: [offset, limit, prefix], the prefix can be omitted
+void JsonRpcImpl_2_0::getSerializedGroupInfoListByPage(
+    Json::Value const& _req, std::string& _response)
+{
+    auto offset = _req[0u].asInt64();
+    auto limit = _req[1u].asInt64();
+    checkGroupPage(offset, limit);
+    size_t total = 0;
+    auto groupList = m_groupManager->queryGroupList(
+        _req.size() > 2 ? _req[2u].asString() : "", offset, limit, false, total);
+    _response.append("{\"groupInfoList\":[");
+    bool first = true;
+    for (auto const& it : groupList)
+    {
+        auto groupInfo = m_groupInfoCache->groupInfo(it);
+        if (!groupInfo)
+        {
+            continue;
+        }
+        if (!first)
+        {
+            _response.append(",");
+        }
+        first = false;
+        GroupInfoCache::appendSerialized(_response, *groupInfo->data);
+    }
+    _response.append("],\"total\":" + std::to_string(total) + "}");
+}
+
+void JsonRpcImpl_2_0::checkGroupPage(int64_t _offset, int64_t _limit)
+{
+    if (_offset < 0 || _limit <= 0 || _limit > (int64_t)GroupManager::c_maxGroupPageSize)
+    {
+        std::stringstream errorMsg;
+        errorMsg << LOG_DESC("invalid group page") << LOG_KV("offset", _offset)
+                 << LOG_KV("limit", _limit)
+                 << LOG_KV("maxLimit", GroupManager::c_maxGroupPageSize);
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidParams, errorMsg.str()));
+    }
+}
+
+// get the started groups with the prefix in the page
+void JsonRpcImpl_2_0::getGroupListByPage(
+    std::string const& _prefix, int64_t _offset, int64_t _limit, RespFunc _respFunc)
+{
+    checkGroupPage(_offset, _limit);
+    size_t total = 0;
+    auto groupList = m_groupManager->queryGroupList(_prefix, _offset, _limit, true, total);
+    auto response = generateResponse(nullptr);
+    response["total"] = (Json::UInt64)total;
+    response["groupList"] = Json::Value(Json::arrayValue);
+    for (auto const& it : groupList)
+    {
+        response["groupList"].append(it);
+    }
+    _respFunc(nullptr, response);
+}
+
+// get the group info of the groups with the prefix in the page
+void JsonRpcImpl_2_0::getGroupInfoListByPage(
+    std::string const& _prefix, int64_t _offset, int64_t _limit, RespFunc _respFunc)
+{
+    checkGroupPage(_offset, _limit);
+    size_t total = 0;
+    auto groupList = m_groupManager->queryGroupList(_prefix, _offset, _limit, false, total);
+    Json::Value response;
+    response["total"] = (Json::UInt64)total;
+    response["groupInfoList"] = Json::Value(Json::arrayValue);
+    for (auto const& it : groupList)
+    {
+        auto groupInfo = m_groupInfoCache->groupInfo(it);
+        if (groupInfo)
+        {
+            response["groupInfoList"].append(groupInfo->json);
+        }
+    }
     _respFunc(nullptr, response);
 }
 
@@ -1224,6 +1638,90 @@ void JsonRpcImpl_2_0::getGroupNodeInfo(
     }
     _respFunc(nullptr, response);
 }
+
+void JsonRpcImpl_2_0::getLogs(std::string const& _groupID, int64_t _fromBlock, int64_t _toBlock,
+    Json::Value const& _addresses, Json::Value const& _topics, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("getLogs") << LOG_KV("group", _groupID)
+                        << LOG_KV("fromBlock", _fromBlock) << LOG_KV("toBlock", _toBlock);
+
+    // check the group
+    getNodeService(_groupID, "", "getLogs");
+    if (_fromBlock >= 0 && _toBlock >= 0 && _fromBlock > _toBlock)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidParams,
+            "invalid block range: fromBlock is larger than toBlock"));
+    }
+
+    // parse the params in the same way with the event subscription
+    Json::Value jParams;
+    jParams["fromBlock"] = _fromBlock;
+    jParams["toBlock"] = _toBlock;
+    jParams["addresses"] = _addresses.isString() ? Json::Value(Json::arrayValue) : _addresses;
+    if (_addresses.isString())
+    {
+        jParams["addresses"].append(_addresses);
+    }
+    jParams["topics"] = _topics;
+    auto params = std::make_shared<bcos::event::EventSubParams>();
+    bcos::event::EventSubRequest::paramsFromJson(jParams, params);
+
+    m_logQuery->query(_groupID, params, _respFunc);
+}
+
+void JsonRpcImpl_2_0::newFilter(
+    std::string const& _groupID, Json::Value const& _params, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("newFilter") << LOG_KV("group", _groupID);
+
+    // check the group
+    getNodeService(_groupID, "", "newFilter");
+    auto params = std::make_shared<bcos::event::EventSubParams>();
+    bcos::event::EventSubRequest::paramsFromJson(_params, params);
+    if (params->fromBlock() >= 0 && params->toBlock() >= 0 &&
+        params->fromBlock() > params->toBlock())
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(JsonRpcError::InvalidParams,
+            "invalid block range: fromBlock is larger than toBlock"));
+    }
+    auto filterID = m_filterManager->newFilter(_groupID, params);
+    if (filterID.empty())
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(JsonRpcError::OperationNotAllowed, "exceed the max filter count"));
+    }
+    Json::Value jResp = filterID;
+    _respFunc(nullptr, jResp);
+}
+
+void JsonRpcImpl_2_0::newBlockFilter(std::string const& _groupID, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("newBlockFilter") << LOG_KV("group", _groupID);
+
+    // check the group
+    getNodeService(_groupID, "", "newBlockFilter");
+    auto filterID = m_filterManager->newBlockFilter(_groupID);
+    if (filterID.empty())
+    {
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(JsonRpcError::OperationNotAllowed, "exceed the max filter count"));
+    }
+    Json::Value jResp = filterID;
+    _respFunc(nullptr, jResp);
+}
+
+void JsonRpcImpl_2_0::getFilterChanges(std::string const& _filterID, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("getFilterChanges") << LOG_KV("filter", _filterID);
+    m_filterManager->getFilterChanges(_filterID, _respFunc);
+}
+
+void JsonRpcImpl_2_0::uninstallFilter(std::string const& _filterID, RespFunc _respFunc)
+{
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("uninstallFilter") << LOG_KV("filter", _filterID);
+    Json::Value jResp = m_filterManager->uninstallFilter(_filterID);
+    _respFunc(nullptr, jResp);
+}
 void JsonRpcImpl_2_0::gatewayInfoToJson(
     Json::Value& _response, bcos::gateway::GatewayInfo::Ptr _gatewayInfo)
 {
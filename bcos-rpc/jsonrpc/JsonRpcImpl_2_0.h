@@ -21,6 +21,15 @@
 
 #pragma once
 #include "groupmgr/GroupManager.h"
+#include <bcos-rpc/event/EventFilterManager.h>
+#include <bcos-rpc/event/EventLogQuery.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <bcos-rpc/jsonrpc/CallResultCache.h>
+#include <bcos-rpc/jsonrpc/CodeCache.h>
+#include <bcos-rpc/jsonrpc/GroupInfoCache.h>
+#include <bcos-rpc/jsonrpc/LedgerSnapshotCache.h>
+#include <bcos-rpc/jsonrpc/RequestHedger.h>
+#include <bcos-rpc/jsonrpc/WriteSessionTracker.h>
 #include <bcos-framework/interfaces/gateway/GatewayInterface.h>
 #include <bcos-rpc/jsonrpc/JsonRpcInterface.h>
 #include <json/json.h>
@@ -39,9 +48,30 @@ public:
     using Ptr = std::shared_ptr<JsonRpcImpl_2_0>;
     JsonRpcImpl_2_0(
         GroupManager::Ptr _groupManager, bcos::gateway::GatewayInterface::Ptr _gatewayInterface)
-      : m_groupManager(_groupManager), m_gatewayInterface(_gatewayInterface)
+      : m_groupManager(_groupManager),
+        m_gatewayInterface(_gatewayInterface),
+        m_callResultCache(std::make_shared<CallResultCache>()),
+        m_ledgerSnapshotCache(std::make_shared<LedgerSnapshotCache>()),
+        m_codeCache(std::make_shared<CodeCache>()),
+        m_requestHedger(std::make_shared<RequestHedger>(_groupManager)),
+        m_writeSessionTracker(std::make_shared<WriteSessionTracker>(_groupManager)),
+        m_logQuery(std::make_shared<bcos::event::EventLogQuery>(
+            _groupManager, std::make_shared<bcos::event::EventSubMatcher>())),
+        m_filterManager(
+            std::make_shared<bcos::event::EventFilterManager>(_groupManager, m_logQuery)),
+        m_groupInfoCache(std::make_shared<GroupInfoCache>(_groupManager))
     {
         initMethod();
+        auto callResultCache = m_callResultCache;
+        auto ledgerSnapshotCache = m_ledgerSnapshotCache;
+        auto writeSessionTracker = m_writeSessionTracker;
+        m_groupManager->registerBlockNumberNotifier(
+            [callResultCache, ledgerSnapshotCache, writeSessionTracker](
+                std::string const& _groupID, bcos::protocol::BlockNumber _number) {
+                callResultCache->onBlockNumberUpdated(_groupID, _number);
+                ledgerSnapshotCache->onBlockNumberUpdated(_groupID, _number);
+                writeSessionTracker->onBlockNumberUpdated(_groupID, _number);
+            });
     }
     ~JsonRpcImpl_2_0() {}
 
@@ -55,6 +85,8 @@ public:
     static void parseRpcResponseJson(const std::string& _responseBody, JsonResponse& _jsonResponse);
     static Json::Value toJsonResponse(const JsonResponse& _jsonResponse);
     static std::string toStringResponse(const JsonResponse& _jsonResponse);
+    // the response without the result and the closing brace, followed by the serialized result
+    static std::string toSerializedResponsePrefix(const JsonResponse& _jsonResponse);
     static void toJsonResp(
         Json::Value& jResp, bcos::protocol::Transaction::ConstPtr _transactionPtr);
 
@@ -129,10 +161,23 @@ public:
     void getGroupInfo(std::string const& _groupID, RespFunc _respFunc) override;
     // get all the group info list
     void getGroupInfoList(RespFunc _respFunc) override;
+    void getGroupListByPage(std::string const& _prefix, int64_t _offset, int64_t _limit,
+        RespFunc _respFunc) override;
+    void getGroupInfoListByPage(std::string const& _prefix, int64_t _offset, int64_t _limit,
+        RespFunc _respFunc) override;
     // get the information of a given node
     void getGroupNodeInfo(
         std::string const& _groupID, std::string const& _nodeName, RespFunc _respFunc) override;
 
+    void getLogs(std::string const& _groupID, int64_t _fromBlock, int64_t _toBlock,
+        Json::Value const& _addresses, Json::Value const& _topics, RespFunc _respFunc) override;
+
+    void newFilter(
+        std::string const& _groupID, Json::Value const& _params, RespFunc _respFunc) override;
+    void newBlockFilter(std::string const& _groupID, RespFunc _respFunc) override;
+    void getFilterChanges(std::string const& _filterID, RespFunc _respFunc) override;
+    void uninstallFilter(std::string const& _filterID, RespFunc _respFunc) override;
+
 public:
     void callI(const Json::Value& req, RespFunc _respFunc)
     {
@@ -263,12 +308,50 @@ public:
         (void)_req;
         getGroupInfoList(_respFunc);
     }
+    // params: [offset, limit, prefix], the prefix can be omitted
+    void getGroupListByPageI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        getGroupListByPage(_req.size() > 2 ? _req[2u].asString() : "", _req[0u].asInt64(),
+            _req[1u].asInt64(), _respFunc);
+    }
+    void getGroupInfoListByPageI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        getGroupInfoListByPage(_req.size() > 2 ? _req[2u].asString() : "", _req[0u].asInt64(),
+            _req[1u].asInt64(), _respFunc);
+    }
     // get the information of a given node
     void getGroupNodeInfoI(const Json::Value& _req, RespFunc _respFunc)
     {
         getGroupNodeInfo(_req[0u].asString(), _req[1u].asString(), _respFunc);
     }
 
+    void getLogsI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        // the omitted fromBlock and toBlock means the highest block
+        getLogs(_req[0u].asString(), _req.size() > 1 ? _req[1u].asInt64() : -1,
+            _req.size() > 2 ? _req[2u].asInt64() : -1, _req[3u], _req[4u], _respFunc);
+    }
+
+    void newFilterI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        newFilter(_req[0u].asString(), _req[1u], _respFunc);
+    }
+
+    void newBlockFilterI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        newBlockFilter(_req[0u].asString(), _respFunc);
+    }
+
+    void getFilterChangesI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        getFilterChanges(_req[0u].asString(), _respFunc);
+    }
+
+    void uninstallFilterI(const Json::Value& _req, RespFunc _respFunc)
+    {
+        uninstallFilter(_req[0u].asString(), _respFunc);
+    }
+
 public:
     const std::unordered_map<std::string, std::function<void(Json::Value, RespFunc _respFunc)>>&
     methodToFunc() const
@@ -280,15 +363,46 @@ public:
         const std::string& _method, std::function<void(Json::Value, RespFunc _respFunc)> _callback)
     {
         m_methodToFunc[_method] = _callback;
+        m_methodToSerializedFunc.erase(_method);
     }
     void setNodeInfo(const NodeInfo& _nodeInfo) { m_nodeInfo = _nodeInfo; }
     NodeInfo nodeInfo() const { return m_nodeInfo; }
     GroupManager::Ptr groupManager() { return m_groupManager; }
+    CallResultCache::Ptr callResultCache() const { return m_callResultCache; }
+    LedgerSnapshotCache::Ptr ledgerSnapshotCache() const { return m_ledgerSnapshotCache; }
+    CodeCache::Ptr codeCache() const { return m_codeCache; }
+    RequestHedger::Ptr requestHedger() const { return m_requestHedger; }
+    WriteSessionTracker::Ptr writeSessionTracker() const { return m_writeSessionTracker; }
+    bcos::event::EventLogQuery::Ptr logQuery() const { return m_logQuery; }
+    bcos::event::EventFilterManager::Ptr filterManager() const { return m_filterManager; }
+    GroupInfoCache::Ptr groupInfoCache() const { return m_groupInfoCache; }
 
 private:
     // TODO: check perf influence
     NodeService::Ptr getNodeService(
         std::string const& _groupID, std::string const& _nodeName, std::string const& _command);
+    // record the outstanding request and its latency to the node for the node selection
+    static RespFunc trackRequest(NodeService::Ptr _nodeService, RespFunc _respFunc);
+    // get the transaction from the given node
+    void getTransactionFromNode(NodeService::Ptr _nodeService, std::string const& _txHash,
+        bool _requireProof, RespFunc _respFunc);
+    // send the idempotent read request, which may be hedged to another node
+    void sendRequest(std::string const& _method, std::string const& _groupID, bool _hedgeable,
+        NodeService::Ptr _nodeService, RequestSender _sender, RespFunc _respFunc);
+    // get the node to read the transaction, _onRouted is called with the node and whether the
+    // request can be hedged, the exceptions after the asynchronous routing are responded directly
+    void routeTransactionRead(std::string const& _groupID, std::string const& _nodeName,
+        bcos::crypto::HashType const& _txHash, std::string const& _command, RespFunc _respFunc,
+        std::function<void(NodeService::Ptr, bool)> _onRouted);
+    // throw InvalidParams if the page of the group list is invalid
+    static void checkGroupPage(int64_t _offset, int64_t _limit);
+    // response with the ledger snapshot of the highest block if the request is routed by the rpc
+    bool responseWithLedgerSnapshot(std::string const& _groupID, std::string const& _nodeName,
+        std::string const& _item, RespFunc const& _respFunc);
+    // query the item by _query, the query is shared by the concurrent requests and cached under
+    // the notified block number of the group if _cacheable
+    void queryLedgerSnapshot(std::string const& _groupID, bool _cacheable,
+        std::string const& _item, std::function<void(RespFunc)> _query, RespFunc _respFunc);
     template <typename T>
     void checkService(T _service, std::string _serviceName)
     {
@@ -306,9 +420,19 @@ private:
         bcos::gateway::GatewayInfo::Ptr _localP2pInfo, bcos::gateway::GatewayInfosPtr _peersInfo);
     void getGroupPeers(std::string const& _groupID, RespFunc _respFunc) override;
 
+    // append the cached serialized group info to the response without parsing or copying the json
+    void getSerializedGroupInfo(Json::Value const& _req, std::string& _response);
+    void getSerializedGroupInfoList(Json::Value const& _req, std::string& _response);
+    void getSerializedGroupInfoListByPage(Json::Value const& _req, std::string& _response);
+
 private:
     std::unordered_map<std::string, std::function<void(Json::Value, RespFunc _respFunc)>>
         m_methodToFunc;
+    // the methods appending the serialized result to the response, take precedence over
+    // m_methodToFunc
+    std::unordered_map<std::string,
+        std::function<void(Json::Value const& _req, std::string& _response)>>
+        m_methodToSerializedFunc;
 
     GroupManager::Ptr m_groupManager;
     bcos::gateway::GatewayInterface::Ptr m_gatewayInterface;
@@ -316,6 +440,22 @@ private:
     // Note: here clientID must non-empty for the rpc will set clientID as source for the tx for
     // tx-notify and the scheduler will not notify the tx-result if the tx source is empty
     std::string m_clientID = "localRpc";
+    // cache the call results of the highest block
+    CallResultCache::Ptr m_callResultCache;
+    // cache the consensus node list, system config and tx count of the highest block
+    LedgerSnapshotCache::Ptr m_ledgerSnapshotCache;
+    // cache the hex encoded code of the contracts
+    CodeCache::Ptr m_codeCache;
+    // hedge the idempotent read requests, disabled by default
+    RequestHedger::Ptr m_requestHedger;
+    // route the reads of the submitted transactions to the nodes having them, disabled by default
+    WriteSessionTracker::Ptr m_writeSessionTracker;
+    // query the history logs for getLogs
+    bcos::event::EventLogQuery::Ptr m_logQuery;
+    // the polling filters of the clients without event subscription
+    bcos::event::EventFilterManager::Ptr m_filterManager;
+    // the json of the group info shared by getGroupInfo, getGroupInfoList and the handshake
+    GroupInfoCache::Ptr m_groupInfoCache;
 
     struct TxHasher
     {
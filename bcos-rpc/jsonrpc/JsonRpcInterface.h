@@ -103,9 +103,28 @@ public:
     virtual void getGroupInfo(std::string const& _groupID, RespFunc _respFunc) = 0;
     // get all the group info list
     virtual void getGroupInfoList(RespFunc _respFunc) = 0;
+    // get the started groups with the prefix in the page [offset, offset + limit)
+    virtual void getGroupListByPage(
+        std::string const& _prefix, int64_t _offset, int64_t _limit, RespFunc _respFunc) = 0;
+    // get the group info of the groups with the prefix in the page [offset, offset + limit)
+    virtual void getGroupInfoListByPage(
+        std::string const& _prefix, int64_t _offset, int64_t _limit, RespFunc _respFunc) = 0;
     // get the information of a given node
     virtual void getGroupNodeInfo(
         std::string const& _groupID, std::string const& _nodeName, RespFunc _respFunc) = 0;
+
+    // get the logs of the blocks in [fromBlock, toBlock] matched with the addresses and topics
+    virtual void getLogs(std::string const& _groupID, int64_t _fromBlock, int64_t _toBlock,
+        Json::Value const& _addresses, Json::Value const& _topics, RespFunc _respFunc) = 0;
+
+    // create the filter with the params of the event subscription, response the filter id
+    virtual void newFilter(
+        std::string const& _groupID, Json::Value const& _params, RespFunc _respFunc) = 0;
+    // create the filter for the new blocks, response the filter id
+    virtual void newBlockFilter(std::string const& _groupID, RespFunc _respFunc) = 0;
+    // get the matched logs or the new block hashes since the last poll
+    virtual void getFilterChanges(std::string const& _filterID, RespFunc _respFunc) = 0;
+    virtual void uninstallFilter(std::string const& _filterID, RespFunc _respFunc) = 0;
 };
 
 }  // namespace rpc
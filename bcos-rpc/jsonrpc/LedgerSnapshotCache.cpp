@@ -0,0 +1,225 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief per-block snapshot of the ledger data that only changes when a block commits
+ * @file LedgerSnapshotCache.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/LedgerSnapshotCache.h>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+LedgerSnapshotCache::SnapshotSlot::Ptr LedgerSnapshotCache::slot(std::string const& _groupID) const
+{
+    auto groupSnapshots = std::atomic_load(&m_groupSnapshots);
+    auto it = groupSnapshots->find(_groupID);
+    if (it == groupSnapshots->end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+LedgerSnapshotCache::SnapshotSlot::Ptr LedgerSnapshotCache::getOrCreateSlot(
+    std::string const& _groupID)
+{
+    auto groupSlot = slot(_groupID);
+    if (groupSlot)
+    {
+        return groupSlot;
+    }
+    Guard l(x_groupSnapshots);
+    auto groupSnapshots = std::atomic_load(&m_groupSnapshots);
+    auto it = groupSnapshots->find(_groupID);
+    if (it != groupSnapshots->end())
+    {
+        return it->second;
+    }
+    auto updatedSnapshots = std::make_shared<GroupSnapshots>(*groupSnapshots);
+    groupSlot = std::make_shared<SnapshotSlot>();
+    (*updatedSnapshots)[_groupID] = groupSlot;
+    std::atomic_store(
+        &m_groupSnapshots, std::shared_ptr<const GroupSnapshots>(std::move(updatedSnapshots)));
+    return groupSlot;
+}
+
+LedgerSnapshot::ConstPtr LedgerSnapshotCache::snapshot(std::string const& _groupID) const
+{
+    auto groupSlot = slot(_groupID);
+    if (!groupSlot)
+    {
+        return nullptr;
+    }
+    return std::atomic_load(&groupSlot->snapshot);
+}
+
+bool LedgerSnapshotCache::get(std::string const& _groupID,
+    bcos::protocol::BlockNumber _blockNumber, std::string const& _item, Json::Value& _value) const
+{
+    if (!enabled())
+    {
+        return false;
+    }
+    auto groupSnapshot = snapshot(_groupID);
+    if (!groupSnapshot || groupSnapshot->blockNumber != _blockNumber)
+    {
+        return false;
+    }
+    auto it = groupSnapshot->items.find(_item);
+    if (it == groupSnapshot->items.end())
+    {
+        return false;
+    }
+    _value = it->second;
+    return true;
+}
+
+void LedgerSnapshotCache::update(std::string const& _groupID,
+    bcos::protocol::BlockNumber _blockNumber, std::string const& _item, Json::Value const& _value)
+{
+    if (!enabled())
+    {
+        return;
+    }
+    publish(_groupID, _blockNumber,
+        [&_item, &_value](LedgerSnapshot::Ptr _snapshot) { _snapshot->items[_item] = _value; });
+}
+
+void LedgerSnapshotCache::query(std::string const& _groupID, std::string const& _item,
+    Querier _querier, QueryCallback _callback)
+{
+    auto groupSnapshot = snapshot(_groupID);
+    if (!enabled() || !groupSnapshot)
+    {
+        _querier(_callback);
+        return;
+    }
+    auto blockNumber = groupSnapshot->blockNumber;
+    auto it = groupSnapshot->items.find(_item);
+    if (it != groupSnapshot->items.end())
+    {
+        auto value = it->second;
+        _callback(nullptr, value);
+        return;
+    }
+    auto key = std::make_pair(_groupID, _item);
+    auto pendingQuery = std::make_shared<PendingQuery>();
+    {
+        Guard l(x_pendingQueries);
+        auto pendingIt = m_pendingQueries.find(key);
+        // the refresh of an older block is left to its callbacks
+        if (pendingIt != m_pendingQueries.end() && pendingIt->second->blockNumber >= blockNumber)
+        {
+            pendingIt->second->callbacks.emplace_back(std::move(_callback));
+            return;
+        }
+        pendingQuery->blockNumber = blockNumber;
+        pendingQuery->callbacks.emplace_back(std::move(_callback));
+        m_pendingQueries[key] = pendingQuery;
+    }
+    auto self = std::weak_ptr<LedgerSnapshotCache>(shared_from_this());
+    _querier([self, _groupID, _item, pendingQuery](Error::Ptr _error, Json::Value& _value) {
+        auto cache = self.lock();
+        if (cache)
+        {
+            cache->onQueried(_groupID, _item, pendingQuery, _error, _value);
+            return;
+        }
+        for (auto const& callback : pendingQuery->callbacks)
+        {
+            auto value = _value;
+            callback(_error, value);
+        }
+    });
+}
+
+void LedgerSnapshotCache::onQueried(std::string const& _groupID, std::string const& _item,
+    PendingQuery::Ptr _pendingQuery, Error::Ptr _error, Json::Value& _value)
+{
+    auto succ = (!_error || _error->errorCode() == bcos::protocol::CommonError::SUCCESS);
+    auto groupSnapshot = snapshot(_groupID);
+    // the result may be read at the new block notified during the query, which is not cached
+    if (succ && groupSnapshot && groupSnapshot->blockNumber == _pendingQuery->blockNumber)
+    {
+        update(_groupID, _pendingQuery->blockNumber, _item, _value);
+    }
+    std::vector<QueryCallback> callbacks;
+    {
+        Guard l(x_pendingQueries);
+        auto it = m_pendingQueries.find(std::make_pair(_groupID, _item));
+        if (it != m_pendingQueries.end() && it->second == _pendingQuery)
+        {
+            m_pendingQueries.erase(it);
+        }
+        callbacks.swap(_pendingQuery->callbacks);
+    }
+    for (auto const& callback : callbacks)
+    {
+        auto value = _value;
+        callback(_error, value);
+    }
+}
+
+void LedgerSnapshotCache::onBlockNumberUpdated(
+    std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber)
+{
+    // drop the items of the expired block, the items of the new block are fetched lazily
+    publish(_groupID, _blockNumber, nullptr);
+    RPC_IMPL_LOG(TRACE) << LOG_BADGE("LedgerSnapshotCache") << LOG_DESC("onBlockNumberUpdated")
+                        << LOG_KV("group", _groupID) << LOG_KV("block", _blockNumber);
+}
+
+void LedgerSnapshotCache::publish(std::string const& _groupID,
+    bcos::protocol::BlockNumber _blockNumber, std::function<void(LedgerSnapshot::Ptr)> _updater)
+{
+    auto groupSlot = getOrCreateSlot(_groupID);
+    auto currentSnapshot = std::atomic_load(&groupSlot->snapshot);
+    while (true)
+    {
+        if (currentSnapshot && currentSnapshot->blockNumber > _blockNumber)
+        {
+            return;
+        }
+        LedgerSnapshot::Ptr updatedSnapshot;
+        if (currentSnapshot && currentSnapshot->blockNumber == _blockNumber)
+        {
+            // the snapshot of the block has already been published
+            if (!_updater)
+            {
+                return;
+            }
+            updatedSnapshot = std::make_shared<LedgerSnapshot>(*currentSnapshot);
+        }
+        else
+        {
+            updatedSnapshot = std::make_shared<LedgerSnapshot>(_blockNumber);
+        }
+        if (_updater)
+        {
+            _updater(updatedSnapshot);
+        }
+        LedgerSnapshot::ConstPtr publishedSnapshot = updatedSnapshot;
+        if (std::atomic_compare_exchange_weak(
+                &groupSlot->snapshot, &currentSnapshot, publishedSnapshot))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief per-block snapshot of the ledger data that only changes when a block commits
+ * @file LedgerSnapshotCache.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <json/json.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace rpc
+{
+// the items of the ledger snapshot
+const std::string SNAPSHOT_SEALER_LIST = "sealerList";
+const std::string SNAPSHOT_OBSERVER_LIST = "observerList";
+const std::string SNAPSHOT_TOTAL_TX_COUNT = "totalTransactionCount";
+const std::string SNAPSHOT_SYSTEM_CONFIG_PREFIX = "systemConfig:";
+
+/**
+ * @brief the immutable ledger data of a given block, a new snapshot is published when an item
+ * is fetched from the ledger or the group reaches a new block
+ */
+struct LedgerSnapshot
+{
+    using Ptr = std::shared_ptr<LedgerSnapshot>;
+    using ConstPtr = std::shared_ptr<const LedgerSnapshot>;
+    explicit LedgerSnapshot(bcos::protocol::BlockNumber _blockNumber) : blockNumber(_blockNumber)
+    {}
+
+    bcos::protocol::BlockNumber blockNumber;
+    std::unordered_map<std::string, Json::Value> items;
+};
+
+class LedgerSnapshotCache : public std::enable_shared_from_this<LedgerSnapshotCache>
+{
+public:
+    using Ptr = std::shared_ptr<LedgerSnapshotCache>;
+    LedgerSnapshotCache() : m_groupSnapshots(std::make_shared<GroupSnapshots>()) {}
+    virtual ~LedgerSnapshotCache() {}
+
+    bool enabled() const { return m_enabled.load(); }
+    void setEnabled(bool _enabled) { m_enabled.store(_enabled); }
+
+    // get the snapshot of the group without lock, return nullptr if not exists
+    LedgerSnapshot::ConstPtr snapshot(std::string const& _groupID) const;
+
+    bool get(std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber,
+        std::string const& _item, Json::Value& _value) const;
+    void update(std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber,
+        std::string const& _item, Json::Value const& _value);
+
+    using QueryCallback = std::function<void(Error::Ptr, Json::Value&)>;
+    using Querier = std::function<void(QueryCallback)>;
+    /**
+     * @brief: answer the item from the snapshot of the block notified by onBlockNumberUpdated,
+     * or refresh it by _querier, which runs once per (group, item) for the concurrent requests
+     * of the same block; the result is published only if no new block is notified during the
+     * query, the group without notified block is always queried and never cached
+     */
+    void query(std::string const& _groupID, std::string const& _item, Querier _querier,
+        QueryCallback _callback);
+
+    // called when the highest block number of the group has been increased
+    void onBlockNumberUpdated(
+        std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber);
+
+private:
+    // the snapshot of a group is replaced atomically
+    struct SnapshotSlot
+    {
+        using Ptr = std::shared_ptr<SnapshotSlot>;
+        LedgerSnapshot::ConstPtr snapshot;
+    };
+    using GroupSnapshots = std::unordered_map<std::string, SnapshotSlot::Ptr>;
+
+    SnapshotSlot::Ptr slot(std::string const& _groupID) const;
+    SnapshotSlot::Ptr getOrCreateSlot(std::string const& _groupID);
+    // publish the snapshot produced by _updater if the block number is not expired
+    void publish(std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber,
+        std::function<void(LedgerSnapshot::Ptr)> _updater);
+
+    // the refresh of an item in flight, the callbacks wait for its result
+    struct PendingQuery
+    {
+        using Ptr = std::shared_ptr<PendingQuery>;
+        bcos::protocol::BlockNumber blockNumber;
+        std::vector<QueryCallback> callbacks;
+    };
+    void onQueried(std::string const& _groupID, std::string const& _item,
+        PendingQuery::Ptr _pendingQuery, Error::Ptr _error, Json::Value& _value);
+
+private:
+    std::atomic_bool m_enabled = {true};
+    // the groups are copied on write, which happens only when a new group is seen
+    std::shared_ptr<const GroupSnapshots> m_groupSnapshots;
+    mutable Mutex x_groupSnapshots;
+
+    // (groupID, item) => the refresh in flight
+    std::map<std::pair<std::string, std::string>, PendingQuery::Ptr> m_pendingQueries;
+    Mutex x_pendingQueries;
+};
+}  // namespace rpc
+}  // namespace bcos
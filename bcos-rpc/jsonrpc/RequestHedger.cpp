@@ -0,0 +1,260 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hedge the idempotent read requests to another node of the group
+ * @file RequestHedger.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/RequestHedger.h>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+struct RequestHedger::HedgeContext
+{
+    using Ptr = std::shared_ptr<HedgeContext>;
+    std::string method;
+    std::string groupID;
+    NodeService::Ptr nodeService;
+    RequestSender sender;
+    RespFunc respFunc;
+    MethodLatency::Ptr methodLatency;
+    std::weak_ptr<RequestHedger> hedger;
+    std::shared_ptr<boost::asio::steady_timer> timer;
+    std::chrono::steady_clock::time_point startTime;
+
+    // the number of the requests waiting for response
+    std::atomic<int> pendingRequests = {1};
+    std::atomic_bool responsed = {false};
+};
+
+void RequestHedger::setEnabled(bool _enabled)
+{
+    if (_enabled)
+    {
+        Guard l(x_hedgeThread);
+        if (!m_hedgeThread)
+        {
+            m_ioContext = std::make_shared<boost::asio::io_context>();
+            m_work = std::make_shared<
+                boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(
+                m_ioContext->get_executor());
+            auto ioContext = m_ioContext;
+            m_hedgeThread = std::make_shared<std::thread>([ioContext]() { ioContext->run(); });
+        }
+    }
+    m_enabled.store(_enabled);
+}
+
+void RequestHedger::stop()
+{
+    m_enabled.store(false);
+    Guard l(x_hedgeThread);
+    if (!m_hedgeThread)
+    {
+        return;
+    }
+    m_work->reset();
+    m_ioContext->stop();
+    if (m_hedgeThread->get_id() != std::this_thread::get_id())
+    {
+        m_hedgeThread->join();
+    }
+    else
+    {
+        m_hedgeThread->detach();
+    }
+    m_hedgeThread.reset();
+}
+
+RequestHedger::MethodLatency::Ptr RequestHedger::methodLatency(std::string const& _method)
+{
+    {
+        ReadGuard l(x_methodLatency);
+        auto it = m_methodLatency.find(_method);
+        if (it != m_methodLatency.end())
+        {
+            return it->second;
+        }
+    }
+    WriteGuard l(x_methodLatency);
+    auto& latency = m_methodLatency[_method];
+    if (!latency)
+    {
+        latency = std::make_shared<MethodLatency>();
+        latency->samples.reserve(c_maxLatencySamples);
+    }
+    return latency;
+}
+
+uint64_t RequestHedger::hedgeDelay(std::string const& _method)
+{
+    auto delay = methodLatency(_method)->hedgeDelay.load();
+    // not enough latency samples
+    if (delay == 0)
+    {
+        return m_defaultHedgeDelay.load() * 1000;
+    }
+    return std::max(delay, m_minHedgeDelay.load() * 1000);
+}
+
+void RequestHedger::recordLatency(MethodLatency::Ptr _methodLatency, uint64_t _latency)
+{
+    Guard l(_methodLatency->x_samples);
+    auto& samples = _methodLatency->samples;
+    if (samples.size() < c_maxLatencySamples)
+    {
+        samples.emplace_back(_latency);
+    }
+    else
+    {
+        samples[_methodLatency->nextSample] = _latency;
+        _methodLatency->nextSample = (_methodLatency->nextSample + 1) % c_maxLatencySamples;
+    }
+    // refresh the percentile periodically
+    if (samples.size() < c_minLatencySamples ||
+        ++_methodLatency->samplesSinceRefresh < c_minLatencySamples)
+    {
+        return;
+    }
+    _methodLatency->samplesSinceRefresh = 0;
+    auto sortedSamples = samples;
+    auto index = std::min((size_t)(m_hedgePercentile.load() * sortedSamples.size()),
+        sortedSamples.size() - 1);
+    std::nth_element(sortedSamples.begin(), sortedSamples.begin() + index, sortedSamples.end());
+    _methodLatency->hedgeDelay.store(std::max(sortedSamples[index], (uint64_t)1));
+}
+
+void RequestHedger::earnToken()
+{
+    Guard l(x_tokens);
+    m_tokens = std::min(m_tokens + m_hedgeTokenRatio.load(), m_maxHedgeTokens.load());
+}
+
+bool RequestHedger::acquireToken()
+{
+    Guard l(x_tokens);
+    if (m_tokens < 1)
+    {
+        return false;
+    }
+    m_tokens -= 1;
+    return true;
+}
+
+void RequestHedger::execute(std::string const& _method, std::string const& _groupID,
+    NodeService::Ptr _nodeService, RequestSender _sender, RespFunc _respFunc)
+{
+    auto ioContext = m_ioContext;
+    if (!enabled() || !ioContext)
+    {
+        _sender(_nodeService, _respFunc);
+        return;
+    }
+    earnToken();
+    auto context = std::make_shared<HedgeContext>();
+    context->method = _method;
+    context->groupID = _groupID;
+    context->nodeService = _nodeService;
+    context->sender = _sender;
+    context->respFunc = _respFunc;
+    context->methodLatency = methodLatency(_method);
+    context->hedger = std::weak_ptr<RequestHedger>(shared_from_this());
+    context->timer = std::make_shared<boost::asio::steady_timer>(*ioContext);
+    context->startTime = std::chrono::steady_clock::now();
+
+    context->timer->expires_after(std::chrono::microseconds(hedgeDelay(_method)));
+    context->timer->async_wait([context](const boost::system::error_code& _error) {
+        if (_error == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        auto hedger = context->hedger.lock();
+        if (hedger)
+        {
+            hedger->hedge(context);
+        }
+    });
+    _sender(_nodeService, responseHandler(context, true));
+}
+
+void RequestHedger::hedge(HedgeContext::Ptr _context)
+{
+    if (_context->responsed.load())
+    {
+        return;
+    }
+    auto hedgeNode = m_groupManager->selectNodeExcept(_context->groupID, _context->nodeService);
+    if (!hedgeNode || !acquireToken())
+    {
+        return;
+    }
+    m_hedgedRequests++;
+    RPC_IMPL_LOG(DEBUG) << LOG_BADGE("RequestHedger") << LOG_DESC("hedge the request")
+                        << LOG_KV("method", _context->method)
+                        << LOG_KV("group", _context->groupID)
+                        << LOG_KV("delay", hedgeDelay(_context->method));
+    _context->pendingRequests++;
+    _context->sender(hedgeNode, responseHandler(_context, false));
+}
+
+RespFunc RequestHedger::responseHandler(HedgeContext::Ptr _context, bool _primary)
+{
+    return [_context, _primary](Error::Ptr _error, Json::Value& _result) {
+        auto hedger = _context->hedger.lock();
+        if (_primary && hedger)
+        {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - _context->startTime)
+                               .count();
+            hedger->recordLatency(_context->methodLatency, latency);
+        }
+        auto pendingRequests = --_context->pendingRequests;
+        bool failed = _error && _error->errorCode() != bcos::protocol::CommonError::SUCCESS;
+        // wait for the response of the other request
+        if (failed && pendingRequests > 0)
+        {
+            return;
+        }
+        // the loser of the hedged requests, the request has been sent and can't be cancelled, its
+        // response is dropped here and never passed to the respFunc
+        if (_context->responsed.exchange(true))
+        {
+            if (hedger)
+            {
+                hedger->m_ignoredResponses++;
+            }
+            RPC_IMPL_LOG(TRACE) << LOG_BADGE("RequestHedger")
+                                << LOG_DESC("ignore the response of the loser")
+                                << LOG_KV("method", _context->method)
+                                << LOG_KV("primary", _primary);
+            return;
+        }
+        // the timer is only accessed by the hedge thread after waited
+        auto timer = _context->timer;
+        boost::asio::post(timer->get_executor(), [timer]() {
+            boost::system::error_code ec;
+            timer->cancel(ec);
+        });
+        _context->respFunc(_error, _result);
+    };
+}
@@ -0,0 +1,135 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hedge the idempotent read requests to another node of the group
+ * @file RequestHedger.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-rpc/jsonrpc/JsonRpcInterface.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace rpc
+{
+// send the request to the given node, the response is passed to the RespFunc
+using RequestSender = std::function<void(NodeService::Ptr, RespFunc)>;
+
+/**
+ * @brief send the request to the selected node first, if no response within the hedge delay of
+ * the method, send the same request to another node with the highest block, and response with
+ * the first successful response, the hedge delay is the given percentile of the latency of the
+ * method, and the hedged requests are limited by the token budget
+ * @note the sent request can't be cancelled, the response of the loser is ignored explicitly and
+ * counted by ignoredResponses, the token spent on the hedged request is not refunded whichever
+ * request wins, so the extra load on the nodes is bounded by the token budget
+ */
+class RequestHedger : public std::enable_shared_from_this<RequestHedger>
+{
+public:
+    using Ptr = std::shared_ptr<RequestHedger>;
+    explicit RequestHedger(GroupManager::Ptr _groupManager) : m_groupManager(_groupManager) {}
+    virtual ~RequestHedger() { stop(); }
+
+    bool enabled() const { return m_enabled.load(); }
+    // the hedge thread is started when enabled
+    void setEnabled(bool _enabled);
+    void stop();
+
+    virtual void execute(std::string const& _method, std::string const& _groupID,
+        NodeService::Ptr _nodeService, RequestSender _sender, RespFunc _respFunc);
+
+    // the percentile of the latency used as the hedge delay
+    double hedgePercentile() const { return m_hedgePercentile.load(); }
+    void setHedgePercentile(double _hedgePercentile) { m_hedgePercentile.store(_hedgePercentile); }
+
+    // the hedge delay in ms when the latency samples are not enough, and the min hedge delay
+    uint64_t defaultHedgeDelay() const { return m_defaultHedgeDelay.load(); }
+    void setDefaultHedgeDelay(uint64_t _delay) { m_defaultHedgeDelay.store(_delay); }
+    uint64_t minHedgeDelay() const { return m_minHedgeDelay.load(); }
+    void setMinHedgeDelay(uint64_t _delay) { m_minHedgeDelay.store(_delay); }
+
+    // every request earns hedgeTokenRatio tokens, and every hedged request costs one token
+    double hedgeTokenRatio() const { return m_hedgeTokenRatio.load(); }
+    void setHedgeTokenRatio(double _ratio) { m_hedgeTokenRatio.store(_ratio); }
+    double maxHedgeTokens() const { return m_maxHedgeTokens.load(); }
+    void setMaxHedgeTokens(double _maxTokens) { m_maxHedgeTokens.store(_maxTokens); }
+
+    uint64_t hedgedRequests() const { return m_hedgedRequests.load(); }
+    // the responses of the losers of the hedged requests
+    uint64_t ignoredResponses() const { return m_ignoredResponses.load(); }
+
+    // the current hedge delay of the method in microseconds
+    uint64_t hedgeDelay(std::string const& _method);
+
+private:
+    struct MethodLatency
+    {
+        using Ptr = std::shared_ptr<MethodLatency>;
+        Mutex x_samples;
+        // the ring buffer of the latest latency samples in microseconds
+        std::vector<uint64_t> samples;
+        size_t nextSample = 0;
+        size_t samplesSinceRefresh = 0;
+        std::atomic<uint64_t> hedgeDelay = {0};
+    };
+    struct HedgeContext;
+
+    MethodLatency::Ptr methodLatency(std::string const& _method);
+    void recordLatency(MethodLatency::Ptr _methodLatency, uint64_t _latency);
+    void earnToken();
+    bool acquireToken();
+    void hedge(std::shared_ptr<HedgeContext> _context);
+    static RespFunc responseHandler(std::shared_ptr<HedgeContext> _context, bool _primary);
+
+private:
+    GroupManager::Ptr m_groupManager;
+    std::atomic_bool m_enabled = {false};
+
+    std::shared_ptr<boost::asio::io_context> m_ioContext;
+    std::shared_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>
+        m_work;
+    std::shared_ptr<std::thread> m_hedgeThread;
+    mutable Mutex x_hedgeThread;
+
+    std::unordered_map<std::string, MethodLatency::Ptr> m_methodLatency;
+    mutable SharedMutex x_methodLatency;
+
+    double m_tokens = 0;
+    mutable Mutex x_tokens;
+
+    std::atomic<double> m_hedgePercentile = {0.95};
+    std::atomic<uint64_t> m_defaultHedgeDelay = {50};
+    std::atomic<uint64_t> m_minHedgeDelay = {5};
+    std::atomic<double> m_hedgeTokenRatio = {0.05};
+    std::atomic<double> m_maxHedgeTokens = {100};
+    std::atomic<uint64_t> m_hedgedRequests = {0};
+    std::atomic<uint64_t> m_ignoredResponses = {0};
+
+    const size_t c_maxLatencySamples = 1024;
+    const size_t c_minLatencySamples = 64;
+};
+}  // namespace rpc
+}  // namespace bcos
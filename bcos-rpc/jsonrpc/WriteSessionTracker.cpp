@@ -0,0 +1,234 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief route the reads of the submitted transactions to the nodes that have them
+ * @file WriteSessionTracker.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/libutilities/Log.h>
+#include <bcos-rpc/jsonrpc/Common.h>
+#include <bcos-rpc/jsonrpc/WriteSessionTracker.h>
+
+using namespace bcos;
+using namespace bcos::rpc;
+
+WriteSessionTracker::WriteSessionTracker(GroupManager::Ptr _groupManager)
+  : m_groupManager(_groupManager)
+{}
+
+WriteSessionTracker::~WriteSessionTracker()
+{
+    Guard l(x_cleaner);
+    if (m_cleaner)
+    {
+        m_cleaner->stop();
+    }
+}
+
+void WriteSessionTracker::setEnabled(bool _enabled)
+{
+    m_enabled.store(_enabled);
+    if (_enabled)
+    {
+        Guard l(x_cleaner);
+        if (!m_cleaner)
+        {
+            // the waiters are expired in maxWaitTime, so the cleaner runs frequently
+            m_cleaner = std::make_shared<Timer>(100, "writeSessionCleaner");
+            m_cleaner->registerTimeoutHandler([this]() { removeExpiredWrites(); });
+        }
+        m_cleaner->start();
+        return;
+    }
+    {
+        Guard l(x_cleaner);
+        if (m_cleaner)
+        {
+            m_cleaner->stop();
+        }
+    }
+    // no cleaner expires the waiters any more, release them to the node selected by the
+    // GroupManager
+    std::unordered_map<std::string, std::list<Waiter>> waiters;
+    {
+        Guard l(x_waiters);
+        waiters.swap(m_waiters);
+    }
+    for (auto const& it : waiters)
+    {
+        for (auto const& waiter : it.second)
+        {
+            waiter.callback(nullptr);
+        }
+    }
+    WriteGuard l(x_writes);
+    m_writes.clear();
+    m_writeQueue.clear();
+}
+
+void WriteSessionTracker::onTransactionCommitted(std::string const& _groupID,
+    bcos::crypto::HashType const& _txHash, NodeService::Ptr _nodeService,
+    bcos::protocol::BlockNumber _blockNumber)
+{
+    if (!enabled() || _blockNumber < 0)
+    {
+        return;
+    }
+    // no need to track the transaction if the group has already reached the block
+    if (m_groupManager->getBlockNumberByGroup(_groupID) >= _blockNumber)
+    {
+        return;
+    }
+    WriteGuard l(x_writes);
+    m_writes[_txHash] = TrackedWrite{_groupID, _nodeService, _blockNumber, utcTime()};
+    m_writeQueue.emplace_back(_txHash);
+    auto maxTrackedWrites = m_maxTrackedWrites.load();
+    while (m_writes.size() > maxTrackedWrites && !m_writeQueue.empty())
+    {
+        m_writes.erase(m_writeQueue.front());
+        m_writeQueue.pop_front();
+    }
+}
+
+void WriteSessionTracker::route(
+    std::string const& _groupID, bcos::crypto::HashType const& _txHash, RouteCallback _callback)
+{
+    if (!enabled())
+    {
+        _callback(nullptr);
+        return;
+    }
+    TrackedWrite trackedWrite;
+    bool tracked = false;
+    {
+        ReadGuard l(x_writes);
+        auto it = m_writes.find(_txHash);
+        if (it != m_writes.end() && it->second.groupID == _groupID)
+        {
+            trackedWrite = it->second;
+            tracked = true;
+        }
+    }
+    if (!tracked)
+    {
+        _callback(nullptr);
+        return;
+    }
+    NodeService::Ptr nodeService = nullptr;
+    {
+        // check the block number with x_waiters held, so the waiter never misses the update
+        Guard l(x_waiters);
+        if (m_groupManager->getBlockNumberByGroup(_groupID) < trackedWrite.blockNumber)
+        {
+            nodeService = trackedWrite.nodeService.lock();
+            if (!nodeService)
+            {
+                RPC_IMPL_LOG(DEBUG)
+                    << LOG_BADGE("WriteSessionTracker") << LOG_DESC("wait for the block")
+                    << LOG_KV("group", _groupID) << LOG_KV("txHash", _txHash.abridged())
+                    << LOG_KV("block", trackedWrite.blockNumber);
+                m_waiters[_groupID].emplace_back(Waiter{trackedWrite.blockNumber,
+                    utcTime() + m_maxWaitTime.load(), std::move(_callback)});
+                return;
+            }
+        }
+    }
+    // the node that committed the transaction is at or past the block if the group is lagging
+    _callback(nodeService);
+}
+
+void WriteSessionTracker::onBlockNumberUpdated(
+    std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber)
+{
+    std::vector<RouteCallback> readyCallbacks;
+    {
+        Guard l(x_waiters);
+        auto it = m_waiters.find(_groupID);
+        if (it == m_waiters.end())
+        {
+            return;
+        }
+        auto& waiters = it->second;
+        for (auto waiterIt = waiters.begin(); waiterIt != waiters.end();)
+        {
+            if (waiterIt->blockNumber > _blockNumber)
+            {
+                waiterIt++;
+                continue;
+            }
+            readyCallbacks.emplace_back(std::move(waiterIt->callback));
+            waiterIt = waiters.erase(waiterIt);
+        }
+        if (waiters.empty())
+        {
+            m_waiters.erase(it);
+        }
+    }
+    for (auto const& callback : readyCallbacks)
+    {
+        callback(nullptr);
+    }
+}
+
+void WriteSessionTracker::removeExpiredWrites()
+{
+    if (enabled())
+    {
+        m_cleaner->restart();
+    }
+    auto now = utcTime();
+    std::vector<RouteCallback> expiredCallbacks;
+    {
+        Guard l(x_waiters);
+        for (auto it = m_waiters.begin(); it != m_waiters.end();)
+        {
+            auto& waiters = it->second;
+            for (auto waiterIt = waiters.begin(); waiterIt != waiters.end();)
+            {
+                if (waiterIt->deadline > now)
+                {
+                    waiterIt++;
+                    continue;
+                }
+                expiredCallbacks.emplace_back(std::move(waiterIt->callback));
+                waiterIt = waiters.erase(waiterIt);
+            }
+            it = waiters.empty() ? m_waiters.erase(it) : std::next(it);
+        }
+    }
+    // fall back to the node selected by the GroupManager
+    for (auto const& callback : expiredCallbacks)
+    {
+        callback(nullptr);
+    }
+
+    auto writeTimeout = m_writeTimeout.load();
+    WriteGuard l(x_writes);
+    while (!m_writeQueue.empty())
+    {
+        auto it = m_writes.find(m_writeQueue.front());
+        // the transaction tracked again is removed when its latest record expires
+        if (it != m_writes.end() && it->second.timestamp + writeTimeout > now)
+        {
+            break;
+        }
+        if (it != m_writes.end())
+        {
+            m_writes.erase(it);
+        }
+        m_writeQueue.pop_front();
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief route the reads of the submitted transactions to the nodes that have them
+ * @file WriteSessionTracker.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace rpc
+{
+/**
+ * @brief track the block and the node of the transactions submitted through the rpc, the reads of
+ * these transactions are routed to a node at or past the block, so the client never sees
+ * "not found" from a lagging node right after the submission
+ */
+class WriteSessionTracker
+{
+public:
+    using Ptr = std::shared_ptr<WriteSessionTracker>;
+    // called with the node to read the transaction, nullptr means selected by the GroupManager
+    using RouteCallback = std::function<void(NodeService::Ptr)>;
+
+    explicit WriteSessionTracker(GroupManager::Ptr _groupManager);
+    virtual ~WriteSessionTracker();
+
+    bool enabled() const { return m_enabled.load(); }
+    // the cleaner timer only runs when enabled
+    void setEnabled(bool _enabled);
+
+    // the transactions are tracked for writeTimeout ms after committed
+    uint64_t writeTimeout() const { return m_writeTimeout.load(); }
+    void setWriteTimeout(uint64_t _writeTimeout) { m_writeTimeout.store(_writeTimeout); }
+    // the max time in ms to wait for the group reaching the block of the transaction
+    uint64_t maxWaitTime() const { return m_maxWaitTime.load(); }
+    void setMaxWaitTime(uint64_t _maxWaitTime) { m_maxWaitTime.store(_maxWaitTime); }
+    size_t maxTrackedWrites() const { return m_maxTrackedWrites.load(); }
+    void setMaxTrackedWrites(size_t _maxTrackedWrites)
+    {
+        m_maxTrackedWrites.store(_maxTrackedWrites);
+    }
+
+    virtual void onTransactionCommitted(std::string const& _groupID,
+        bcos::crypto::HashType const& _txHash, NodeService::Ptr _nodeService,
+        bcos::protocol::BlockNumber _blockNumber);
+
+    // route the read of the transaction: the node selected by the GroupManager if the group has
+    // reached the block, else the node that committed the transaction, else the node selected
+    // by the GroupManager after the group reached the block or waited for maxWaitTime
+    virtual void route(std::string const& _groupID, bcos::crypto::HashType const& _txHash,
+        RouteCallback _callback);
+
+    // called when the highest block number of the group has been increased
+    void onBlockNumberUpdated(
+        std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber);
+
+    size_t trackedWrites() const
+    {
+        ReadGuard l(x_writes);
+        return m_writes.size();
+    }
+
+private:
+    struct TrackedWrite
+    {
+        std::string groupID;
+        std::weak_ptr<NodeService> nodeService;
+        bcos::protocol::BlockNumber blockNumber = -1;
+        uint64_t timestamp = 0;
+    };
+    struct Waiter
+    {
+        bcos::protocol::BlockNumber blockNumber;
+        uint64_t deadline;
+        RouteCallback callback;
+    };
+    void removeExpiredWrites();
+
+private:
+    GroupManager::Ptr m_groupManager;
+    std::atomic_bool m_enabled = {false};
+    std::atomic<uint64_t> m_writeTimeout = {60 * 1000};
+    std::atomic<uint64_t> m_maxWaitTime = {500};
+    std::atomic<size_t> m_maxTrackedWrites = {100000};
+
+    std::unordered_map<bcos::crypto::HashType, TrackedWrite> m_writes;
+    // the tracked transactions in the committed order, used to evict the oldest ones
+    std::deque<bcos::crypto::HashType> m_writeQueue;
+    mutable SharedMutex x_writes;
+
+    // groupID => the reads waiting for the group reaching the block
+    std::unordered_map<std::string, std::list<Waiter>> m_waiters;
+    mutable Mutex x_waiters;
+
+    std::shared_ptr<Timer> m_cleaner;
+    Mutex x_cleaner;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -0,0 +1,154 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief eject the failing node from the node selection
+ * @file CircuitBreaker.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include "CircuitBreaker.h"
+#include <bcos-framework/libutilities/Log.h>
+#include <random>
+using namespace bcos;
+using namespace bcos::rpc;
+
+bool CircuitBreaker::available() const
+{
+    auto now = utcTime();
+    switch (m_state.load())
+    {
+    case CircuitState::CLOSED:
+        return true;
+    case CircuitState::OPEN:
+        return now >= m_openUntil.load() && trialIntervalPassed(now);
+    case CircuitState::HALF_OPEN:
+        return trialIntervalPassed(now);
+    case CircuitState::RECOVERING:
+    {
+        // slow start: the probability to be selected grows linearly within rampTime
+        auto elapsed = now - std::min(now, m_recoverStartTime.load());
+        if (elapsed >= m_config.rampTime)
+        {
+            return true;
+        }
+        auto weight = std::max(0.1, (double)elapsed / (double)m_config.rampTime);
+        thread_local std::mt19937 generator(std::random_device{}());
+        return std::uniform_real_distribution<double>(0, 1)(generator) < weight;
+    }
+    default:
+        return true;
+    }
+}
+
+bool CircuitBreaker::acquireTrial()
+{
+    auto now = utcTime();
+    auto state = m_state.load();
+    if (state == CircuitState::OPEN)
+    {
+        if (now < m_openUntil.load())
+        {
+            return false;
+        }
+        m_state.compare_exchange_strong(state, CircuitState::HALF_OPEN);
+    }
+    else if (state != CircuitState::HALF_OPEN)
+    {
+        return true;
+    }
+    auto lastTrialTime = m_lastTrialTime.load();
+    if (now < lastTrialTime + m_config.trialInterval)
+    {
+        return false;
+    }
+    // only one trial request is allowed in trialInterval
+    return m_lastTrialTime.compare_exchange_strong(lastTrialTime, now);
+}
+
+void CircuitBreaker::onResult(bool _failed, uint64_t _latencyUs)
+{
+    // the results of the requests sent before the circuit opened
+    if (m_state.load() == CircuitState::OPEN)
+    {
+        return;
+    }
+    auto failed = _failed || (_latencyUs >= m_config.slowCallThreshold);
+    auto now = utcTime();
+    Guard l(x_window);
+    auto state = m_state.load();
+    if (state == CircuitState::OPEN)
+    {
+        return;
+    }
+    if (state == CircuitState::HALF_OPEN)
+    {
+        if (failed)
+        {
+            openWithoutLock(now);
+            return;
+        }
+        resetWindowWithoutLock(now);
+        m_recoverStartTime.store(now);
+        m_state.store(CircuitState::RECOVERING);
+        BCOS_LOG(INFO) << LOG_DESC("CircuitBreaker: trial succeeded, ramp up the node")
+                       << LOG_KV("rampTime", m_config.rampTime);
+        return;
+    }
+    if (now >= m_windowStartTime + m_config.windowTime)
+    {
+        resetWindowWithoutLock(now);
+    }
+    m_windowRequests++;
+    if (failed)
+    {
+        m_windowFailures++;
+        m_consecutiveFailures++;
+        auto errorRateExceeded =
+            (m_windowRequests >= m_config.minWindowRequests) &&
+            ((double)m_windowFailures >= m_config.errorRateThreshold * (double)m_windowRequests);
+        if (m_consecutiveFailures >= m_config.consecutiveFailureThreshold || errorRateExceeded)
+        {
+            openWithoutLock(now);
+        }
+        return;
+    }
+    m_consecutiveFailures = 0;
+    if (state == CircuitState::RECOVERING && now >= m_recoverStartTime.load() + m_config.rampTime)
+    {
+        m_state.store(CircuitState::CLOSED);
+        BCOS_LOG(INFO) << LOG_DESC("CircuitBreaker: the node recovered");
+    }
+}
+
+void CircuitBreaker::openWithoutLock(uint64_t _now)
+{
+    BCOS_LOG(WARNING) << LOG_DESC("CircuitBreaker: eject the failing node")
+                      << LOG_KV("state", (int32_t)m_state.load())
+                      << LOG_KV("requests", m_windowRequests)
+                      << LOG_KV("failures", m_windowFailures)
+                      << LOG_KV("consecutiveFailures", m_consecutiveFailures)
+                      << LOG_KV("openTime", m_config.openTime);
+    m_openUntil.store(_now + m_config.openTime);
+    m_state.store(CircuitState::OPEN);
+    resetWindowWithoutLock(_now);
+}
+
+void CircuitBreaker::resetWindowWithoutLock(uint64_t _now)
+{
+    m_windowStartTime = _now;
+    m_windowRequests = 0;
+    m_windowFailures = 0;
+    m_consecutiveFailures = 0;
+}
@@ -0,0 +1,121 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief eject the failing node from the node selection
+ * @file CircuitBreaker.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Error.h>
+#include <atomic>
+namespace bcos
+{
+namespace rpc
+{
+enum class CircuitState : int32_t
+{
+    CLOSED = 0,
+    // the node is ejected from the selection
+    OPEN = 1,
+    // the open time has passed, the trial requests are allowed
+    HALF_OPEN = 2,
+    // the trial succeeded, the traffic to the node is ramped up gradually
+    RECOVERING = 3,
+};
+
+// the thresholds of the circuit breakers, the time in ms unless specified
+struct CircuitBreakerConfig
+{
+    uint64_t windowTime = 10 * 1000;
+    uint64_t minWindowRequests = 20;
+    double errorRateThreshold = 0.5;
+    uint64_t consecutiveFailureThreshold = 5;
+    // in microseconds
+    uint64_t slowCallThreshold = 3 * 1000 * 1000;
+    uint64_t openTime = 5 * 1000;
+    uint64_t trialInterval = 1000;
+    uint64_t rampTime = 30 * 1000;
+};
+
+/**
+ * @brief the circuit breaker of a node driven by the results of the requests to the node,
+ * the node is ejected when too many requests fail or timeout in a window, after the open time
+ * the trial requests are allowed at most once per trialInterval, and the node is ramped back
+ * in within rampTime after a trial succeeds
+ */
+class CircuitBreaker
+{
+public:
+    using Ptr = std::shared_ptr<CircuitBreaker>;
+    CircuitBreaker() = default;
+    virtual ~CircuitBreaker() {}
+
+    // the errors of the tars transport(timeout, connection failure, overload) are negative,
+    // the errors of the business logic(e.g. the transaction not found) are not node failures
+    static bool isNodeFailure(Error::Ptr const& _error)
+    {
+        return _error && _error->errorCode() < 0;
+    }
+
+    // whether the node can be selected for a new request, the state is not changed, called by
+    // the node selection for every candidate
+    virtual bool available() const;
+    // the ejected node only accepts the trial requests
+    bool trialRequired() const
+    {
+        auto state = m_state.load();
+        return state == CircuitState::OPEN || state == CircuitState::HALF_OPEN;
+    }
+    // acquire the trial request of the available ejected node, at most one trial is acquired in
+    // trialInterval, called once the node is selected
+    virtual bool acquireTrial();
+    // report the result of the request to the node
+    virtual void onResult(bool _failed, uint64_t _latencyUs);
+
+    CircuitState state() const { return m_state.load(); }
+
+public:
+    // called before the breaker is used by the requests
+    void setConfig(CircuitBreakerConfig const& _config) { m_config = _config; }
+    CircuitBreakerConfig const& config() const { return m_config; }
+
+private:
+    void openWithoutLock(uint64_t _now);
+    void resetWindowWithoutLock(uint64_t _now);
+    bool trialIntervalPassed(uint64_t _now) const
+    {
+        return _now >= m_lastTrialTime.load() + m_config.trialInterval;
+    }
+
+private:
+    std::atomic<CircuitState> m_state = {CircuitState::CLOSED};
+    // the time in ms when the state can be changed from OPEN to HALF_OPEN
+    std::atomic<uint64_t> m_openUntil = {0};
+    std::atomic<uint64_t> m_lastTrialTime = {0};
+    std::atomic<uint64_t> m_recoverStartTime = {0};
+
+    // the statistics of the current window, protected by x_window
+    uint64_t m_windowStartTime = 0;
+    uint64_t m_windowRequests = 0;
+    uint64_t m_windowFailures = 0;
+    uint64_t m_consecutiveFailures = 0;
+    mutable Mutex x_window;
+
+    CircuitBreakerConfig m_config;
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -0,0 +1,167 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the highest block of a group and the nodes reaching it, updated without lock
+ * @file GroupBlockHead.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include "GroupBlockHead.h"
+using namespace bcos;
+using namespace bcos::rpc;
+
+uint64_t GroupBlockHead::latestNodes() const
+{
+    // the word may belong to a newer block being updated, retry to get a consistent view
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto blockNumber = m_blockNumber.load();
+        auto latestNodes = m_latestNodes.load();
+        if (blockNumber != m_blockNumber.load())
+        {
+            continue;
+        }
+        if ((latestNodes & ~c_nodesMask) != tag(blockNumber))
+        {
+            continue;
+        }
+        return latestNodes & c_nodesMask;
+    }
+    return 0;
+}
+
+int32_t GroupBlockHead::nodeBit(std::string const& _nodeName) const
+{
+    auto nodeBits = std::atomic_load(&m_nodeBits);
+    auto it = nodeBits->find(_nodeName);
+    if (it == nodeBits->end())
+    {
+        return -1;
+    }
+    return it->second;
+}
+
+int32_t GroupBlockHead::internNode(std::string const& _nodeName)
+{
+    Guard l(x_nodeBits);
+    auto nodeBits = std::atomic_load(&m_nodeBits);
+    auto it = nodeBits->find(_nodeName);
+    if (it != nodeBits->end())
+    {
+        return it->second;
+    }
+    auto freeBits = ~m_usedBits & c_nodesMask;
+    if (freeBits == 0)
+    {
+        return -1;
+    }
+    int32_t bit = 0;
+    while ((freeBits & (1ULL << bit)) == 0)
+    {
+        bit++;
+    }
+    auto updatedNodeBits = std::make_shared<NodeBits>(*nodeBits);
+    (*updatedNodeBits)[_nodeName] = bit;
+    m_usedBits |= (1ULL << bit);
+    std::atomic_store(&m_nodeBits, std::shared_ptr<const NodeBits>(std::move(updatedNodeBits)));
+    return bit;
+}
+
+BlockHeadUpdateResult GroupBlockHead::update(
+    int32_t _nodeBit, bcos::protocol::BlockNumber _blockNumber)
+{
+    auto blockNumber = m_blockNumber.load();
+    while (true)
+    {
+        if (_blockNumber < blockNumber)
+        {
+            return BlockHeadUpdateResult::EXPIRED;
+        }
+        if (_blockNumber == blockNumber)
+        {
+            return setNodeBit(_nodeBit, _blockNumber) ? BlockHeadUpdateResult::NODE_UPDATED :
+                                                        BlockHeadUpdateResult::UNCHANGED;
+        }
+        if (m_blockNumber.compare_exchange_weak(blockNumber, _blockNumber))
+        {
+            // the winner resets the bitmap for the new block
+            setNodeBit(_nodeBit, _blockNumber);
+            return BlockHeadUpdateResult::BLOCK_INCREASED;
+        }
+    }
+}
+
+bool GroupBlockHead::setNodeBit(int32_t _nodeBit, bcos::protocol::BlockNumber _blockNumber)
+{
+    uint64_t nodeMask = (_nodeBit >= 0 && _nodeBit < c_maxTrackedNodes) ? (1ULL << _nodeBit) : 0;
+    auto blockTag = tag(_blockNumber);
+    auto latestNodes = m_latestNodes.load();
+    while (true)
+    {
+        // check after loading the word: the word of a newer block is never overwritten
+        if (m_blockNumber.load() != _blockNumber)
+        {
+            return false;
+        }
+        uint64_t updatedNodes = 0;
+        if ((latestNodes & ~c_nodesMask) == blockTag)
+        {
+            if ((latestNodes & nodeMask) == nodeMask)
+            {
+                return false;
+            }
+            updatedNodes = latestNodes | nodeMask;
+        }
+        else
+        {
+            updatedNodes = blockTag | nodeMask;
+        }
+        if (m_latestNodes.compare_exchange_weak(latestNodes, updatedNodes))
+        {
+            return true;
+        }
+    }
+}
+
+void GroupBlockHead::removeNodes(std::set<std::string> const& _nodeNames)
+{
+    Guard l(x_nodeBits);
+    auto nodeBits = std::atomic_load(&m_nodeBits);
+    uint64_t removedBits = 0;
+    auto updatedNodeBits = std::make_shared<NodeBits>(*nodeBits);
+    for (auto const& nodeName : _nodeNames)
+    {
+        auto it = updatedNodeBits->find(nodeName);
+        if (it == updatedNodeBits->end())
+        {
+            continue;
+        }
+        removedBits |= (1ULL << it->second);
+        updatedNodeBits->erase(it);
+    }
+    if (removedBits == 0)
+    {
+        return;
+    }
+    // clear the bits before they are released, so the new nodes never inherit the block reached
+    // by the removed nodes
+    auto latestNodes = m_latestNodes.load();
+    while ((latestNodes & removedBits) != 0 &&
+           !m_latestNodes.compare_exchange_weak(latestNodes, latestNodes & ~removedBits))
+    {
+    }
+    m_usedBits &= ~removedBits;
+    std::atomic_store(&m_nodeBits, std::shared_ptr<const NodeBits>(std::move(updatedNodeBits)));
+}
@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the highest block of a group and the nodes reaching it, updated without lock
+ * @file GroupBlockHead.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+#include <set>
+#include <unordered_map>
+namespace bcos
+{
+namespace rpc
+{
+enum class BlockHeadUpdateResult : int32_t
+{
+    // the block is lower than the highest block of the group
+    EXPIRED = 0,
+    // the node has already reached the highest block
+    UNCHANGED = 1,
+    // the node reached the highest block
+    NODE_UPDATED = 2,
+    // the highest block of the group increased
+    BLOCK_INCREASED = 3,
+};
+
+/**
+ * @brief the nodes are interned to the bits of a 64-bit word, whose high 16 bits are the tag of
+ * the block that the bits belong to, so the block number and the nodes reaching it are updated
+ * by CAS without lock; at most c_maxTrackedNodes nodes of a group are interned, the nodes beyond
+ * are never selected as the nodes with the highest block
+ */
+class GroupBlockHead
+{
+public:
+    using Ptr = std::shared_ptr<GroupBlockHead>;
+    static constexpr int32_t c_maxTrackedNodes = 48;
+
+    GroupBlockHead() : m_nodeBits(std::make_shared<NodeBits>()) {}
+    virtual ~GroupBlockHead() {}
+
+    bcos::protocol::BlockNumber blockNumber() const { return m_blockNumber.load(); }
+    // the bitmap of the nodes with the highest block
+    uint64_t latestNodes() const;
+
+    // the bit of the node, -1 if the node has not been interned
+    int32_t nodeBit(std::string const& _nodeName) const;
+    // intern the node to the lowest free bit, return -1 if c_maxTrackedNodes nodes are interned
+    int32_t internNode(std::string const& _nodeName);
+
+    // the node with _nodeBit(-1 for the untracked node) reached _blockNumber
+    BlockHeadUpdateResult update(int32_t _nodeBit, bcos::protocol::BlockNumber _blockNumber);
+    // clear the bits of the removed nodes and release them to the new nodes, the highest block of
+    // the group is kept
+    void removeNodes(std::set<std::string> const& _nodeNames);
+    size_t internedNodes() const
+    {
+        auto nodeBits = std::atomic_load(&m_nodeBits);
+        return nodeBits->size();
+    }
+
+private:
+    static uint64_t tag(bcos::protocol::BlockNumber _blockNumber)
+    {
+        return ((uint64_t)_blockNumber & 0xFFFF) << c_maxTrackedNodes;
+    }
+    // set the bit of the node for _blockNumber, return false if unchanged or a newer block reached
+    bool setNodeBit(int32_t _nodeBit, bcos::protocol::BlockNumber _blockNumber);
+
+private:
+    static constexpr uint64_t c_nodesMask = (1ULL << c_maxTrackedNodes) - 1;
+    std::atomic<int64_t> m_blockNumber = {-1};
+    std::atomic<uint64_t> m_latestNodes = {0};
+
+    // nodeName => bit, copied on write, which happens only when a new node is seen
+    using NodeBits = std::unordered_map<std::string, int32_t>;
+    std::shared_ptr<const NodeBits> m_nodeBits;
+    // the bits used by m_nodeBits
+    uint64_t m_usedBits = 0;
+    Mutex x_nodeBits;
+};
+}  // namespace rpc
+}  // namespace bcos
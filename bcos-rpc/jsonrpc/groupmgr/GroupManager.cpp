@@ -20,6 +20,7 @@
  */
 #include "GroupManager.h"
 #include <bcos-framework/interfaces/protocol/ServiceDesc.h>
+#include <algorithm>
 #include <cstdint>
 using namespace bcos;
 using namespace bcos::group;
@@ -28,121 +29,467 @@ using namespace bcos::protocol;
 
 void GroupManager::updateGroupInfo(bcos::group::GroupInfo::Ptr _groupInfo)
 {
-    WriteGuard l(x_nodeServiceList);
-    auto const& groupID = _groupInfo->groupID();
-    if (!m_groupInfos.count(groupID))
+    auto groupID = _groupInfo->groupID();
+    auto& shard = groupShard(groupID);
+    // the started nodes without the node service
+    std::vector<ChainNodeInfo::Ptr> startedNodes;
+    {
+        WriteGuard l(shard.x_groups);
+        if (!shard.groupInfos.count(groupID))
+        {
+            shard.groupInfos[groupID] = _groupInfo;
+            increaseGroupInfoVersionWithoutLock(shard, groupID);
+            addSortedGroupID(groupID);
+            GROUP_LOG(INFO) << LOG_DESC("updateGroupInfo") << printGroupInfo(_groupInfo);
+            m_groupInfoNotifier(_groupInfo);
+            return;
+        }
+        auto nodeServicesIt = shard.nodeServiceList.find(groupID);
+        for (auto const& it : _groupInfo->nodeInfos())
+        {
+            if (nodeServicesIt == shard.nodeServiceList.end() ||
+                !nodeServicesIt->second.count(it.second->nodeName()))
+            {
+                startedNodes.emplace_back(it.second);
+            }
+        }
+    }
+    if (startedNodes.empty())
     {
-        m_groupInfos[groupID] = _groupInfo;
-        GROUP_LOG(INFO) << LOG_DESC("updateGroupInfo") << printGroupInfo(_groupInfo);
-        m_groupInfoNotifier(_groupInfo);
         return;
     }
-    auto nodeInfos = _groupInfo->nodeInfos();
-    for (auto const& it : nodeInfos)
+    // the clients connect to the nodes, which is slow, built outside the lock concurrently on
+    // the bounded thread pool of the factory
+    auto nodeServices = m_nodeServiceFactory->buildNodeServices(m_chainID, groupID, startedNodes);
+    // swap in the node services under the lock
+    bool updated = false;
+    {
+        WriteGuard l(shard.x_groups);
+        for (size_t i = 0; i < startedNodes.size(); i++)
+        {
+            updated =
+                addNodeServiceWithoutLock(shard, groupID, startedNodes[i], nodeServices[i]) ||
+                updated;
+        }
+    }
+    if (updated)
     {
-        updateNodeServiceWithoutLock(groupID, it.second);
+        publishRoutingTable(std::set<std::string>{groupID});
     }
 }
 
-void GroupManager::updateNodeServiceWithoutLock(
-    std::string const& _groupID, ChainNodeInfo::Ptr _nodeInfo)
+bool GroupManager::addNodeServiceWithoutLock(GroupShard& _shard, std::string const& _groupID,
+    ChainNodeInfo::Ptr _nodeInfo, NodeService::Ptr _nodeService)
 {
-    auto nodeAppName = _nodeInfo->nodeName();
-    // the node has already been existed
-    if (m_nodeServiceList.count(_groupID) && m_nodeServiceList[_groupID].count(nodeAppName))
+    if (!_nodeService)
     {
-        return;
+        return false;
     }
-    // a started node
-    auto nodeService = m_nodeServiceFactory->buildNodeService(m_chainID, _groupID, _nodeInfo);
-    if (!nodeService)
+    // the group may be removed while building the node service
+    auto groupInfoIt = _shard.groupInfos.find(_groupID);
+    if (groupInfoIt == _shard.groupInfos.end())
     {
-        return;
+        return false;
+    }
+    auto nodeAppName = _nodeInfo->nodeName();
+    // the node service may be added by the concurrent update
+    auto& nodeServices = _shard.nodeServiceList[_groupID];
+    if (nodeServices.count(nodeAppName))
+    {
+        return false;
     }
-    m_nodeServiceList[_groupID][nodeAppName] = nodeService;
-    auto groupInfo = m_groupInfos[_groupID];
+    nodeServices[nodeAppName] = _nodeService;
+    auto groupInfo = groupInfoIt->second;
     groupInfo->appendNodeInfo(_nodeInfo);
+    increaseGroupInfoVersionWithoutLock(_shard, _groupID);
     m_groupInfoNotifier(groupInfo);
     BCOS_LOG(INFO) << LOG_DESC("buildNodeService for the started new node")
                    << printNodeInfo(_nodeInfo) << printGroupInfo(groupInfo);
+    return true;
+}
+
+namespace
+{
+// insert or erase the group in the sorted groups copied on write, return false if unchanged
+bool updateSortedGroupIDs(std::shared_ptr<const std::vector<std::string>>& _sortedGroupIDs,
+    std::string const& _groupID, bool _insert)
+{
+    auto sortedGroupIDs = std::atomic_load(&_sortedGroupIDs);
+    auto it = std::lower_bound(sortedGroupIDs->begin(), sortedGroupIDs->end(), _groupID);
+    bool exists = (it != sortedGroupIDs->end() && *it == _groupID);
+    if (exists == _insert)
+    {
+        return false;
+    }
+    auto updatedGroupIDs = std::make_shared<std::vector<std::string>>();
+    updatedGroupIDs->reserve(sortedGroupIDs->size() + 1);
+    updatedGroupIDs->insert(updatedGroupIDs->end(), sortedGroupIDs->cbegin(), it);
+    if (_insert)
+    {
+        updatedGroupIDs->emplace_back(_groupID);
+        updatedGroupIDs->insert(updatedGroupIDs->end(), it, sortedGroupIDs->cend());
+    }
+    else
+    {
+        updatedGroupIDs->insert(updatedGroupIDs->end(), it + 1, sortedGroupIDs->cend());
+    }
+    std::atomic_store(&_sortedGroupIDs,
+        std::shared_ptr<const std::vector<std::string>>(std::move(updatedGroupIDs)));
+    return true;
+}
+}  // namespace
+
+void GroupManager::addSortedGroupID(std::string const& _groupID)
+{
+    // the groups are added rarely, the readers page the sorted groups without lock
+    Guard l(x_sortedGroupIDs);
+    updateSortedGroupIDs(m_sortedGroupIDs, _groupID, true);
+}
+
+void GroupManager::updateStartedGroupWithoutLock(GroupShard& _shard, std::string const& _groupID)
+{
+    auto groupInfoIt = _shard.groupInfos.find(_groupID);
+    bool started = (groupInfoIt != _shard.groupInfos.end() && groupInfoIt->second->nodesNum() > 0);
+    if (started == (_shard.startedGroups.count(_groupID) > 0))
+    {
+        return;
+    }
+    if (started)
+    {
+        _shard.startedGroups.insert(_groupID);
+    }
+    else
+    {
+        _shard.startedGroups.erase(_groupID);
+    }
+    Guard l(x_sortedGroupIDs);
+    updateSortedGroupIDs(m_sortedStartedGroupIDs, _groupID, started);
+}
+
+std::vector<std::string> GroupManager::queryGroupList(std::string const& _prefix,
+    size_t _offset, size_t _limit, bool _onlyStarted, size_t& _total)
+{
+    std::vector<std::string> groupList;
+    auto limit = std::min(_limit, c_maxGroupPageSize);
+    auto groupIDs = _onlyStarted ? sortedStartedGroupIDs() : sortedGroupIDs();
+    // the groups started with the prefix are adjacent in the sorted groups, so the page is located
+    // by binary search without visiting the groups out of the page
+    auto begin = std::lower_bound(groupIDs->begin(), groupIDs->end(), _prefix);
+    auto end = std::partition_point(begin, groupIDs->end(), [&_prefix](std::string const& _id) {
+        return _id.compare(0, _prefix.size(), _prefix) == 0;
+    });
+    _total = end - begin;
+    if (_offset >= _total)
+    {
+        return groupList;
+    }
+    auto pageBegin = begin + _offset;
+    auto pageEnd = pageBegin + std::min(limit, _total - _offset);
+    groupList.assign(pageBegin, pageEnd);
+    return groupList;
+}
+
+void GroupManager::updateGroupBlockInfo(std::string const& _groupID, std::string const& _nodeName,
+    bcos::protocol::BlockNumber _blockNumber)
+{
+    bool created = false;
+    auto groupBlockHead = getOrCreateBlockHead(_groupID, created);
+    auto nodeBit = groupBlockHead->nodeBit(_nodeName);
+    if (nodeBit < 0)
+    {
+        nodeBit = groupBlockHead->internNode(_nodeName);
+        if (nodeBit >= 0)
+        {
+            // the routing table records the bits of the nodes
+            created = true;
+        }
+        else
+        {
+            // logged for every notification of the untracked node, so not a warning
+            BCOS_LOG(DEBUG) << LOG_DESC("updateGroupBlockInfo: too many nodes to track")
+                            << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName);
+        }
+    }
+    // the groups are updated without lock, the routing table is only republished for new nodes
+    auto result = groupBlockHead->update(nodeBit, _blockNumber);
+    if (created)
+    {
+        publishRoutingTable(std::set<std::string>{_groupID});
+    }
+    if (result == BlockHeadUpdateResult::EXPIRED || result == BlockHeadUpdateResult::UNCHANGED)
+    {
+        return;
+    }
+    BCOS_LOG(DEBUG) << LOG_DESC("updateGroupBlockInfo for receive block notify")
+                    << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName)
+                    << LOG_KV("block", _blockNumber);
+    if (result == BlockHeadUpdateResult::BLOCK_INCREASED)
+    {
+        notifyBlockNumber(_groupID, _blockNumber);
+    }
+}
+
+GroupBlockHead::Ptr GroupManager::blockHead(std::string const& _groupID) const
+{
+    auto groupBlockHeads = std::atomic_load(&groupShard(_groupID).blockHeads);
+    auto it = groupBlockHeads->find(_groupID);
+    if (it == groupBlockHeads->end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+GroupBlockHead::Ptr GroupManager::getOrCreateBlockHead(std::string const& _groupID, bool& _created)
+{
+    _created = false;
+    auto groupBlockHead = blockHead(_groupID);
+    if (groupBlockHead)
+    {
+        return groupBlockHead;
+    }
+    auto& shard = groupShard(_groupID);
+    Guard l(shard.x_blockHeads);
+    auto groupBlockHeads = std::atomic_load(&shard.blockHeads);
+    auto it = groupBlockHeads->find(_groupID);
+    if (it != groupBlockHeads->end())
+    {
+        return it->second;
+    }
+    auto updatedBlockHeads = std::make_shared<GroupBlockHeads>(*groupBlockHeads);
+    groupBlockHead = std::make_shared<GroupBlockHead>();
+    (*updatedBlockHeads)[_groupID] = groupBlockHead;
+    std::atomic_store(&shard.blockHeads,
+        std::shared_ptr<const GroupBlockHeads>(std::move(updatedBlockHeads)));
+    _created = true;
+    return groupBlockHead;
+}
+
+void GroupManager::notifyBlockNumber(
+    std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber)
+{
+    for (auto const& notifier : m_blockNumberNotifiers)
+    {
+        notifier(_groupID, _blockNumber);
+    }
 }
 
 bcos::protocol::BlockNumber GroupManager::getBlockNumberByGroup(const std::string& _groupID)
 {
-    ReadGuard l(x_groupBlockInfos);
-    if (!m_groupBlockInfos.count(_groupID))
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable)
     {
         return -1;
     }
+    return groupRoutingTable->blockNumber();
+}
 
-    return m_groupBlockInfos.at(_groupID);
+GroupRoutingTable::ConstPtr GroupManager::routingTable(std::string const& _groupID) const
+{
+    auto routingTable = std::atomic_load(&groupShard(_groupID).routingTable);
+    auto it = routingTable->find(_groupID);
+    if (it == routingTable->end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void GroupManager::publishRoutingTable(std::set<std::string> const& _groups)
+{
+    for (auto const& groupID : _groups)
+    {
+        auto& shard = groupShard(groupID);
+        // serialize the writers of the shard, the readers access the published table without lock
+        Guard l(shard.x_routingTable);
+        auto groupRoutingTable = std::make_shared<GroupRoutingTable>();
+        {
+            ReadGuard groupsGuard(shard.x_groups);
+            auto nodeServicesIt = shard.nodeServiceList.find(groupID);
+            if (nodeServicesIt != shard.nodeServiceList.end())
+            {
+                for (auto const& it : nodeServicesIt->second)
+                {
+                    if (!it.second)
+                    {
+                        continue;
+                    }
+                    groupRoutingTable->nodeIndex[it.first] =
+                        groupRoutingTable->nodeServices.size();
+                    groupRoutingTable->nodeServices.emplace_back(it.second);
+                    groupRoutingTable->nodeNames.emplace_back(it.first);
+                }
+            }
+            auto groupInfoIt = shard.groupInfos.find(groupID);
+            if (groupInfoIt != shard.groupInfos.end())
+            {
+                auto const& nodeInfos = groupInfoIt->second->nodeInfos();
+                for (auto const& it : nodeInfos)
+                {
+                    auto indexIt = groupRoutingTable->nodeIndex.find(it.second->nodeName());
+                    if (indexIt != groupRoutingTable->nodeIndex.end())
+                    {
+                        groupRoutingTable->availableNodes.emplace_back(indexIt->second);
+                    }
+                }
+            }
+        }
+        groupRoutingTable->blockHead = blockHead(groupID);
+        for (auto const& nodeName : groupRoutingTable->nodeNames)
+        {
+            groupRoutingTable->nodeBits.emplace_back(
+                groupRoutingTable->blockHead ? groupRoutingTable->blockHead->nodeBit(nodeName) :
+                                               -1);
+        }
+        // only the routing table of the shard is copied
+        auto updatedRoutingTable =
+            std::make_shared<RoutingTable>(*std::atomic_load(&shard.routingTable));
+        if (groupRoutingTable->nodeServices.empty() && groupRoutingTable->blockNumber() < 0)
+        {
+            updatedRoutingTable->erase(groupID);
+        }
+        else
+        {
+            (*updatedRoutingTable)[groupID] = groupRoutingTable;
+        }
+        std::atomic_store(&shard.routingTable,
+            std::shared_ptr<const RoutingTable>(std::move(updatedRoutingTable)));
+    }
 }
 
 NodeService::Ptr GroupManager::selectNode(std::string const& _groupID) const
 {
-    auto nodeName = selectNodeByBlockNumber(_groupID);
-    if (nodeName.size() == 0)
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable)
+    {
+        return nullptr;
+    }
+    auto latestNodes = groupRoutingTable->latestNodes();
+    if (latestNodes.empty())
     {
         return selectNodeRandomly(_groupID);
     }
-    return queryNodeService(_groupID, nodeName);
+    auto candidates = availableCandidates(*groupRoutingTable, latestNodes);
+    if (candidates.empty())
+    {
+        candidates = availableCandidates(*groupRoutingTable, groupRoutingTable->availableNodes);
+    }
+    // all the nodes are ejected, select from the nodes with the highest block anyway
+    if (candidates.empty())
+    {
+        candidates = latestNodes;
+    }
+    auto index = nodeSelector()->select(groupRoutingTable->nodeServices, candidates);
+    return groupRoutingTable->nodeServices[index];
 }
+
 std::string GroupManager::selectNodeByBlockNumber(std::string const& _groupID) const
 {
-    ReadGuard l(x_groupBlockInfos);
-    if (!m_nodesWithLatestBlockNumber.count(_groupID) ||
-        m_nodesWithLatestBlockNumber.at(_groupID).size() == 0)
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable)
     {
         return "";
     }
-    srand(utcTime());
-    auto const& nodesList = m_nodesWithLatestBlockNumber.at(_groupID);
-    auto selectNodeIndex = rand() % nodesList.size();
-    auto it = nodesList.begin();
-    if (selectNodeIndex > 0)
+    auto latestNodes = groupRoutingTable->latestNodes();
+    if (latestNodes.empty())
     {
-        std::advance(it, selectNodeIndex);
+        return "";
     }
-    return *it;
+    auto candidates = availableCandidates(*groupRoutingTable, latestNodes);
+    if (candidates.empty())
+    {
+        candidates = latestNodes;
+    }
+    auto index = nodeSelector()->select(groupRoutingTable->nodeServices, candidates);
+    return groupRoutingTable->nodeNames[index];
 }
 
-NodeService::Ptr GroupManager::selectNodeRandomly(std::string const& _groupID) const
+NodeService::Ptr GroupManager::selectNodeExcept(
+    std::string const& _groupID, NodeService::Ptr _excludedNode) const
 {
-    ReadGuard l(x_nodeServiceList);
-    if (!m_groupInfos.count(_groupID))
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable)
+    {
+        return nullptr;
+    }
+    std::vector<size_t> otherNodes;
+    for (auto index : groupRoutingTable->latestNodes())
+    {
+        if (groupRoutingTable->nodeServices[index] != _excludedNode)
+        {
+            otherNodes.emplace_back(index);
+        }
+    }
+    auto candidates = availableCandidates(*groupRoutingTable, otherNodes);
+    if (candidates.empty())
     {
         return nullptr;
     }
-    if (!m_nodeServiceList.count(_groupID))
+    auto index = nodeSelector()->select(groupRoutingTable->nodeServices, candidates);
+    return groupRoutingTable->nodeServices[index];
+}
+
+NodeService::Ptr GroupManager::selectNodeRandomly(std::string const& _groupID) const
+{
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable || groupRoutingTable->availableNodes.empty())
     {
         return nullptr;
     }
-    auto const& groupInfo = m_groupInfos.at(_groupID);
-    auto const& nodeInfos = groupInfo->nodeInfos();
-    for (auto const& it : nodeInfos)
+    auto candidates = availableCandidates(*groupRoutingTable, groupRoutingTable->availableNodes);
+    if (candidates.empty())
     {
-        auto const& node = it.second;
-        if (m_nodeServiceList.at(_groupID).count(node->nodeName()))
+        candidates = groupRoutingTable->availableNodes;
+    }
+    auto index = nodeSelector()->select(groupRoutingTable->nodeServices, candidates);
+    return groupRoutingTable->nodeServices[index];
+}
+
+std::vector<size_t> GroupManager::availableCandidates(
+    GroupRoutingTable const& _groupRoutingTable, std::vector<size_t> const& _candidates) const
+{
+    std::vector<size_t> candidates;
+    std::vector<size_t> trialCandidates;
+    candidates.reserve(_candidates.size());
+    for (auto index : _candidates)
+    {
+        auto circuitBreaker = _groupRoutingTable.nodeServices[index]->circuitBreaker();
+        if (!circuitBreaker->available())
         {
-            auto nodeService = m_nodeServiceList.at(_groupID).at(node->nodeName());
-            if (nodeService)
-            {
-                return nodeService;
-            }
+            continue;
+        }
+        if (circuitBreaker->trialRequired())
+        {
+            trialCandidates.emplace_back(index);
+            continue;
+        }
+        candidates.emplace_back(index);
+    }
+    // the trial request is acquired only by the ejected node selected to receive it
+    for (auto index : trialCandidates)
+    {
+        if (_groupRoutingTable.nodeServices[index]->circuitBreaker()->acquireTrial())
+        {
+            return std::vector<size_t>{index};
         }
     }
-    return nullptr;
+    return candidates;
 }
 
 NodeService::Ptr GroupManager::queryNodeService(
     std::string const& _groupID, std::string const& _nodeName) const
 {
-    ReadGuard l(x_nodeServiceList);
-    if (m_nodeServiceList.count(_groupID) && m_nodeServiceList.at(_groupID).count(_nodeName))
+    auto groupRoutingTable = routingTable(_groupID);
+    if (!groupRoutingTable)
+    {
+        return nullptr;
+    }
+    auto it = groupRoutingTable->nodeIndex.find(_nodeName);
+    if (it == groupRoutingTable->nodeIndex.end())
     {
-        return m_nodeServiceList.at(_groupID).at(_nodeName);
+        return nullptr;
     }
-    return nullptr;
+    return groupRoutingTable->nodeServices[it->second];
 }
 
 NodeService::Ptr GroupManager::getNodeService(
@@ -162,96 +509,180 @@ void GroupManager::updateGroupStatus()
     {
         return;
     }
-    auto unreachableNodes = checkNodeStatus();
-    if (unreachableNodes.size() == 0)
+    if (!m_healthProber || m_healthProber->probing())
     {
         return;
     }
-    removeUnreachableNodeService(unreachableNodes);
-    removeGroupBlockInfo(unreachableNodes);
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> unreachableNodes;
+    auto probeTargets = collectProbeTargets(unreachableNodes);
+    // probe outside the lock, the timer thread never waits for the endpoints
+    m_healthProber->probe(std::move(probeTargets),
+        [this, unreachableNodes](ProbeResults&& _results) mutable {
+            for (auto const& result : _results)
+            {
+                if (result.reachable)
+                {
+                    continue;
+                }
+                auto const& target = result.target;
+                unreachableNodes[target.groupID][target.nodeName] = target.nodeService;
+            }
+            if (unreachableNodes.empty())
+            {
+                return;
+            }
+            removeUnreachableNodes(unreachableNodes);
+        });
 }
 
-std::map<std::string, std::set<std::string>> GroupManager::checkNodeStatus()
+std::vector<ProbeTarget> GroupManager::collectProbeTargets(
+    std::map<std::string, std::map<std::string, NodeService::Ptr>>& _unreachableNodes)
 {
-    ReadGuard l(x_nodeServiceList);
-    std::map<std::string, std::set<std::string>> unreachableNodes;
-    for (auto const& it : m_groupInfos)
-    {
-        bool groupInfoUpdated = false;
-        auto groupInfo = it.second;
-        auto groupID = groupInfo->groupID();
-        auto const& groupNodeList = groupInfo->nodeInfos();
-        for (auto const& nodeInfo : groupNodeList)
+    std::vector<ProbeTarget> probeTargets;
+    for (auto const& shard : m_groupShards)
+    {
+        ReadGuard l(shard->x_groups);
+        for (auto const& it : shard->groupInfos)
         {
-            if (!m_nodeServiceList.count(groupID) ||
-                !m_nodeServiceList[groupID].count(nodeInfo.first) ||
-                m_nodeServiceList[groupID][nodeInfo.first]->unreachable())
+            auto const& groupID = it.first;
+            auto nodeServicesIt = shard->nodeServiceList.find(groupID);
+            auto const& groupNodeList = it.second->nodeInfos();
+            for (auto const& nodeInfo : groupNodeList)
             {
-                groupInfo->removeNodeInfo(nodeInfo.second);
-                unreachableNodes[groupID].insert(nodeInfo.first);
-                groupInfoUpdated = true;
-                continue;
+                NodeService::Ptr nodeService = nullptr;
+                if (nodeServicesIt != shard->nodeServiceList.end())
+                {
+                    auto nodeServiceIt = nodeServicesIt->second.find(nodeInfo.first);
+                    if (nodeServiceIt != nodeServicesIt->second.end())
+                    {
+                        nodeService = nodeServiceIt->second;
+                    }
+                }
+                if (!nodeService)
+                {
+                    _unreachableNodes[groupID][nodeInfo.first] = nullptr;
+                    continue;
+                }
+                probeTargets.emplace_back(ProbeTarget{groupID, nodeInfo.first, nodeService});
             }
         }
-        // notify the updated groupInfo to the sdk
-        if (m_groupInfoNotifier && groupInfoUpdated)
-        {
-            m_groupInfoNotifier(groupInfo);
-        }
     }
-    return unreachableNodes;
+    return probeTargets;
 }
 
-void GroupManager::removeUnreachableNodeService(
-    std::map<std::string, std::set<std::string>> const& _unreachableNodes)
+void GroupManager::removeUnreachableNodes(
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> const& _unreachableNodes)
 {
-    WriteGuard l(x_nodeServiceList);
+    std::map<std::string, std::set<std::string>> removedNodes;
+    std::vector<bcos::group::GroupInfo::Ptr> updatedGroupInfos;
     for (auto const& it : _unreachableNodes)
     {
-        auto group = it.first;
-        if (!m_nodeServiceList.count(group))
+        auto const& group = it.first;
+        auto& shard = groupShard(group);
+        WriteGuard l(shard.x_groups);
+        auto groupInfoIt = shard.groupInfos.find(group);
+        if (groupInfoIt == shard.groupInfos.end())
         {
             continue;
         }
-        auto const& nodeList = it.second;
-        for (auto const& node : nodeList)
+        auto groupInfo = groupInfoIt->second;
+        auto nodeServicesIt = shard.nodeServiceList.find(group);
+        for (auto const& node : it.second)
+        {
+            NodeService::Ptr nodeService = nullptr;
+            if (nodeServicesIt != shard.nodeServiceList.end() &&
+                nodeServicesIt->second.count(node.first))
+            {
+                nodeService = nodeServicesIt->second[node.first];
+            }
+            // the node has been updated during the probing
+            if (nodeService != node.second)
+            {
+                continue;
+            }
+            auto nodeInfo = groupInfo->nodeInfo(node.first);
+            if (nodeInfo)
+            {
+                groupInfo->removeNodeInfo(nodeInfo);
+            }
+            if (nodeServicesIt != shard.nodeServiceList.end())
+            {
+                nodeServicesIt->second.erase(node.first);
+            }
+            removedNodes[group].insert(node.first);
+            BCOS_LOG(INFO) << LOG_DESC("GroupManager: removeUnreachableNodes")
+                           << LOG_KV("group", group) << LOG_KV("node", node.first);
+        }
+        if (nodeServicesIt != shard.nodeServiceList.end() && nodeServicesIt->second.empty())
         {
-            BCOS_LOG(INFO) << LOG_DESC("GroupManager: removeUnreachablNodeService")
-                           << LOG_KV("group", group) << LOG_KV("node", node);
-            m_nodeServiceList[group].erase(node);
+            shard.nodeServiceList.erase(nodeServicesIt);
         }
-        if (m_nodeServiceList[group].size() == 0)
+        if (removedNodes.count(group))
         {
-            m_nodeServiceList.erase(group);
+            updatedGroupInfos.emplace_back(groupInfo);
+            increaseGroupInfoVersionWithoutLock(shard, group);
+        }
+    }
+    if (removedNodes.empty())
+    {
+        return;
+    }
+    removeGroupBlockInfo(removedNodes);
+    std::set<std::string> updatedGroups;
+    for (auto const& it : removedNodes)
+    {
+        updatedGroups.insert(it.first);
+    }
+    publishRoutingTable(updatedGroups);
+    // notify the updated groupInfo to the sdk
+    if (m_groupInfoNotifier)
+    {
+        for (auto const& groupInfo : updatedGroupInfos)
+        {
+            m_groupInfoNotifier(groupInfo);
         }
     }
 }
+
 void GroupManager::removeGroupBlockInfo(
     std::map<std::string, std::set<std::string>> const& _unreachableNodes)
 {
-    WriteGuard l(x_groupBlockInfos);
     for (auto const& it : _unreachableNodes)
     {
-        auto group = it.first;
-        if (!m_nodesWithLatestBlockNumber.count(group))
-        {
-            m_groupBlockInfos.erase(group);
-            continue;
-        }
-        if (!m_groupBlockInfos.count(group))
+        auto const& groupID = it.first;
+        auto groupBlockHead = blockHead(groupID);
+        if (!groupBlockHead)
         {
-            m_nodesWithLatestBlockNumber.erase(group);
             continue;
         }
-        auto const& nodeList = it.second;
-        for (auto const& node : nodeList)
+        groupBlockHead->removeNodes(it.second);
+        // the group without any node
+        auto& shard = groupShard(groupID);
+        bool hasNodes = false;
         {
-            m_nodesWithLatestBlockNumber[group].erase(node);
+            ReadGuard l(shard.x_groups);
+            hasNodes = shard.nodeServiceList.count(groupID) > 0;
         }
-        if (m_nodesWithLatestBlockNumber[group].size() == 0)
+        if (!hasNodes)
         {
-            m_groupBlockInfos.erase(group);
-            m_nodesWithLatestBlockNumber.erase(group);
+            removeBlockHead(groupID);
         }
     }
+}
+
+void GroupManager::removeBlockHead(std::string const& _groupID)
+{
+    auto& shard = groupShard(_groupID);
+    Guard l(shard.x_blockHeads);
+    auto groupBlockHeads = std::atomic_load(&shard.blockHeads);
+    if (!groupBlockHeads->count(_groupID))
+    {
+        return;
+    }
+    auto updatedBlockHeads = std::make_shared<GroupBlockHeads>(*groupBlockHeads);
+    updatedBlockHeads->erase(_groupID);
+    std::atomic_store(&shard.blockHeads,
+        std::shared_ptr<const GroupBlockHeads>(std::move(updatedBlockHeads)));
+    BCOS_LOG(INFO) << LOG_DESC("GroupManager: remove the block head of the group without nodes")
+                   << LOG_KV("group", _groupID);
 }
\ No newline at end of file
@@ -19,19 +19,103 @@
  * @date 2021-10-11
  */
 #pragma once
+#include "GroupBlockHead.h"
+#include "NodeHealthProber.h"
+#include "NodeSelector.h"
 #include "NodeService.h"
 #include <bcos-framework/libutilities/Timer.h>
+#include <unordered_map>
 namespace bcos
 {
 namespace rpc
 {
+// the immutable routing information of a group, rebuilt and replaced as a whole when changed
+struct GroupRoutingTable
+{
+    using Ptr = std::shared_ptr<GroupRoutingTable>;
+    using ConstPtr = std::shared_ptr<const GroupRoutingTable>;
+
+    std::vector<NodeService::Ptr> nodeServices;
+    std::vector<std::string> nodeNames;
+    // nodeName => the index of nodeServices
+    std::unordered_map<std::string, size_t> nodeIndex;
+    // the indexes of the started nodes of the group, selected when no node with the highest block
+    std::vector<size_t> availableNodes;
+    // the highest block of the group, shared with the GroupManager and updated without republish
+    GroupBlockHead::Ptr blockHead;
+    // the bit of nodeServices[i] in the blockHead, -1 if the node is not tracked
+    std::vector<int32_t> nodeBits;
+
+    bcos::protocol::BlockNumber blockNumber() const
+    {
+        return blockHead ? blockHead->blockNumber() : -1;
+    }
+    // the indexes of the nodes with the highest block
+    std::vector<size_t> latestNodes() const
+    {
+        std::vector<size_t> nodes;
+        if (!blockHead)
+        {
+            return nodes;
+        }
+        auto latestNodeBits = blockHead->latestNodes();
+        for (size_t i = 0; i < nodeBits.size() && latestNodeBits; i++)
+        {
+            if (nodeBits[i] >= 0 && ((latestNodeBits >> nodeBits[i]) & 1))
+            {
+                nodes.emplace_back(i);
+            }
+        }
+        return nodes;
+    }
+};
+using RoutingTable = std::unordered_map<std::string, GroupRoutingTable::ConstPtr>;
+using GroupBlockHeads = std::unordered_map<std::string, GroupBlockHead::Ptr>;
+
+// the groups hashed into the same shard, each shard is protected by its own locks
+struct GroupShard
+{
+    using Ptr = std::shared_ptr<GroupShard>;
+    GroupShard()
+      : routingTable(std::make_shared<RoutingTable>()),
+        blockHeads(std::make_shared<GroupBlockHeads>())
+    {}
+
+    // map between groupID to groupInfo
+    std::map<std::string, bcos::group::GroupInfo::Ptr> groupInfos;
+    // map between nodeName to NodeService
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> nodeServiceList;
+    // groupID => the version of the groupInfo
+    std::map<std::string, uint64_t> groupInfoVersions;
+    // the groups with nodes, mirrored to the sorted started groups of the GroupManager
+    std::set<std::string> startedGroups;
+    mutable SharedMutex x_groups;
+
+    // the routing snapshot for getNodeService, replaced atomically by publishRoutingTable
+    std::shared_ptr<const RoutingTable> routingTable;
+    mutable Mutex x_routingTable;
+
+    // groupID => the block head, copied on write, which happens only when a new group is seen
+    std::shared_ptr<const GroupBlockHeads> blockHeads;
+    mutable Mutex x_blockHeads;
+};
+
 class GroupManager
 {
 public:
     using Ptr = std::shared_ptr<GroupManager>;
+    // the max number of the groups returned by a page of the group list
+    static constexpr size_t c_maxGroupPageSize = 1000;
+
     GroupManager(std::string const& _chainID, NodeServiceFactory::Ptr _nodeServiceFactory)
-      : m_chainID(_chainID), m_nodeServiceFactory(_nodeServiceFactory)
+      : m_chainID(_chainID),
+        m_nodeServiceFactory(_nodeServiceFactory),
+        m_sortedGroupIDs(std::make_shared<std::vector<std::string>>()),
+        m_sortedStartedGroupIDs(std::make_shared<std::vector<std::string>>()),
+        m_nodeSelector(std::make_shared<PowerOfTwoChoicesNodeSelector>()),
+        m_healthProber(std::make_shared<NodeHealthProber>())
     {
+        initGroupShards();
         m_startTime = utcTime();
         m_groupStatusUpdater = std::make_shared<Timer>(1000);
         m_groupStatusUpdater->start();
@@ -49,10 +133,12 @@ public:
 
     virtual bcos::group::GroupInfo::Ptr getGroupInfo(std::string const& _groupID)
     {
-        ReadGuard l(x_nodeServiceList);
-        if (m_groupInfos.count(_groupID))
+        auto const& shard = groupShard(_groupID);
+        ReadGuard l(shard.x_groups);
+        auto it = shard.groupInfos.find(_groupID);
+        if (it != shard.groupInfos.end())
         {
-            return m_groupInfos[_groupID];
+            return it->second;
         }
         return nullptr;
     }
@@ -60,82 +146,79 @@ public:
     virtual bcos::group::ChainNodeInfo::Ptr getNodeInfo(
         std::string const& _groupID, std::string const& _nodeName)
     {
-        ReadGuard l(x_nodeServiceList);
-        if (!m_groupInfos.count(_groupID))
+        auto groupInfo = getGroupInfo(_groupID);
+        if (!groupInfo)
         {
             return nullptr;
         }
-        auto groupInfo = m_groupInfos[_groupID];
         return groupInfo->nodeInfo(_nodeName);
     }
 
+    // the groups with nodes
     virtual std::set<std::string> groupList()
     {
-        std::set<std::string> groupList;
-        ReadGuard l(x_nodeServiceList);
-        for (auto const& it : m_groupInfos)
-        {
-            if (it.second->nodesNum() == 0)
-            {
-                continue;
-            }
-            groupList.insert(it.first);
-        }
-        return groupList;
+        auto groupIDs = sortedStartedGroupIDs();
+        return std::set<std::string>(groupIDs->begin(), groupIDs->end());
     }
 
+    // the pointers to all the group info, the GroupInfoCache walks sortedGroupIDs instead
     virtual std::vector<bcos::group::GroupInfo::Ptr> groupInfoList()
     {
         std::vector<bcos::group::GroupInfo::Ptr> groupList;
-        ReadGuard l(x_nodeServiceList);
-        for (auto const& it : m_groupInfos)
+        for (auto const& shard : m_groupShards)
         {
-            groupList.push_back(it.second);
+            ReadGuard l(shard->x_groups);
+            for (auto const& it : shard->groupInfos)
+            {
+                groupList.push_back(it.second);
+            }
         }
         return groupList;
     }
 
-    virtual void updateGroupBlockInfo(std::string const& _groupID, std::string const& _nodeName,
-        bcos::protocol::BlockNumber _blockNumber)
+    // the groups in ascending order of the groupID, copied on write when a group is added
+    virtual std::shared_ptr<const std::vector<std::string>> sortedGroupIDs() const
     {
-        UpgradableGuard l(x_groupBlockInfos);
-        if (m_groupBlockInfos.count(_groupID))
-        {
-            // expired block
-            if (m_groupBlockInfos[_groupID] > _blockNumber)
-            {
-                return;
-            }
-            // has already in the m_nodesWithLatestBlockNumber
-            if (m_groupBlockInfos[_groupID] == _blockNumber &&
-                m_nodesWithLatestBlockNumber.count(_groupID) &&
-                m_nodesWithLatestBlockNumber[_groupID].count(_nodeName))
-            {
-                return;
-            }
-        }
-        UpgradeGuard ul(l);
-        bcos::protocol::BlockNumber oldBlockNumber = 0;
-        if (m_groupBlockInfos.count(_groupID))
-        {
-            oldBlockNumber = m_groupBlockInfos[_groupID];
-        }
-        if (!m_nodesWithLatestBlockNumber.count(_groupID))
-        {
-            m_nodesWithLatestBlockNumber[_groupID] = std::set<std::string>();
-        }
-        // nodes with newer highest block
-        if (oldBlockNumber < _blockNumber)
+        return std::atomic_load(&m_sortedGroupIDs);
+    }
+    // the groups with nodes in ascending order of the groupID, copied on write only when a group
+    // gets its first node or loses its last node
+    virtual std::shared_ptr<const std::vector<std::string>> sortedStartedGroupIDs() const
+    {
+        return std::atomic_load(&m_sortedStartedGroupIDs);
+    }
+
+    /**
+     * @brief query a page of the groups started with _prefix in ascending order of the groupID
+     *
+     * @param _prefix the prefix of the groupID, empty means all the groups
+     * @param _offset the offset of the first group in the matched groups
+     * @param _limit the max number of the returned groups, at most c_maxGroupPageSize
+     * @param _onlyStarted only the groups with started nodes are matched if true
+     * @param _total the number of the matched groups
+     * @return the groupIDs of the page
+     */
+    virtual std::vector<std::string> queryGroupList(std::string const& _prefix, size_t _offset,
+        size_t _limit, bool _onlyStarted, size_t& _total);
+
+    // the version of the group info, increased when the group info is updated or the nodes of the
+    // group are removed, used to invalidate the cached json of the group info
+    virtual uint64_t groupInfoVersion(std::string const& _groupID) const
+    {
+        auto const& shard = groupShard(_groupID);
+        ReadGuard l(shard.x_groups);
+        auto it = shard.groupInfoVersions.find(_groupID);
+        if (it == shard.groupInfoVersions.end())
         {
-            m_groupBlockInfos[_groupID] = _blockNumber;
-            m_nodesWithLatestBlockNumber[_groupID].clear();
+            return 0;
         }
-        // nodes with the same highest block
-        (m_nodesWithLatestBlockNumber[_groupID]).insert(_nodeName);
-        BCOS_LOG(DEBUG) << LOG_DESC("updateGroupBlockInfo for receive block notify")
-                        << LOG_KV("group", _groupID) << LOG_KV("node", _nodeName)
-                        << LOG_KV("block", _blockNumber);
+        return it->second;
     }
+    // increased when the info of any group is updated
+    virtual uint64_t groupInfoListVersion() const { return m_groupInfoListVersion.load(); }
+
+    virtual void updateGroupBlockInfo(std::string const& _groupID, std::string const& _nodeName,
+        bcos::protocol::BlockNumber _blockNumber);
 
     virtual void registerGroupInfoNotifier(
         std::function<void(bcos::group::GroupInfo::Ptr)> _callback)
@@ -143,47 +226,122 @@ public:
         m_groupInfoNotifier = _callback;
     }
 
+    // register the handler called when the highest block number of a group has been increased
+    virtual void registerBlockNumberNotifier(
+        std::function<void(std::string const&, bcos::protocol::BlockNumber)> _callback)
+    {
+        m_blockNumberNotifiers.emplace_back(_callback);
+    }
+
     virtual bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string& _groupID);
 
+    // select another node with the highest block, return nullptr if no such node
+    virtual NodeService::Ptr selectNodeExcept(
+        std::string const& _groupID, NodeService::Ptr _excludedNode) const;
+
+    // the policy to select the node for the requests without specified node
+    NodeSelector::Ptr nodeSelector() const { return std::atomic_load(&m_nodeSelector); }
+    void setNodeSelector(NodeSelector::Ptr _nodeSelector)
+    {
+        std::atomic_store(&m_nodeSelector, _nodeSelector);
+    }
+
 protected:
-    GroupManager(std::string const& _chainID) : m_chainID(_chainID) {}
+    GroupManager(std::string const& _chainID)
+      : m_chainID(_chainID),
+        m_sortedGroupIDs(std::make_shared<std::vector<std::string>>()),
+        m_sortedStartedGroupIDs(std::make_shared<std::vector<std::string>>()),
+        m_nodeSelector(std::make_shared<PowerOfTwoChoicesNodeSelector>())
+    {
+        initGroupShards();
+    }
     virtual void updateGroupStatus();
 
-    void updateNodeServiceWithoutLock(
-        std::string const& _groupID, bcos::group::ChainNodeInfo::Ptr _nodeInfo);
+    void initGroupShards()
+    {
+        for (size_t i = 0; i < c_groupShardNum; i++)
+        {
+            m_groupShards.emplace_back(std::make_shared<GroupShard>());
+        }
+    }
+    GroupShard& groupShard(std::string const& _groupID) const
+    {
+        return *m_groupShards[std::hash<std::string>{}(_groupID) % m_groupShards.size()];
+    }
 
+    // add the node service built outside the lock, return false if the node service existed or
+    // the group has been removed
+    bool addNodeServiceWithoutLock(GroupShard& _shard, std::string const& _groupID,
+        bcos::group::ChainNodeInfo::Ptr _nodeInfo, NodeService::Ptr _nodeService);
+    // called with the write lock of the shard whenever the group info is updated
+    void increaseGroupInfoVersionWithoutLock(GroupShard& _shard, std::string const& _groupID)
+    {
+        _shard.groupInfoVersions[_groupID]++;
+        m_groupInfoListVersion++;
+        updateStartedGroupWithoutLock(_shard, _groupID);
+    }
+    // insert the new group into m_sortedGroupIDs
+    void addSortedGroupID(std::string const& _groupID);
+    // update the started flag of the group in the shard and m_sortedStartedGroupIDs when the group
+    // gets its first node or loses its last node
+    void updateStartedGroupWithoutLock(GroupShard& _shard, std::string const& _groupID);
 
     virtual NodeService::Ptr selectNode(std::string const& _groupID) const;
     virtual std::string selectNodeByBlockNumber(std::string const& _groupID) const;
     virtual NodeService::Ptr selectNodeRandomly(std::string const& _groupID) const;
+    // the candidates not ejected by the circuit breaker, only the node granted the trial request
+    // is returned if exists
+    std::vector<size_t> availableCandidates(
+        GroupRoutingTable const& _groupRoutingTable, std::vector<size_t> const& _candidates) const;
     virtual NodeService::Ptr queryNodeService(
         std::string const& _groupID, std::string const& _nodeName) const;
     virtual void removeGroupBlockInfo(
         std::map<std::string, std::set<std::string>> const& _unreachableNodes);
-    virtual void removeUnreachableNodeService(
-        std::map<std::string, std::set<std::string>> const& _unreachableNodes);
-    virtual std::map<std::string, std::set<std::string>> checkNodeStatus();
+    // collect the nodes to be probed, the nodes without NodeService are unreachable directly
+    virtual std::vector<ProbeTarget> collectProbeTargets(
+        std::map<std::string, std::map<std::string, NodeService::Ptr>>& _unreachableNodes);
+    // remove the unreachable nodes that have not been updated during the probing
+    virtual void removeUnreachableNodes(
+        std::map<std::string, std::map<std::string, NodeService::Ptr>> const& _unreachableNodes);
+    void notifyBlockNumber(std::string const& _groupID, bcos::protocol::BlockNumber _blockNumber);
+
+    // get the routing table of the group without lock, return nullptr if not exists
+    GroupRoutingTable::ConstPtr routingTable(std::string const& _groupID) const;
+    // rebuild the routing table of the groups from the shards of the groups
+    void publishRoutingTable(std::set<std::string> const& _groups);
+
+    // get the block head of the group without lock, return nullptr if not exists
+    GroupBlockHead::Ptr blockHead(std::string const& _groupID) const;
+    // remove the block head of the group without any node
+    void removeBlockHead(std::string const& _groupID);
+    GroupBlockHead::Ptr getOrCreateBlockHead(std::string const& _groupID, bool& _created);
 
 protected:
     std::string m_chainID;
     NodeServiceFactory::Ptr m_nodeServiceFactory;
 
-    // map between groupID to groupInfo
-    std::map<std::string, bcos::group::GroupInfo::Ptr> m_groupInfos;
+    // the groups are hash-sharded to avoid the contention and the full copy of the groups
+    static constexpr size_t c_groupShardNum = 32;
+    std::vector<GroupShard::Ptr> m_groupShards;
+    std::atomic<uint64_t> m_groupInfoListVersion = {0};
 
-    // map between nodeName to NodeService
-    std::map<std::string, std::map<std::string, NodeService::Ptr>> m_nodeServiceList;
-    mutable SharedMutex x_nodeServiceList;
+    std::shared_ptr<const std::vector<std::string>> m_sortedGroupIDs;
+    std::shared_ptr<const std::vector<std::string>> m_sortedStartedGroupIDs;
+    // serialize the writers of m_sortedGroupIDs and m_sortedStartedGroupIDs
+    Mutex x_sortedGroupIDs;
 
-    std::map<std::string, std::set<std::string>> m_nodesWithLatestBlockNumber;
-    std::map<std::string, bcos::protocol::BlockNumber> m_groupBlockInfos;
-    mutable SharedMutex x_groupBlockInfos;
+    NodeSelector::Ptr m_nodeSelector;
 
     std::shared_ptr<Timer> m_groupStatusUpdater;
     std::function<void(bcos::group::GroupInfo::Ptr)> m_groupInfoNotifier;
+    std::vector<std::function<void(std::string const&, bcos::protocol::BlockNumber)>>
+        m_blockNumberNotifiers;
 
     uint64_t c_tarsAdminRefreshInitTime = 120 * 1000;
     uint64_t m_startTime = 0;
+
+    // declared last to stop the probes before the other members are destroyed
+    NodeHealthProber::Ptr m_healthProber;
 };
 }  // namespace rpc
 }  // namespace bcos
\ No newline at end of file
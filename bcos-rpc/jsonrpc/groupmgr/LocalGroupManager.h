@@ -69,9 +69,32 @@ public:
         return m_groupInfo->nodeInfo(_nodeName);
     }
 
-    void updateGroupBlockInfo(
-        std::string const&, std::string const&, bcos::protocol::BlockNumber) override
-    {}
+    void updateGroupBlockInfo(std::string const& _groupID, std::string const&,
+        bcos::protocol::BlockNumber _blockNumber) override
+    {
+        if (_groupID != m_groupInfo->groupID())
+        {
+            return;
+        }
+        auto currentBlockNumber = m_blockNumber.load();
+        while (currentBlockNumber < _blockNumber)
+        {
+            if (m_blockNumber.compare_exchange_weak(currentBlockNumber, _blockNumber))
+            {
+                notifyBlockNumber(_groupID, _blockNumber);
+                return;
+            }
+        }
+    }
+
+    bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string& _groupID) override
+    {
+        if (_groupID != m_groupInfo->groupID())
+        {
+            return -1;
+        }
+        return m_blockNumber.load();
+    }
 
     std::vector<bcos::group::GroupInfo::Ptr> groupInfoList() override
     {
@@ -80,9 +103,24 @@ public:
         return groupList;
     }
 
+    std::shared_ptr<const std::vector<std::string>> sortedGroupIDs() const override
+    {
+        return std::make_shared<std::vector<std::string>>(1, m_groupInfo->groupID());
+    }
+
+    std::shared_ptr<const std::vector<std::string>> sortedStartedGroupIDs() const override
+    {
+        if (m_groupInfo->nodesNum() == 0)
+        {
+            return std::make_shared<std::vector<std::string>>();
+        }
+        return sortedGroupIDs();
+    }
+
 private:
     NodeService::Ptr m_nodeService;
     bcos::group::GroupInfo::Ptr m_groupInfo;
+    std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {-1};
 };
 }  // namespace rpc
 }  // namespace bcos
\ No newline at end of file
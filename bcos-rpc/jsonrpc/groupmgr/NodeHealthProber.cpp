@@ -0,0 +1,258 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief probe the endpoints of the node services concurrently
+ * @file NodeHealthProber.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include "NodeHealthProber.h"
+#include <bcos-framework/libutilities/Log.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <chrono>
+#include <sstream>
+using namespace bcos;
+using namespace bcos::rpc;
+
+struct NodeHealthProber::ProbeRound
+{
+    ProbeResults results;
+    std::chrono::steady_clock::time_point startTime;
+    std::function<void(ProbeResults&&)> onFinished;
+
+    Mutex x_round;
+    // the probes answered before the round finished
+    std::vector<bool> answered;
+    size_t remaining = 0;
+    bool finished = false;
+};
+
+namespace
+{
+uint64_t elapsedUs(std::chrono::steady_clock::time_point const& _startTime)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startTime)
+        .count();
+}
+}  // namespace
+
+NodeHealthProber::NodeHealthProber(size_t _threadNum, uint64_t _probeTimeout)
+  : m_pool(std::make_shared<ThreadPool>("nodeProber", _threadNum)), m_threadNum(_threadNum)
+{
+    m_probeTimer = std::make_shared<Timer>(_probeTimeout, "probeTimer");
+    m_probeTimer->registerTimeoutHandler([this]() { onProbeTimeout(); });
+}
+
+NodeHealthProber::~NodeHealthProber()
+{
+    if (m_probeTimer)
+    {
+        m_probeTimer->stop();
+    }
+}
+
+bool NodeHealthProber::probe(
+    std::vector<ProbeTarget> _targets, std::function<void(ProbeResults&&)> _onFinished)
+{
+    // the endpoint queries of the timed out probes still occupy the threads
+    if (m_pendingProbes.load() >= m_threadNum)
+    {
+        BCOS_LOG(WARNING) << LOG_DESC("NodeHealthProber: all the threads are blocked")
+                          << LOG_KV("pendingProbes", m_pendingProbes.load());
+        return false;
+    }
+    bool expected = false;
+    if (!m_probing.compare_exchange_strong(expected, true))
+    {
+        BCOS_LOG(DEBUG) << LOG_DESC("NodeHealthProber: the last round has not finished")
+                        << LOG_KV("lastRoundLatency", m_lastRoundLatency.load());
+        return false;
+    }
+    auto round = std::make_shared<ProbeRound>();
+    round->startTime = std::chrono::steady_clock::now();
+    round->onFinished = std::move(_onFinished);
+    round->results.resize(_targets.size());
+    round->answered.resize(_targets.size(), false);
+    round->remaining = _targets.size();
+    if (_targets.empty())
+    {
+        round->finished = true;
+        finishRound(round, 0);
+        return true;
+    }
+    {
+        Guard l(x_round);
+        m_round = round;
+    }
+    m_probeTimer->restart();
+    auto self = std::weak_ptr<NodeHealthProber>(shared_from_this());
+    for (size_t i = 0; i < _targets.size(); i++)
+    {
+        auto nodeService = _targets[i].nodeService;
+        auto groupID = _targets[i].groupID;
+        auto nodeName = _targets[i].nodeName;
+        round->results[i].target = std::move(_targets[i]);
+        m_pendingProbes++;
+        // the results are only written under the lock of the round, the probe answering after
+        // the timeout is dropped
+        m_pool->enqueue([self, round, i, nodeService, groupID, nodeName]() {
+            auto probeStartTime = std::chrono::steady_clock::now();
+            bool reachable = false;
+            try
+            {
+                reachable = !nodeService->unreachable();
+            }
+            catch (std::exception const& e)
+            {
+                BCOS_LOG(WARNING) << LOG_DESC("NodeHealthProber: probe exception")
+                                  << LOG_KV("group", groupID) << LOG_KV("node", nodeName)
+                                  << LOG_KV("error", boost::diagnostic_information(e));
+            }
+            auto prober = self.lock();
+            if (!prober)
+            {
+                return;
+            }
+            prober->m_pendingProbes--;
+            prober->onProbeFinished(round, i, reachable, elapsedUs(probeStartTime));
+        });
+    }
+    return true;
+}
+
+void NodeHealthProber::onProbeFinished(
+    std::shared_ptr<ProbeRound> _round, size_t _index, bool _reachable, uint64_t _latency)
+{
+    {
+        Guard l(_round->x_round);
+        if (_round->finished)
+        {
+            return;
+        }
+        _round->results[_index].reachable = _reachable;
+        _round->results[_index].latency = _latency;
+        _round->answered[_index] = true;
+        if (--_round->remaining > 0)
+        {
+            return;
+        }
+        _round->finished = true;
+    }
+    finishRound(_round, 0);
+}
+
+void NodeHealthProber::onProbeTimeout()
+{
+    std::shared_ptr<ProbeRound> round;
+    {
+        Guard l(x_round);
+        round = m_round;
+    }
+    if (!round)
+    {
+        return;
+    }
+    size_t timedOutProbes = 0;
+    {
+        Guard l(round->x_round);
+        if (round->finished)
+        {
+            return;
+        }
+        round->finished = true;
+        auto latency = elapsedUs(round->startTime);
+        for (size_t i = 0; i < round->results.size(); i++)
+        {
+            if (round->answered[i])
+            {
+                continue;
+            }
+            // the node without answer is kept, it is removed only when found unreachable
+            auto& result = round->results[i];
+            result.timedOut = true;
+            result.latency = latency;
+            timedOutProbes++;
+            BCOS_LOG(WARNING) << LOG_DESC("NodeHealthProber: probe timeout")
+                              << LOG_KV("group", result.target.groupID)
+                              << LOG_KV("node", result.target.nodeName)
+                              << LOG_KV("latency(us)", latency);
+        }
+    }
+    finishRound(round, timedOutProbes);
+}
+
+void NodeHealthProber::finishRound(std::shared_ptr<ProbeRound> _round, size_t _timedOutProbes)
+{
+    {
+        Guard l(x_round);
+        if (m_round == _round)
+        {
+            m_round.reset();
+        }
+    }
+    onRoundFinished(_round->results, elapsedUs(_round->startTime), _timedOutProbes);
+    // the next round starts only after the results of this round are applied
+    try
+    {
+        _round->onFinished(std::move(_round->results));
+    }
+    catch (std::exception const& e)
+    {
+        BCOS_LOG(WARNING) << LOG_DESC("NodeHealthProber: apply the probe results exception")
+                          << LOG_KV("error", boost::diagnostic_information(e));
+    }
+    m_probing.store(false);
+}
+
+void NodeHealthProber::onRoundFinished(
+    ProbeResults const& _results, uint64_t _roundLatency, size_t _timedOutProbes)
+{
+    uint64_t maxLatency = 0;
+    uint64_t totalLatency = 0;
+    size_t unreachableNodes = 0;
+    for (auto const& result : _results)
+    {
+        maxLatency = std::max(maxLatency, result.latency);
+        totalLatency += result.latency;
+        if (!result.reachable)
+        {
+            unreachableNodes++;
+        }
+    }
+    m_lastRoundLatency.store(_roundLatency);
+    m_lastMaxProbeLatency.store(maxLatency);
+    m_lastAvgProbeLatency.store(_results.empty() ? 0 : totalLatency / _results.size());
+    m_timedOutProbes += _timedOutProbes;
+    auto probeRounds = ++m_probeRounds;
+    // report the metrics periodically, and every round with the unhealthy nodes
+    auto report = (probeRounds % c_reportRounds == 0) || unreachableNodes > 0 ||
+                   _timedOutProbes > 0;
+    std::stringstream metrics;
+    metrics << LOG_DESC("NodeHealthProber: probe finished") << LOG_KV("rounds", probeRounds)
+            << LOG_KV("nodes", _results.size()) << LOG_KV("unreachable", unreachableNodes)
+            << LOG_KV("timedOut", _timedOutProbes)
+            << LOG_KV("totalTimedOut", m_timedOutProbes.load())
+            << LOG_KV("pendingProbes", m_pendingProbes.load())
+            << LOG_KV("roundLatency(us)", _roundLatency)
+            << LOG_KV("maxProbeLatency(us)", maxLatency)
+            << LOG_KV("avgProbeLatency(us)", m_lastAvgProbeLatency.load());
+    if (report)
+    {
+        BCOS_LOG(INFO) << metrics.str();
+        return;
+    }
+    BCOS_LOG(DEBUG) << metrics.str();
+}
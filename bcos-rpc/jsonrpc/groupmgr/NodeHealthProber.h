@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief probe the endpoints of the node services concurrently
+ * @file NodeHealthProber.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include "NodeService.h"
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <atomic>
+#include <functional>
+namespace bcos
+{
+namespace rpc
+{
+struct ProbeTarget
+{
+    std::string groupID;
+    std::string nodeName;
+    NodeService::Ptr nodeService;
+};
+
+struct ProbeResult
+{
+    ProbeTarget target;
+    bool reachable = true;
+    // no answer within the probe timeout, the reachability of the node is unknown
+    bool timedOut = false;
+    // the latency of the probe in microseconds
+    uint64_t latency = 0;
+};
+using ProbeResults = std::vector<ProbeResult>;
+
+/**
+ * @brief probe the nodes on the thread pool so that the slow endpoint queries neither block the
+ * caller nor hold any lock of the GroupManager, only one round of probes is in flight at a time,
+ * the round is finished when all the probes answered or the probe timeout expired, and the next
+ * round can start after the results of the round are passed to the callback
+ */
+class NodeHealthProber : public std::enable_shared_from_this<NodeHealthProber>
+{
+public:
+    using Ptr = std::shared_ptr<NodeHealthProber>;
+    // _probeTimeout: the max time of a round in ms
+    explicit NodeHealthProber(size_t _threadNum = 8, uint64_t _probeTimeout = 1000);
+    virtual ~NodeHealthProber();
+
+    // probe all the targets concurrently, _onFinished is called with the results of all the
+    // targets, return false if the last round has not finished yet or the threads are all blocked
+    // by the timed out probes
+    virtual bool probe(
+        std::vector<ProbeTarget> _targets, std::function<void(ProbeResults&&)> _onFinished);
+
+    bool probing() const { return m_probing.load(); }
+    // the metrics of the finished rounds, reported by the log periodically
+    uint64_t probeRounds() const { return m_probeRounds.load(); }
+    // the time cost of the whole round in microseconds
+    uint64_t lastRoundLatency() const { return m_lastRoundLatency.load(); }
+    // the max and average latency of the probes in microseconds
+    uint64_t lastMaxProbeLatency() const { return m_lastMaxProbeLatency.load(); }
+    uint64_t lastAvgProbeLatency() const { return m_lastAvgProbeLatency.load(); }
+    // the total number of the probes without answer within the probe timeout
+    uint64_t timedOutProbes() const { return m_timedOutProbes.load(); }
+    // the probes still blocking the threads of the pool
+    size_t pendingProbes() const { return m_pendingProbes.load(); }
+
+protected:
+    struct ProbeRound;
+    void onProbeFinished(std::shared_ptr<ProbeRound> _round, size_t _index, bool _reachable,
+        uint64_t _latency);
+    void onProbeTimeout();
+    void finishRound(std::shared_ptr<ProbeRound> _round, size_t _timedOutProbes);
+    void onRoundFinished(
+        ProbeResults const& _results, uint64_t _roundLatency, size_t _timedOutProbes);
+
+private:
+    std::shared_ptr<ThreadPool> m_pool;
+    size_t m_threadNum;
+    std::shared_ptr<Timer> m_probeTimer;
+    std::atomic_bool m_probing = {false};
+    std::atomic<size_t> m_pendingProbes = {0};
+    // the round in flight, nullptr if no round is in flight
+    std::shared_ptr<ProbeRound> m_round;
+    mutable Mutex x_round;
+
+    std::atomic<uint64_t> m_probeRounds = {0};
+    std::atomic<uint64_t> m_lastRoundLatency = {0};
+    std::atomic<uint64_t> m_lastMaxProbeLatency = {0};
+    std::atomic<uint64_t> m_lastAvgProbeLatency = {0};
+    std::atomic<uint64_t> m_timedOutProbes = {0};
+    // the metrics are reported by the INFO log every c_reportRounds rounds
+    const uint64_t c_reportRounds = 60;
+};
+}  // namespace rpc
+}  // namespace bcos
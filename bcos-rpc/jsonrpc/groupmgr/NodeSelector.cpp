@@ -0,0 +1,64 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the policy to select the node to send the request
+ * @file NodeSelector.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include "NodeSelector.h"
+#include <algorithm>
+#include <random>
+using namespace bcos;
+using namespace bcos::rpc;
+
+size_t NodeSelector::random()
+{
+    static thread_local std::mt19937 randomEngine(std::random_device{}());
+    return randomEngine();
+}
+
+size_t RandomNodeSelector::select(
+    std::vector<NodeService::Ptr> const&, std::vector<size_t> const& _candidates)
+{
+    return _candidates[random() % _candidates.size()];
+}
+
+double PowerOfTwoChoicesNodeSelector::load(NodeService::Ptr const& _nodeService)
+{
+    // the node without latency samples is regarded as 1ms
+    auto latency = std::max(_nodeService->latencyEwma(), 1000.0);
+    auto outstandingRequests = std::max(_nodeService->outstandingRequests(), (int64_t)0);
+    return (double)(outstandingRequests + 1) * latency;
+}
+
+size_t PowerOfTwoChoicesNodeSelector::select(
+    std::vector<NodeService::Ptr> const& _nodeServices, std::vector<size_t> const& _candidates)
+{
+    if (_candidates.size() == 1)
+    {
+        return _candidates[0];
+    }
+    auto first = random() % _candidates.size();
+    // select another candidate different from the first one
+    auto second = (first + 1 + random() % (_candidates.size() - 1)) % _candidates.size();
+    auto firstIndex = _candidates[first];
+    auto secondIndex = _candidates[second];
+    if (load(_nodeServices[secondIndex]) < load(_nodeServices[firstIndex]))
+    {
+        return secondIndex;
+    }
+    return firstIndex;
+}
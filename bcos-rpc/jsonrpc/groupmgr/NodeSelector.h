@@ -0,0 +1,69 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the policy to select the node to send the request
+ * @file NodeSelector.h
+ * @author: agent
+ * @date 2026-10-18
+ */
+#pragma once
+#include "NodeService.h"
+#include <vector>
+namespace bcos
+{
+namespace rpc
+{
+class NodeSelector
+{
+public:
+    using Ptr = std::shared_ptr<NodeSelector>;
+    NodeSelector() = default;
+    virtual ~NodeSelector() {}
+
+    /**
+     * @brief select a node from the candidates
+     *
+     * @param _nodeServices all the nodes of the group
+     * @param _candidates the indexes of the candidate nodes in _nodeServices, must not be empty
+     * @return size_t the index of the selected node in _nodeServices
+     */
+    virtual size_t select(std::vector<NodeService::Ptr> const& _nodeServices,
+        std::vector<size_t> const& _candidates) = 0;
+
+protected:
+    static size_t random();
+};
+
+// select the candidate randomly
+class RandomNodeSelector : public NodeSelector
+{
+public:
+    size_t select(std::vector<NodeService::Ptr> const& _nodeServices,
+        std::vector<size_t> const& _candidates) override;
+};
+
+// pick two candidates randomly and select the less loaded one
+class PowerOfTwoChoicesNodeSelector : public NodeSelector
+{
+public:
+    size_t select(std::vector<NodeService::Ptr> const& _nodeServices,
+        std::vector<size_t> const& _candidates) override;
+
+private:
+    // the expected cost of the node to process a new request
+    static double load(NodeService::Ptr const& _nodeService);
+};
+}  // namespace rpc
+}  // namespace bcos
@@ -27,69 +27,108 @@
 #include <bcos-tars-protocol/client/SchedulerServiceClient.h>
 #include <bcos-tars-protocol/client/TxPoolServiceClient.h>
 #include <tarscpp/servant/Application.h>
+#include <future>
 using namespace bcos;
 using namespace bcos::rpc;
 using namespace bcos::crypto;
 using namespace bcos::group;
 using namespace bcos::protocol;
 
-NodeService::Ptr NodeServiceFactory::buildNodeService(
-    std::string const&, std::string const&, bcos::group::ChainNodeInfo::Ptr _nodeInfo)
+BlockFactory::Ptr NodeServiceFactory::getOrCreateBlockFactory(bool _smCryptoType)
 {
-    auto appName = _nodeInfo->nodeName();
-    // create cryptoSuite
-    auto const& type = _nodeInfo->nodeType();
-    CryptoSuite::Ptr cryptoSuite = nullptr;
-    if (type == NodeType::SM_NODE)
-    {
-        cryptoSuite = createSMCryptoSuite();
-    }
-    else
+    Guard l(x_blockFactory);
+    auto& blockFactory = _smCryptoType ? m_smBlockFactory : m_blockFactory;
+    if (blockFactory)
     {
-        cryptoSuite = createCryptoSuite();
+        return blockFactory;
     }
+    // create cryptoSuite
+    auto cryptoSuite = _smCryptoType ? createSMCryptoSuite() : createCryptoSuite();
     auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
     cryptoSuite->setKeyFactory(keyFactory);
+    blockFactory = createBlockFactory(cryptoSuite);
+    return blockFactory;
+}
 
-    auto blockFactory = createBlockFactory(cryptoSuite);
-    auto ledgerClient = createServicePrx<bcostars::LedgerServiceClient, bcostars::LedgerServicePrx>(
-        LEDGER, _nodeInfo, blockFactory);
-    if (!ledgerClient.first)
-    {
-        return nullptr;
-    }
-    auto schedulerClient =
-        createServicePrx<bcostars::SchedulerServiceClient, bcostars::SchedulerServicePrx>(
-            SCHEDULER, _nodeInfo, cryptoSuite);
-    if (!schedulerClient.first)
-    {
-        return nullptr;
-    }
-    // create txpool client
-    auto txpoolClient = createServicePrx<bcostars::TxPoolServiceClient, bcostars::TxPoolServicePrx>(
-        TXPOOL, _nodeInfo, cryptoSuite, blockFactory);
-    if (!txpoolClient.first)
-    {
-        return nullptr;
-    }
+NodeService::Ptr NodeServiceFactory::buildNodeService(std::string const& _chainID,
+    std::string const& _groupID, bcos::group::ChainNodeInfo::Ptr _nodeInfo)
+{
+    return buildNodeServices(_chainID, _groupID, {_nodeInfo}).front();
+}
+
+namespace
+{
+template <typename T, typename S>
+using ServiceClient = std::future<std::pair<std::shared_ptr<T>, S>>;
 
-    // create consensus client
-    auto consensusClient = createServicePrx<bcostars::PBFTServiceClient, bcostars::PBFTServicePrx>(
-        CONSENSUS, _nodeInfo);
-    if (!consensusClient.first)
+struct NodeClients
+{
+    BlockFactory::Ptr blockFactory;
+    ServiceClient<bcostars::LedgerServiceClient, bcostars::LedgerServicePrx> ledger;
+    ServiceClient<bcostars::SchedulerServiceClient, bcostars::SchedulerServicePrx> scheduler;
+    ServiceClient<bcostars::TxPoolServiceClient, bcostars::TxPoolServicePrx> txpool;
+    ServiceClient<bcostars::PBFTServiceClient, bcostars::PBFTServicePrx> consensus;
+    ServiceClient<bcostars::BlockSyncServiceClient, bcostars::PBFTServicePrx> sync;
+};
+}  // namespace
+
+std::vector<NodeService::Ptr> NodeServiceFactory::buildNodeServices(std::string const&,
+    std::string const&, std::vector<bcos::group::ChainNodeInfo::Ptr> const& _nodeInfos)
+{
+    // create the service clients of all the nodes concurrently, the number of the threads is
+    // bounded by the pool however many nodes are started
+    std::vector<NodeClients> nodeClients(_nodeInfos.size());
+    for (size_t i = 0; i < _nodeInfos.size(); i++)
     {
-        return nullptr;
+        auto nodeInfo = _nodeInfos[i];
+        auto blockFactory = getOrCreateBlockFactory(nodeInfo->nodeType() == NodeType::SM_NODE);
+        auto cryptoSuite = blockFactory->cryptoSuite();
+        auto& clients = nodeClients[i];
+        clients.blockFactory = blockFactory;
+        clients.ledger = runOnPool([this, nodeInfo, blockFactory]() {
+            return createServicePrx<bcostars::LedgerServiceClient, bcostars::LedgerServicePrx>(
+                LEDGER, nodeInfo, blockFactory);
+        });
+        clients.scheduler = runOnPool([this, nodeInfo, cryptoSuite]() {
+            return createServicePrx<bcostars::SchedulerServiceClient,
+                bcostars::SchedulerServicePrx>(SCHEDULER, nodeInfo, cryptoSuite);
+        });
+        // create txpool client
+        clients.txpool = runOnPool([this, nodeInfo, cryptoSuite, blockFactory]() {
+            return createServicePrx<bcostars::TxPoolServiceClient, bcostars::TxPoolServicePrx>(
+                TXPOOL, nodeInfo, cryptoSuite, blockFactory);
+        });
+        // create consensus client
+        clients.consensus = runOnPool([this, nodeInfo]() {
+            return createServicePrx<bcostars::PBFTServiceClient, bcostars::PBFTServicePrx>(
+                CONSENSUS, nodeInfo);
+        });
+        // create sync client
+        clients.sync = runOnPool([this, nodeInfo]() {
+            return createServicePrx<bcostars::BlockSyncServiceClient, bcostars::PBFTServicePrx>(
+                CONSENSUS, nodeInfo);
+        });
     }
-    // create sync client
-    auto syncClient = createServicePrx<bcostars::BlockSyncServiceClient, bcostars::PBFTServicePrx>(
-        CONSENSUS, _nodeInfo);
-    if (!syncClient.first)
+    // wait for all the clients before return
+    std::vector<NodeService::Ptr> nodeServices;
+    for (auto& clients : nodeClients)
     {
-        return nullptr;
+        auto ledger = clients.ledger.get();
+        auto scheduler = clients.scheduler.get();
+        auto txpool = clients.txpool.get();
+        auto consensus = clients.consensus.get();
+        auto sync = clients.sync.get();
+        if (!ledger.first || !scheduler.first || !txpool.first || !consensus.first ||
+            !sync.first)
+        {
+            nodeServices.emplace_back(nullptr);
+            continue;
+        }
+        auto nodeService = std::make_shared<NodeService>(ledger.first, scheduler.first,
+            txpool.first, consensus.first, sync.first, clients.blockFactory);
+        nodeService->setLedgerPrx(ledger.second);
+        nodeService->circuitBreaker()->setConfig(m_circuitBreakerConfig);
+        nodeServices.emplace_back(nodeService);
     }
-    auto nodeService = std::make_shared<NodeService>(ledgerClient.first, schedulerClient.first,
-        txpoolClient.first, consensusClient.first, syncClient.first, blockFactory);
-
-    nodeService->setLedgerPrx(ledgerClient.second);
-    return nodeService;
-}
\ No newline at end of file
+    return nodeServices;
+}
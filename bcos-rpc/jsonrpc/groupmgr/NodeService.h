@@ -19,6 +19,7 @@
  * @date 2021-10-11
  */
 #pragma once
+#include "CircuitBreaker.h"
 #include <bcos-framework/interfaces/consensus/ConsensusInterface.h>
 #include <bcos-framework/interfaces/dispatcher/SchedulerInterface.h>
 #include <bcos-framework/interfaces/ledger/LedgerInterface.h>
@@ -28,8 +29,12 @@
 #include <bcos-framework/interfaces/protocol/ServiceDesc.h>
 #include <bcos-framework/interfaces/sync/BlockSyncInterface.h>
 #include <bcos-framework/interfaces/txpool/TxPoolInterface.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/ThreadPool.h>
 #include <bcos-tars-protocol/client/LedgerServiceClient.h>
 #include <tarscpp/servant/Application.h>
+#include <atomic>
+#include <future>
 namespace bcos
 {
 namespace rpc
@@ -69,6 +74,34 @@ public:
         return (activeEndPoints.size() == 0);
     }
 
+    // the load statistics used by the NodeSelector
+    void onRequestStart() { m_outstandingRequests++; }
+    void onRequestFinish(uint64_t _latencyUs, bool _failed)
+    {
+        m_outstandingRequests--;
+        m_circuitBreaker->onResult(_failed, _latencyUs);
+        // EWMA with weight 1/8 for the latest sample
+        auto latency = m_latencyEwma.load();
+        auto updatedLatency = latency + ((double)_latencyUs - latency) / 8;
+        while (!m_latencyEwma.compare_exchange_weak(latency, updatedLatency))
+        {
+            updatedLatency = latency + ((double)_latencyUs - latency) / 8;
+        }
+    }
+    // the request started by onRequestStart is dropped without the response
+    void onRequestCancel() { m_outstandingRequests--; }
+    // report the result of the request not started by onRequestStart to the circuit breaker
+    void onRequestResult(Error::Ptr const& _error, uint64_t _latencyUs)
+    {
+        m_circuitBreaker->onResult(CircuitBreaker::isNodeFailure(_error), _latencyUs);
+    }
+    int64_t outstandingRequests() const { return m_outstandingRequests.load(); }
+    // the moving average of the request latency in microseconds
+    double latencyEwma() const { return m_latencyEwma.load(); }
+
+    // the failing node is ejected from the node selection by the circuit breaker
+    CircuitBreaker::Ptr circuitBreaker() const { return m_circuitBreaker; }
+
 private:
     bcos::ledger::LedgerInterface::Ptr m_ledger;
     std::shared_ptr<bcos::scheduler::SchedulerInterface> m_scheduler;
@@ -78,16 +111,39 @@ private:
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
 
     bcostars::LedgerServicePrx m_ledgerPrx;
+
+    std::atomic<int64_t> m_outstandingRequests = {0};
+    std::atomic<double> m_latencyEwma = {0};
+    CircuitBreaker::Ptr m_circuitBreaker = std::make_shared<CircuitBreaker>();
 };
 
 class NodeServiceFactory
 {
 public:
     using Ptr = std::shared_ptr<NodeServiceFactory>;
-    NodeServiceFactory() = default;
+    // _threadNum: the max number of the service clients created at the same time
+    explicit NodeServiceFactory(size_t _threadNum = 8)
+      : m_pool(std::make_shared<ThreadPool>("nodeBuilder", _threadNum))
+    {}
     virtual ~NodeServiceFactory() {}
     NodeService::Ptr buildNodeService(std::string const& _chainID, std::string const& _groupID,
         bcos::group::ChainNodeInfo::Ptr _nodeInfo);
+    // the service clients of all the nodes are created concurrently on the thread pool shared by
+    // all the group updates, the nullptr is returned for the node missing any service, must not
+    // be called by the threads of the pool
+    virtual std::vector<NodeService::Ptr> buildNodeServices(std::string const& _chainID,
+        std::string const& _groupID,
+        std::vector<bcos::group::ChainNodeInfo::Ptr> const& _nodeInfos);
+
+    // the thresholds of the circuit breakers of the built node services
+    CircuitBreakerConfig const& circuitBreakerConfig() const { return m_circuitBreakerConfig; }
+    void setCircuitBreakerConfig(CircuitBreakerConfig const& _config)
+    {
+        m_circuitBreakerConfig = _config;
+    }
+
+    // the blockFactory(with the cryptoSuite) is stateless and shared by the nodes of the same type
+    bcos::protocol::BlockFactory::Ptr getOrCreateBlockFactory(bool _smCryptoType);
 
     template <typename T, typename S, typename... Args>
     std::pair<std::shared_ptr<T>, S> createServiceClient(
@@ -114,6 +170,25 @@ public:
         auto completedServiceName = bcos::protocol::getPrxDesc(serviceName, serviceObj);
         return createServiceClient<T, S>(completedServiceName, _args...);
     }
+
+protected:
+    // run the task on the pool, the exception of the task is rethrown by the future
+    template <typename F>
+    std::future<typename std::result_of<F()>::type> runOnPool(F _task)
+    {
+        auto task =
+            std::make_shared<std::packaged_task<typename std::result_of<F()>::type()>>(_task);
+        auto future = task->get_future();
+        m_pool->enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+private:
+    std::shared_ptr<ThreadPool> m_pool;
+    bcos::protocol::BlockFactory::Ptr m_blockFactory;
+    bcos::protocol::BlockFactory::Ptr m_smBlockFactory;
+    Mutex x_blockFactory;
+    CircuitBreakerConfig m_circuitBreakerConfig;
 };
 }  // namespace rpc
 }  // namespace bcos
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the block-scoped call result cache
+ * @file CallResultCacheTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/RpcConfig.h>
+#include <bcos-rpc/jsonrpc/CallResultCache.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+const std::string c_contract = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+bcos::crypto::HashType dataHash(char _c)
+{
+    return bcos::crypto::HashType(std::string(64, _c));
+}
+Json::Value callResult(std::string const& _output)
+{
+    Json::Value jResp;
+    jResp["blockNumber"] = 10;
+    jResp["status"] = 0;
+    jResp["output"] = _output;
+    return jResp;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CallResultCacheTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testHitAndExpire)
+{
+    auto cache = std::make_shared<CallResultCache>();
+    // optional, enabled by config
+    BOOST_CHECK(!cache->enabled());
+    cache->setEnabled(true);
+
+    Json::Value jResp;
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('1'), 10, jResp));
+    cache->insert("group0", c_contract, dataHash('1'), 10, callResult("0x01"));
+    // the address is compared case-insensitively
+    BOOST_CHECK(cache->get("group0", "0x6849F21D1E455E9F0712B1E99FA4FCD23758E8F1",
+        dataHash('1'), 10, jResp));
+    BOOST_CHECK_EQUAL(jResp["output"].asString(), "0x01");
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('2'), 10, jResp));
+    BOOST_CHECK(!cache->get("group1", c_contract, dataHash('1'), 10, jResp));
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('1'), 11, jResp));
+
+    // the results of the older block are never cached again
+    cache->insert("group0", c_contract, dataHash('2'), 9, callResult("0x02"));
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('2'), 9, jResp));
+
+    // all the results of the group are dropped by the new block
+    BOOST_CHECK(cache->size() > 0);
+    cache->onBlockNumberUpdated("group0", 11);
+    BOOST_CHECK_EQUAL(cache->size(), 0);
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('1'), 10, jResp));
+}
+
+BOOST_AUTO_TEST_CASE(testCapacity)
+{
+    auto cache = std::make_shared<CallResultCache>();
+    auto output = "0x" + std::string(1000, '0');
+    cache->setCapacity(4096);
+    for (char c = '0'; c <= '9'; c++)
+    {
+        cache->insert("group0", c_contract, dataHash(c), 10, callResult(output));
+    }
+    BOOST_CHECK(cache->size() <= cache->capacity());
+    Json::Value jResp;
+    BOOST_CHECK(cache->get("group0", c_contract, dataHash('0'), 10, jResp));
+    BOOST_CHECK(!cache->get("group0", c_contract, dataHash('9'), 10, jResp));
+
+    // the concurrent inserts never exceed the capacity
+    cache->onBlockNumberUpdated("group0", 11);
+    std::vector<std::thread> threads;
+    for (char c = 'a'; c <= 'f'; c++)
+    {
+        threads.emplace_back([cache, c, output]() {
+            cache->insert("group0", c_contract, dataHash(c), 11, callResult(output));
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK(cache->size() <= cache->capacity());
+}
+
+BOOST_AUTO_TEST_CASE(testAllowlist)
+{
+    auto cache = std::make_shared<CallResultCache>();
+    BOOST_CHECK(cache->cacheable(c_contract));
+    cache->setAllowlist({"0x1111111111111111111111111111111111111111"});
+    BOOST_CHECK(!cache->cacheable(c_contract));
+    BOOST_CHECK(cache->cacheable("1111111111111111111111111111111111111111"));
+}
+
+BOOST_AUTO_TEST_CASE(testConfig)
+{
+    auto config = std::make_shared<RpcConfig>();
+    BOOST_CHECK(!config->callCacheEnabled());
+    BOOST_CHECK(config->callCacheAllowlist().empty());
+    boost::property_tree::ptree pt;
+    pt.put("rpc.call_cache_enable", true);
+    pt.put("rpc.call_cache_capacity", 16);
+    pt.put("rpc.call_cache_allowlist",
+        c_contract + ", 0x1111111111111111111111111111111111111111,");
+    config->loadConfig(pt);
+    BOOST_CHECK(config->callCacheEnabled());
+    BOOST_CHECK_EQUAL(config->callCacheCapacity(), 16 * 1024 * 1024);
+    BOOST_CHECK(config->callCacheAllowlist() ==
+                std::set<std::string>(
+                    {c_contract, "0x1111111111111111111111111111111111111111"}));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,137 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the circuit breaker of the nodes
+ * @file CircuitBreakerTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/RpcConfig.h>
+#include <bcos-rpc/jsonrpc/groupmgr/CircuitBreaker.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+CircuitBreaker::Ptr fakeCircuitBreaker()
+{
+    CircuitBreakerConfig config;
+    config.consecutiveFailureThreshold = 3;
+    config.openTime = 100;
+    config.trialInterval = 100;
+    config.rampTime = 0;
+    auto circuitBreaker = std::make_shared<CircuitBreaker>();
+    circuitBreaker->setConfig(config);
+    return circuitBreaker;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CircuitBreakerTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testOpenAndTrial)
+{
+    auto circuitBreaker = fakeCircuitBreaker();
+    for (int i = 0; i < 2; i++)
+    {
+        circuitBreaker->onResult(true, 1000);
+    }
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::CLOSED);
+    BOOST_CHECK(!circuitBreaker->trialRequired());
+    circuitBreaker->onResult(true, 1000);
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::OPEN);
+    BOOST_CHECK(!circuitBreaker->available());
+    BOOST_CHECK(!circuitBreaker->acquireTrial());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    // checking the availability never changes the state
+    BOOST_CHECK(circuitBreaker->available());
+    BOOST_CHECK(circuitBreaker->available());
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::OPEN);
+    BOOST_CHECK(circuitBreaker->trialRequired());
+
+    // only one trial in trialInterval
+    BOOST_CHECK(circuitBreaker->acquireTrial());
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::HALF_OPEN);
+    BOOST_CHECK(!circuitBreaker->available());
+    BOOST_CHECK(!circuitBreaker->acquireTrial());
+
+    // the trial succeeded, the node is back without ramp time
+    circuitBreaker->onResult(false, 1000);
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::RECOVERING);
+    BOOST_CHECK(circuitBreaker->available());
+    BOOST_CHECK(!circuitBreaker->trialRequired());
+    circuitBreaker->onResult(false, 1000);
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::CLOSED);
+}
+
+BOOST_AUTO_TEST_CASE(testFailedTrial)
+{
+    auto circuitBreaker = fakeCircuitBreaker();
+    for (int i = 0; i < 3; i++)
+    {
+        circuitBreaker->onResult(true, 1000);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    BOOST_CHECK(circuitBreaker->acquireTrial());
+    circuitBreaker->onResult(true, 1000);
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::OPEN);
+    BOOST_CHECK(!circuitBreaker->available());
+}
+
+BOOST_AUTO_TEST_CASE(testSlowCall)
+{
+    auto circuitBreaker = fakeCircuitBreaker();
+    auto slowCall = circuitBreaker->config().slowCallThreshold;
+    for (int i = 0; i < 3; i++)
+    {
+        circuitBreaker->onResult(false, slowCall);
+    }
+    BOOST_CHECK(circuitBreaker->state() == CircuitState::OPEN);
+    // the business errors are not node failures
+    BOOST_CHECK(!CircuitBreaker::isNodeFailure(nullptr));
+    BOOST_CHECK(!CircuitBreaker::isNodeFailure(std::make_shared<Error>(1, "not found")));
+    BOOST_CHECK(CircuitBreaker::isNodeFailure(std::make_shared<Error>(-1, "timeout")));
+}
+
+BOOST_AUTO_TEST_CASE(testLoadConfig)
+{
+    auto config = std::make_shared<RpcConfig>();
+    boost::property_tree::ptree pt;
+    pt.put("rpc.circuit_breaker_error_rate", 0.3);
+    pt.put("rpc.circuit_breaker_consecutive_failures", 10);
+    pt.put("rpc.circuit_breaker_slow_call_threshold", 500);
+    pt.put("rpc.circuit_breaker_open_time", 2000);
+    config->loadConfig(pt);
+    auto const& breakerConfig = config->circuitBreakerConfig();
+    BOOST_CHECK_CLOSE(breakerConfig.errorRateThreshold, 0.3, 0.0001);
+    BOOST_CHECK_EQUAL(breakerConfig.consecutiveFailureThreshold, 10);
+    BOOST_CHECK_EQUAL(breakerConfig.slowCallThreshold, 500 * 1000);
+    BOOST_CHECK_EQUAL(breakerConfig.openTime, 2000);
+    BOOST_CHECK_EQUAL(breakerConfig.rampTime, 30 * 1000);
+
+    pt.put("rpc.circuit_breaker_error_rate", 0);
+    BOOST_CHECK_THROW(config->loadConfig(pt), InvalidRpcConfig);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
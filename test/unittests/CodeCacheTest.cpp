@@ -0,0 +1,139 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the contract code cache
+ * @file CodeCacheTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/RpcConfig.h>
+#include <bcos-rpc/jsonrpc/CodeCache.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+const std::string c_contractA = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+const std::string c_contractB = "0x0102e8b6fc8cdf9626fddc1c3ea8c1e79b3fce94";
+bcos::crypto::HashType codeHash(char _c)
+{
+    return bcos::crypto::HashType(std::string(64, _c));
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CodeCacheTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testBlockVisibility)
+{
+    auto cache = std::make_shared<CodeCache>();
+    BOOST_CHECK_EQUAL(cache->maxBlockAge(), 10);
+    cache->insert("group0", c_contractA, 10, codeHash('1'), "0x6080");
+
+    auto code = cache->get("group0", c_contractA, 10);
+    BOOST_REQUIRE(code);
+    BOOST_CHECK_EQUAL(*code, "0x6080");
+    // the code is served to the following blocks within the max block age
+    BOOST_CHECK(cache->get("group0", c_contractA, 20));
+    BOOST_CHECK(!cache->get("group0", c_contractA, 21));
+    // the older block is never answered by the newer code
+    BOOST_CHECK(!cache->get("group0", c_contractA, 9));
+    BOOST_CHECK(!cache->get("group1", c_contractA, 10));
+
+    // refetched in block 11
+    cache->insert("group0", c_contractA, 11, codeHash('1'), "0x6080");
+    BOOST_CHECK(cache->get("group0", c_contractA, 11));
+    BOOST_CHECK_EQUAL(cache->size(), std::string("0x6080").size());
+    // the entry of the higher block is kept
+    cache->insert("group0", c_contractA, 10, codeHash('2'), "0x6081");
+    BOOST_CHECK_EQUAL(*cache->get("group0", c_contractA, 11), "0x6080");
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidateRedeployed)
+{
+    auto cache = std::make_shared<CodeCache>();
+    std::string code(1024, 'a');
+    cache->insert("group0", c_contractA, 10, codeHash('1'), code);
+    cache->insert("group0", c_contractB, 10, codeHash('1'), code);
+
+    // the deploy signal drops the entry of the address only, the shared code is kept
+    cache->invalidate("group0", "0X6849F21D1E455E9F0712B1E99FA4FCD23758E8F1");
+    BOOST_CHECK(!cache->get("group0", c_contractA, 11));
+    BOOST_CHECK(cache->get("group0", c_contractB, 11));
+    BOOST_CHECK_EQUAL(cache->size(), code.size());
+    cache->invalidate("group1", c_contractB);
+    BOOST_CHECK(cache->get("group0", c_contractB, 11));
+
+    // the redeployed code is cached again
+    cache->insert("group0", c_contractA, 11, codeHash('2'), "0x6081");
+    BOOST_CHECK_EQUAL(*cache->get("group0", c_contractA, 11), "0x6081");
+    cache->invalidate("group0", c_contractB);
+    BOOST_CHECK_EQUAL(cache->size(), std::string("0x6081").size());
+    cache->onBlock("group0", nullptr);
+    BOOST_CHECK(cache->get("group0", c_contractA, 11));
+}
+
+BOOST_AUTO_TEST_CASE(testMaxBlockAge)
+{
+    auto cache = std::make_shared<CodeCache>();
+    cache->setMaxBlockAge(5);
+    cache->insert("group0", c_contractA, 10, codeHash('1'), "0x6080");
+    BOOST_CHECK(cache->get("group0", c_contractA, 15));
+    BOOST_CHECK(!cache->get("group0", c_contractA, 16));
+
+    cache->setMaxBlockAge(-1);
+    BOOST_CHECK(cache->get("group0", c_contractA, 1000));
+}
+
+BOOST_AUTO_TEST_CASE(testSharedCodeAndCapacity)
+{
+    auto cache = std::make_shared<CodeCache>();
+    std::string code(1024, 'a');
+    cache->insert("group0", c_contractA, 10, codeHash('1'), code);
+    cache->insert("group0", c_contractB, 10, codeHash('1'), code);
+    // the same code is stored once
+    BOOST_CHECK_EQUAL(cache->size(), code.size());
+    BOOST_CHECK(cache->get("group0", c_contractA, 10) == cache->get("group0", c_contractB, 10));
+
+    // the empty code is never cached
+    cache->insert("group0", "0x00", 10, codeHash('0'), "");
+    BOOST_CHECK(!cache->get("group0", "0x00", 10));
+
+    // contractA is the most recently used, contractB and its code is evicted first
+    cache->insert("group1", c_contractB, 10, codeHash('2'), std::string(1024, 'b'));
+    BOOST_CHECK(cache->get("group0", c_contractA, 10));
+    cache->setCapacity(1024);
+    BOOST_CHECK(cache->get("group0", c_contractA, 10));
+    BOOST_CHECK(!cache->get("group1", c_contractB, 10));
+    BOOST_CHECK(cache->size() <= 1024);
+}
+
+BOOST_AUTO_TEST_CASE(testLoadConfig)
+{
+    auto config = std::make_shared<RpcConfig>();
+    BOOST_CHECK_EQUAL(config->codeCacheMaxBlockAge(), 10);
+    boost::property_tree::ptree pt;
+    pt.put("rpc.code_cache_max_block_age", -1);
+    config->loadConfig(pt);
+    BOOST_CHECK_EQUAL(config->codeCacheMaxBlockAge(), -1);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,181 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the polls of the EventFilterManager
+ * @file EventFilterManagerTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/Common.h>
+#include <bcos-rpc/event/EventFilterManager.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0") {}
+    bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string&) override
+    {
+        return m_blockNumber;
+    }
+    bcos::protocol::BlockNumber m_blockNumber = 10;
+};
+
+// every block has m_logs[block] logs, the queries exceeding the limit fail like the log query
+class FakeLogQuery : public EventLogQuery
+{
+public:
+    explicit FakeLogQuery(GroupManager::Ptr _groupManager)
+      : EventLogQuery(_groupManager, std::make_shared<EventSubMatcher>())
+    {}
+    void query(const std::string&, EventSubParams::ConstPtr _params, uint64_t _maxResultCount,
+        Callback _callback) override
+    {
+        m_queries++;
+        Json::Value logs(Json::arrayValue);
+        for (auto block = _params->fromBlock(); block <= _params->toBlock(); block++)
+        {
+            for (uint32_t i = 0; i < m_logs[block]; i++)
+            {
+                Json::Value log;
+                log["blockNumber"] = (Json::Int64)block;
+                log["logIndex"] = i;
+                logs.append(log);
+            }
+        }
+        if (_maxResultCount > 0 && logs.size() > _maxResultCount)
+        {
+            Json::Value jResp;
+            _callback(std::make_shared<Error>(EP_STATUS_CODE::INVALID_REQUEST_RANGE,
+                          "the number of logs exceeds the limit"),
+                jResp);
+            return;
+        }
+        _callback(nullptr, logs);
+    }
+
+    std::map<int64_t, uint32_t> m_logs;
+    size_t m_queries = 0;
+};
+
+struct FilterFixture : public TestPromptFixture
+{
+    FilterFixture()
+    {
+        groupManager = std::make_shared<FakeGroupManager>();
+        logQuery = std::make_shared<FakeLogQuery>(groupManager);
+        logQuery->setMaxResultCount(4);
+        filterManager = std::make_shared<EventFilterManager>(groupManager, logQuery);
+    }
+
+    Json::Value poll(std::string const& _filterID, Error::Ptr& _error)
+    {
+        Json::Value result;
+        filterManager->getFilterChanges(
+            _filterID, [&result, &_error](Error::Ptr _pollError, Json::Value& _result) {
+                _error = _pollError;
+                result = _result;
+            });
+        return result;
+    }
+
+    std::shared_ptr<FakeGroupManager> groupManager;
+    std::shared_ptr<FakeLogQuery> logQuery;
+    EventFilterManager::Ptr filterManager;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventFilterManagerTest, FilterFixture)
+BOOST_AUTO_TEST_CASE(testPollChanges)
+{
+    auto params = std::make_shared<EventSubParams>();
+    params->setFromBlock(1);
+    params->setToBlock(-1);
+    auto filterID = filterManager->newFilter("group0", params);
+    BOOST_CHECK(!filterID.empty());
+    logQuery->m_logs[2] = 1;
+    logQuery->m_logs[9] = 2;
+
+    Error::Ptr error;
+    auto logs = poll(filterID, error);
+    BOOST_CHECK(!error);
+    BOOST_CHECK_EQUAL(logs.size(), 3);
+    // only the changes since the last poll are returned
+    logs = poll(filterID, error);
+    BOOST_CHECK_EQUAL(logs.size(), 0);
+    groupManager->m_blockNumber = 11;
+    logQuery->m_logs[11] = 1;
+    logs = poll(filterID, error);
+    BOOST_CHECK_EQUAL(logs.size(), 1);
+    BOOST_CHECK_EQUAL(logs[0]["blockNumber"].asInt64(), 11);
+
+    BOOST_CHECK(filterManager->uninstallFilter(filterID));
+    poll(filterID, error);
+    BOOST_CHECK(error);
+}
+
+BOOST_AUTO_TEST_CASE(testBlockExceedingLimit)
+{
+    auto params = std::make_shared<EventSubParams>();
+    params->setFromBlock(1);
+    params->setToBlock(-1);
+    auto filterID = filterManager->newFilter("group0", params);
+    logQuery->m_logs[1] = 3;
+    logQuery->m_logs[2] = 6;
+    logQuery->m_logs[3] = 1;
+
+    // the range is halved until the logs are within the limit
+    Error::Ptr error;
+    auto logs = poll(filterID, error);
+    BOOST_CHECK(!error);
+    BOOST_CHECK_EQUAL(logs.size(), 3);
+    BOOST_CHECK_EQUAL(logs[0]["blockNumber"].asInt64(), 1);
+
+    // the logs of the block exceeding the limit are returned in one poll, none is lost
+    logs = poll(filterID, error);
+    BOOST_CHECK(!error);
+    BOOST_CHECK_EQUAL(logs.size(), 6);
+    BOOST_CHECK_EQUAL(logs[5]["blockNumber"].asInt64(), 2);
+
+    logs = poll(filterID, error);
+    BOOST_CHECK(!error);
+    BOOST_CHECK_EQUAL(logs.size(), 1);
+    BOOST_CHECK_EQUAL(logs[0]["blockNumber"].asInt64(), 3);
+    logs = poll(filterID, error);
+    BOOST_CHECK_EQUAL(logs.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testMaxFilterCount)
+{
+    filterManager->setMaxFilterCount(1);
+    BOOST_CHECK(!filterManager->newFilter("group0", std::make_shared<EventSubParams>()).empty());
+    BOOST_CHECK(filterManager->newFilter("group0", std::make_shared<EventSubParams>()).empty());
+    BOOST_CHECK_EQUAL(filterManager->filterCount(), 1);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,93 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the log blooms of the blocks
+ * @file EventLogBloomTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventLogBloom.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(EventLogBloomTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testLogBloom)
+{
+    std::string topic0 = "0x" + std::string(64, 'a');
+    std::string topic1 = "0x" + std::string(64, 'b');
+    LogBloom bloom;
+    BOOST_CHECK(bloom.empty());
+    bloom.addAddress("0x1234");
+    bloom.addTopic(bcos::crypto::HashType(topic0));
+    BOOST_CHECK(!bloom.empty());
+    BOOST_CHECK(bloom.containsAddress("0x1234"));
+    BOOST_CHECK(bloom.containsTopic(bcos::crypto::HashType(topic0)));
+
+    EventSubParams params;
+    BOOST_CHECK(bloom.mayMatch(params));
+    params.addAddress("0x1234");
+    params.addTopic(0, topic0);
+    BOOST_CHECK(bloom.mayMatch(params));
+
+    EventSubParams otherTopic;
+    otherTopic.addTopic(0, topic1);
+    BOOST_CHECK(!bloom.mayMatch(otherTopic));
+    // the topic not a 32 bytes hex never matches
+    EventSubParams invalidTopic;
+    invalidTopic.addTopic(0, "0x12");
+    BOOST_CHECK(!bloom.mayMatch(invalidTopic));
+    // the params without addresses and topics never match the block without logs
+    BOOST_CHECK(!LogBloom().mayMatch(EventSubParams()));
+
+    // the persisted bloom is the same
+    LogBloom persisted(bloom.bits());
+    BOOST_CHECK(persisted.mayMatch(params));
+}
+
+BOOST_AUTO_TEST_CASE(testGenesisHashRequest)
+{
+    auto bloomIndex = std::make_shared<EventLogBloomIndex>();
+    // in memory only
+    BOOST_CHECK(!bloomIndex->genesisHashRequired("group0"));
+    // the unknown block may match
+    BOOST_CHECK(bloomIndex->mayMatch("group0", 10, EventSubParams()));
+
+    bloomIndex->setStoragePath("./bloomTest");
+    BOOST_CHECK(bloomIndex->genesisHashRequired("group0"));
+    // being requested
+    BOOST_CHECK(!bloomIndex->genesisHashRequired("group0"));
+    bloomIndex->resetGenesisHashRequest("group0");
+    BOOST_CHECK(bloomIndex->genesisHashRequired("group0"));
+    bloomIndex->setGenesisHash("group0", bcos::crypto::HashType("0x" + std::string(64, 'c')));
+    BOOST_CHECK(!bloomIndex->genesisHashRequired("group0"));
+    BOOST_CHECK(bloomIndex->genesisHashRequired("group1"));
+}
+
+BOOST_AUTO_TEST_CASE(testFileName)
+{
+    // the groups differing in the punctuations never share a file
+    BOOST_CHECK(EventLogBloomIndex::fileName("g.1") != EventLogBloomIndex::fileName("g_1"));
+    BOOST_CHECK(EventLogBloomIndex::fileName("../g") != EventLogBloomIndex::fileName("___g"));
+    BOOST_CHECK_EQUAL(EventLogBloomIndex::fileName("../g").find('/'), std::string::npos);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,133 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the segments and the directories of the EventLogIndex
+ * @file EventLogIndexTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventLogIndex.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(EventLogIndexTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testSegmentTrimAndReopen)
+{
+    std::string path = "./logIndexTest.seg";
+    std::remove(path.c_str());
+    auto segment = LogIndexSegment::open(path, 16, 0);
+    BOOST_CHECK(segment);
+    BOOST_CHECK_EQUAL(segment->size(), 0);
+    BOOST_CHECK(segment->append({{1, 0, 0, 0}, {2, 0, 0, 0}}));
+    BOOST_CHECK(segment->append({{3, 1, 0, 0}}));
+    BOOST_CHECK(segment->append({{4, 2, 0, 0}, {5, 2, 1, 0}}));
+    BOOST_CHECK(segment->sync());
+    BOOST_CHECK_EQUAL(segment->size(), 5);
+    // the appended records are visible through the mapping
+    BOOST_CHECK_EQUAL(segment->records()[2].key, 3);
+    segment.reset();
+
+    // the records of the blocks after the checkpoint are dropped
+    segment = LogIndexSegment::open(path, 16, 2);
+    BOOST_CHECK(segment);
+    BOOST_CHECK_EQUAL(segment->size(), 3);
+    BOOST_CHECK_EQUAL(segment->records()[2].blockNumber, 1);
+    segment.reset();
+
+    // the partial record written before the crash is dropped
+    {
+        std::ofstream file(path, std::ios::app | std::ios::binary);
+        file.write("partial", 7);
+    }
+    segment = LogIndexSegment::open(path, 16, 2);
+    BOOST_CHECK(segment);
+    BOOST_CHECK_EQUAL(segment->size(), 3);
+    BOOST_CHECK(segment->append({{6, 2, 0, 0}}));
+    BOOST_CHECK_EQUAL(segment->records()[3].key, 6);
+    segment.reset();
+
+    segment = LogIndexSegment::open(path, 16, 3);
+    BOOST_CHECK(segment);
+    BOOST_CHECK_EQUAL(segment->size(), 4);
+    segment.reset();
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testSealedSegmentQuery)
+{
+    std::string path = "./logIndexSealTest.seg";
+    std::remove(path.c_str());
+    auto segment = LogIndexSegment::open(path, 16, 0);
+    BOOST_CHECK(segment);
+    // the keys 1 and 2 in the same log satisfy the query, the logs of the blocks 2 and 4 don't
+    BOOST_CHECK(segment->append({{1, 1, 0, 0}, {2, 1, 0, 0}}));
+    BOOST_CHECK(segment->append({{1, 2, 0, 0}, {2, 2, 0, 1}}));
+    BOOST_CHECK(segment->append({{2, 3, 0, 0}, {1, 3, 0, 0}}));
+    BOOST_CHECK(segment->append({{1, 4, 1, 0}}));
+    BOOST_CHECK(segment->append({{1, 5, 0, 0}, {2, 5, 0, 0}, {1, 5, 0, 1}, {2, 5, 0, 1}}));
+    BOOST_CHECK(segment->append({{3, 6, 0, 0}, {1, 6, 0, 0}, {2, 6, 0, 0}}));
+    LogIndexKeyBits keyBits = {{1, 1}, {2, 2}};
+    auto queryBlocks = [&](bcos::protocol::BlockNumber _fromBlock,
+                           bcos::protocol::BlockNumber _toBlock, size_t _limit, bool& _limited) {
+        std::vector<bcos::protocol::BlockNumber> blocks;
+        _limited = segment->queryBlocks(keyBits, 3, _fromBlock, _toBlock, _limit, blocks);
+        return blocks;
+    };
+
+    // the postings return the same blocks as the scan
+    for (auto sealed : {false, true})
+    {
+        if (sealed)
+        {
+            BOOST_CHECK(!segment->sealed());
+            segment->seal();
+            BOOST_CHECK(segment->sealed());
+        }
+        bool limited = false;
+        auto blocks = queryBlocks(0, 10, 10, limited);
+        BOOST_CHECK(blocks == std::vector<bcos::protocol::BlockNumber>({1, 3, 5, 6}));
+        BOOST_CHECK(!limited);
+        blocks = queryBlocks(2, 5, 10, limited);
+        BOOST_CHECK(blocks == std::vector<bcos::protocol::BlockNumber>({3, 5}));
+        blocks = queryBlocks(1, 10, 2, limited);
+        BOOST_CHECK(blocks == std::vector<bcos::protocol::BlockNumber>({1, 3}));
+        BOOST_CHECK(limited);
+        // the range out of the segment
+        blocks = queryBlocks(7, 10, 10, limited);
+        BOOST_CHECK(blocks.empty());
+        BOOST_CHECK(!limited);
+    }
+    segment.reset();
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testDirName)
+{
+    // the groups differing in the punctuations never share a directory
+    BOOST_CHECK(EventLogIndex::dirName("g.1") != EventLogIndex::dirName("g_1"));
+    BOOST_CHECK(EventLogIndex::dirName("../g") != EventLogIndex::dirName("___g"));
+    BOOST_CHECK_EQUAL(EventLogIndex::dirName("../g").find('/'), std::string::npos);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
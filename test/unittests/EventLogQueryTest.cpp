@@ -0,0 +1,100 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the block fetches of the EventLogQuery
+ * @file EventLogQueryTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventLogQuery.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager()
+      : GroupManager("chain0"),
+        m_nodeService(
+            std::make_shared<NodeService>(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr))
+    {}
+    NodeService::Ptr getNodeService(std::string const&, std::string const&) const override
+    {
+        return m_nodeService;
+    }
+    bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string&) override { return 5; }
+
+    NodeService::Ptr m_nodeService;
+};
+
+// answers every fetch with the given error and no block
+class FakeBlockFeed : public EventSubBlockFeed
+{
+public:
+    void asyncGetBlock(std::string const&, bcos::protocol::BlockNumber _blockNumber,
+        NodeService::Ptr _nodeService, BlockCallback _callback) override
+    {
+        m_blocks.push_back(_blockNumber);
+        m_nodeServices.push_back(_nodeService);
+        _callback(m_error, nullptr);
+    }
+
+    Error::Ptr m_error;
+    std::vector<bcos::protocol::BlockNumber> m_blocks;
+    std::vector<NodeService::Ptr> m_nodeServices;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventLogQueryTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testFetchThroughBlockFeed)
+{
+    auto groupManager = std::make_shared<FakeGroupManager>();
+    auto logQuery =
+        std::make_shared<EventLogQuery>(groupManager, std::make_shared<EventSubMatcher>());
+    auto blockFeed = std::make_shared<FakeBlockFeed>();
+    logQuery->setBlockFeed(blockFeed);
+    auto params = std::make_shared<EventSubParams>();
+    params->setFromBlock(1);
+    params->setToBlock(3);
+
+    // the missing block fails the query instead of being dereferenced
+    std::vector<Error::Ptr> errors;
+    auto callback = [&errors](Error::Ptr _error, Json::Value&) { errors.push_back(_error); };
+    logQuery->query("group0", params, callback);
+    BOOST_REQUIRE_EQUAL(errors.size(), 1);
+    BOOST_CHECK(errors[0]);
+    // the blocks are fetched from the routed node through the feed
+    BOOST_CHECK(blockFeed->m_blocks == std::vector<bcos::protocol::BlockNumber>({1}));
+    BOOST_CHECK(blockFeed->m_nodeServices[0] == groupManager->m_nodeService);
+
+    blockFeed->m_error = std::make_shared<Error>(-1, "fetch block failed");
+    logQuery->query("group0", params, callback);
+    BOOST_REQUIRE_EQUAL(errors.size(), 2);
+    BOOST_CHECK_EQUAL(errors[1]->errorCode(), -1);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the single-flight fetches of the EventSubBlockFeed
+ * @file EventSubBlockFeedTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSubBlockFeed.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+// the fetches are recorded and answered by the test
+class FakeBlockFeed : public EventSubBlockFeed
+{
+public:
+    using EventSubBlockFeed::onBlockFetched;
+    void fetchBlock(std::string const& _group, bcos::protocol::BlockNumber _blockNumber,
+        bcos::rpc::NodeService::Ptr) override
+    {
+        m_fetches.emplace_back(_group, _blockNumber);
+    }
+    std::vector<std::pair<std::string, bcos::protocol::BlockNumber>> m_fetches;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubBlockFeedTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testSingleFlightFetch)
+{
+    auto feed = std::make_shared<FakeBlockFeed>();
+    std::vector<Error::Ptr> results;
+    auto callback = [&results](Error::Ptr _error, bcos::protocol::Block::ConstPtr) {
+        results.push_back(_error);
+    };
+
+    // the concurrent requests of a block wait for one fetch
+    feed->asyncGetBlock("group0", 10, nullptr, callback);
+    feed->asyncGetBlock("group0", 10, nullptr, callback);
+    feed->asyncGetBlock("group0", 10, nullptr, callback);
+    feed->asyncGetBlock("group1", 10, nullptr, callback);
+    BOOST_CHECK_EQUAL(feed->m_fetches.size(), 2);
+    BOOST_CHECK_EQUAL(feed->fetchCount(), 2);
+    BOOST_CHECK_EQUAL(feed->hitCount(), 2);
+    BOOST_CHECK(results.empty());
+
+    // all the waiters are answered by the fetch
+    feed->onBlockFetched("group0", 10, std::make_shared<Error>(-1, "fetch failed"), nullptr);
+    BOOST_CHECK_EQUAL(results.size(), 3);
+    for (auto const& error : results)
+    {
+        BOOST_CHECK(error && error->errorCode() == -1);
+    }
+    // the empty block fails the waiters too
+    feed->onBlockFetched("group1", 10, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(results.size(), 4);
+    BOOST_CHECK(results.back());
+
+    // the failed block is fetched again by the next request
+    feed->asyncGetBlock("group0", 10, nullptr, callback);
+    BOOST_CHECK_EQUAL(feed->m_fetches.size(), 3);
+    // the removed group keeps the block being fetched for its waiters
+    feed->removeGroup("group0");
+    feed->asyncGetBlock("group0", 10, nullptr, callback);
+    BOOST_CHECK_EQUAL(feed->m_fetches.size(), 3);
+    feed->onBlockFetched("group0", 10, std::make_shared<Error>(-1, "fetch failed"), nullptr);
+    BOOST_CHECK_EQUAL(results.size(), 6);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,96 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the cursor of the event sub
+ * @file EventSubCursorTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSubCursor.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+Json::Value fakeLog(int64_t _blockNumber, uint32_t _txIndex, uint32_t _logIndex)
+{
+    Json::Value log;
+    log["blockNumber"] = (Json::Int64)_blockNumber;
+    log["transactionIndex"] = _txIndex;
+    log["logIndex"] = _logIndex;
+    return log;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubCursorTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testEncodeAndDecode)
+{
+    EventSubCursor cursor(0x123456789a, 7, 0xffffffff);
+    auto encoded = cursor.encode();
+    BOOST_CHECK_EQUAL(encoded, "01000000123456789a00000007ffffffff");
+    auto decoded = EventSubCursor::decode(encoded);
+    BOOST_CHECK(decoded);
+    BOOST_CHECK_EQUAL(decoded->blockNumber(), cursor.blockNumber());
+    BOOST_CHECK_EQUAL(decoded->txIndex(), cursor.txIndex());
+    BOOST_CHECK_EQUAL(decoded->logIndex(), cursor.logIndex());
+
+    // the unknown version, the wrong length, the non hex and the negative block number
+    BOOST_CHECK(!EventSubCursor::decode("02" + encoded.substr(2)));
+    BOOST_CHECK(!EventSubCursor::decode(encoded.substr(1)));
+    BOOST_CHECK(!EventSubCursor::decode(encoded.substr(0, 33) + "g"));
+    BOOST_CHECK(!EventSubCursor::decode("01ffffffffffffffff0000000000000000"));
+    BOOST_CHECK(!EventSubCursor::decode(""));
+
+    auto fromLog = EventSubCursor::fromLog(fakeLog(10, 2, 3));
+    BOOST_CHECK(fromLog);
+    BOOST_CHECK_EQUAL(fromLog->encode(), EventSubCursor(10, 2, 3).encode());
+    BOOST_CHECK(!EventSubCursor::fromLog(Json::Value(Json::arrayValue)));
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveCovered)
+{
+    EventSubCursor cursor(10, 2, 3);
+    BOOST_CHECK(cursor.covers(9, 100, 100));
+    BOOST_CHECK(cursor.covers(10, 1, 100));
+    BOOST_CHECK(cursor.covers(10, 2, 3));
+    BOOST_CHECK(!cursor.covers(10, 2, 4));
+    BOOST_CHECK(!cursor.covers(10, 3, 0));
+    BOOST_CHECK(!cursor.covers(11, 0, 0));
+
+    Json::Value logs(Json::arrayValue);
+    logs.append(fakeLog(10, 1, 5));
+    logs.append(fakeLog(10, 2, 3));
+    logs.append(fakeLog(10, 2, 4));
+    logs.append(fakeLog(10, 3, 0));
+    cursor.removeCovered(logs);
+    // only the logs after the cursor are kept in order
+    BOOST_CHECK_EQUAL(logs.size(), 2);
+    BOOST_CHECK_EQUAL(logs[0]["logIndex"].asUInt(), 4);
+    BOOST_CHECK_EQUAL(logs[1]["transactionIndex"].asUInt(), 3);
+
+    cursor.removeCovered(logs);
+    BOOST_CHECK_EQUAL(logs.size(), 2);
+    EventSubCursor(11, 0, 0).removeCovered(logs);
+    BOOST_CHECK_EQUAL(logs.size(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,81 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the fair scheduling of the EventSubExecutor
+ * @file EventSubExecutorTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSubExecutor.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(EventSubExecutorTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testRoundRobinByKey)
+{
+    auto executor = std::make_shared<EventSubExecutor>(1);
+    BOOST_CHECK_EQUAL(executor->threadNum(), 1);
+
+    // the only thread is blocked until all the jobs are queued
+    std::promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    std::promise<void> started;
+    executor->execute("group0", [blocked, &started]() {
+        started.set_value();
+        blocked.wait();
+    });
+    started.get_future().wait();
+
+    std::vector<std::string> executed;
+    Mutex x_executed;
+    std::promise<void> finished;
+    auto job = [&executed, &x_executed, &finished](std::string const& _name) {
+        return [&executed, &x_executed, &finished, _name]() {
+            Guard l(x_executed);
+            executed.push_back(_name);
+            if (executed.size() == 5)
+            {
+                finished.set_value();
+            }
+        };
+    };
+    executor->execute("group0", job("a0"));
+    executor->execute("group0", job("a1"));
+    executor->execute("group0", job("a2"));
+    executor->execute("group1", job("b0"));
+    executor->execute("group2", job("c0"));
+    BOOST_CHECK_EQUAL(executor->pendingJobs(), 5);
+
+    blocker.set_value();
+    BOOST_REQUIRE(
+        finished.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(executor->pendingJobs(), 0);
+    // the jobs of the other groups are not queued behind the backlog of group0, and the jobs of
+    // group0 keep their order
+    Guard l(x_executed);
+    BOOST_CHECK(executed == std::vector<std::string>({"a0", "b0", "c0", "a1", "a2"}));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
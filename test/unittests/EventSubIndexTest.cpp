@@ -0,0 +1,189 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the task index of the event sub
+ * @file EventSubIndexTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSubIndex.h>
+#include <bcos-rpc/event/EventSubMatcher.h>
+#include <bcos-rpc/jsonrpc/groupmgr/Common.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::protocol;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+const std::string c_topic1 = std::string(64, 'a');
+const std::string c_topic2 = std::string(64, 'b');
+
+// one transaction with the logs of the given addresses and topic0
+Block::Ptr fakeBlock(
+    BlockNumber _blockNumber, std::vector<std::pair<std::string, std::string>> const& _logs)
+{
+    static auto blockFactory = bcos::rpc::createBlockFactory(bcos::rpc::createCryptoSuite());
+    std::vector<LogEntry> logEntries;
+    for (auto const& log : _logs)
+    {
+        logEntries.emplace_back(bytes(log.first.begin(), log.first.end()),
+            h256s{bcos::crypto::HashType(log.second)}, bytes());
+    }
+    auto receipt = blockFactory->receiptFactory()->createReceipt(
+        u256(0), std::string(), logEntries, 0, bytes(), _blockNumber);
+    auto tx = blockFactory->transactionFactory()->createTransaction(
+        0, bytes(), bytes(), u256(0), 0, "", "", 0);
+    auto block = blockFactory->createBlock();
+    block->appendTransaction(tx);
+    block->appendReceipt(receipt);
+    return block;
+}
+
+EventSubTask::Ptr fakeTask(std::string const& _id, std::vector<std::string> const& _addresses,
+    std::vector<std::string> const& _topics)
+{
+    auto params = std::make_shared<EventSubParams>();
+    for (auto const& address : _addresses)
+    {
+        params->addAddress(address);
+    }
+    for (auto const& topic : _topics)
+    {
+        params->addTopic(0, topic);
+    }
+    auto task = std::make_shared<EventSubTask>();
+    task->setId(_id);
+    task->setGroup("group0");
+    task->setParams(params);
+    return task;
+}
+
+uint32_t matches(EventSubIndex& _index, EventSubTask::Ptr _task, Block::Ptr _block)
+{
+    Json::Value result(Json::arrayValue);
+    auto count = _index.matches(_task, _block->receipt(0)->blockNumber(), _block, result);
+    BOOST_CHECK_EQUAL(result.size(), count);
+    return count;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubIndexTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testQueuedUpdates)
+{
+    EventSubIndex index(std::make_shared<EventSubMatcher>());
+    auto addressTask = fakeTask("address", {"aa01"}, {});
+    auto topicTask = fakeTask("topic", {}, {c_topic1});
+    auto wildcardTask = fakeTask("wildcard", {}, {});
+    index.addTask(addressTask);
+    index.addTask(topicTask);
+    index.addTask(wildcardTask);
+    // the duplicated task and the unknown task are ignored
+    index.addTask(addressTask);
+    index.removeTask("unknown");
+    BOOST_CHECK_EQUAL(index.size(), 3);
+
+    // the queued tasks are indexed before the block is matched
+    auto block = fakeBlock(1, {{"aa01", c_topic2}, {"bb02", c_topic1}, {"cc03", c_topic2}});
+    BOOST_CHECK_EQUAL(matches(index, addressTask, block), 1);
+    BOOST_CHECK_EQUAL(matches(index, topicTask, block), 1);
+    BOOST_CHECK_EQUAL(matches(index, wildcardTask, block), 3);
+
+    // the task queued after the block matched is matched by itself
+    index.removeTask("topic");
+    auto lateTask = fakeTask("late", {"bb02", "cc03"}, {});
+    index.addTask(lateTask);
+    BOOST_CHECK_EQUAL(index.size(), 3);
+    BOOST_CHECK_EQUAL(matches(index, lateTask, block), 2);
+
+    // the removed and re-added task is indexed with its latest params
+    index.removeTask("address");
+    index.addTask(fakeTask("address", {"cc03"}, {}));
+    auto nextBlock = fakeBlock(2, {{"aa01", c_topic1}, {"cc03", c_topic1}});
+    BOOST_CHECK_EQUAL(matches(index, lateTask, nextBlock), 1);
+    BOOST_CHECK_EQUAL(matches(index, fakeTask("address", {"cc03"}, {}), nextBlock), 1);
+    BOOST_CHECK_EQUAL(matches(index, wildcardTask, nextBlock), 2);
+
+    index.removeTask("address");
+    index.removeTask("late");
+    index.removeTask("wildcard");
+    BOOST_CHECK_EQUAL(index.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testTopicKeys)
+{
+    // the topics in any case, with or without the 0x prefix, have the same key
+    EventSubParams params;
+    params.addTopic(0, "0x" + c_topic1);
+    params.addTopic(0, "0X" + boost::to_upper_copy(c_topic2));
+    params.addTopic(1, std::string(32, 'c') + std::string(32, 'C'));
+    BOOST_REQUIRE_EQUAL(params.topicKeys().size(), 2);
+    BOOST_CHECK_EQUAL(params.topicKeys()[0].size(), 2);
+    BOOST_CHECK(params.hasTopic(0, bcos::crypto::HashType(c_topic1)));
+    BOOST_CHECK(params.hasTopic(0, bcos::crypto::HashType(c_topic2)));
+    BOOST_CHECK(params.hasTopic(1, bcos::crypto::HashType(std::string(64, 'c'))));
+    BOOST_CHECK(!params.hasTopic(1, bcos::crypto::HashType(c_topic1)));
+    BOOST_CHECK(!params.hasTopic(2, bcos::crypto::HashType(c_topic1)));
+
+    // the topics not a 32 bytes hex are kept without key
+    params.addTopic(2, "0x" + c_topic1.substr(2));
+    params.addTopic(2, "0x" + std::string(63, 'a') + "g");
+    BOOST_CHECK_EQUAL(params.topics()[2].size(), 2);
+    BOOST_CHECK(params.topicKeys()[2].empty());
+    BOOST_CHECK(!EventSubParams::isTopicHex("0x"));
+    BOOST_CHECK(EventSubParams::isTopicHex("0X" + c_topic1));
+}
+
+BOOST_AUTO_TEST_CASE(testCandidateRouting)
+{
+    EventSubIndex index(std::make_shared<EventSubMatcher>());
+    // indexed by the addresses only, the topic0 is tested against the logs of the addresses
+    auto addressTask = fakeTask("address", {"aa01", "bb02"}, {c_topic1});
+    // indexed by the topic0 in mixed case with the prefix
+    auto topicTask = fakeTask("topic", {}, {"0x" + boost::to_upper_copy(c_topic2)});
+    // the task with only the invalid topic0 matches nothing
+    auto invalidTask = fakeTask("invalid", {}, {"0x1234"});
+    auto wildcardTask = fakeTask("wildcard", {}, {});
+    for (auto const& task : {addressTask, topicTask, invalidTask, wildcardTask})
+    {
+        index.addTask(task);
+    }
+    auto block = fakeBlock(1, {{"aa01", c_topic1}, {"aa01", c_topic2}, {"bb02", c_topic1},
+                                  {"cc03", c_topic1}, {"cc03", c_topic2}});
+    BOOST_CHECK_EQUAL(matches(index, addressTask, block), 2);
+    BOOST_CHECK_EQUAL(matches(index, topicTask, block), 2);
+    BOOST_CHECK_EQUAL(matches(index, invalidTask, block), 0);
+    BOOST_CHECK_EQUAL(matches(index, wildcardTask, block), 5);
+
+    // the logs matched by the index are the same as matched by the task itself
+    EventSubMatcher matcher;
+    for (auto const& task : {addressTask, topicTask, invalidTask, wildcardTask})
+    {
+        Json::Value indexed(Json::arrayValue);
+        index.matches(task, 1, block, indexed);
+        Json::Value expected(Json::arrayValue);
+        matcher.matches(task->params(), block, expected);
+        BOOST_CHECK(indexed == expected);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
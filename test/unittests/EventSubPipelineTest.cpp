@@ -0,0 +1,222 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the block order, the retry and the push frames of the EventSubPipeline
+ * @file EventSubPipelineTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSub.h>
+#include <bcos-rpc/event/EventSubPipeline.h>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0") {}
+    bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string&) override
+    {
+        return m_blockNumber;
+    }
+    bcos::protocol::BlockNumber m_blockNumber = 10;
+};
+
+// the blocks are matched when the test answers the recorded callbacks
+class FakeEventSub : public EventSub
+{
+public:
+    FakeEventSub() : EventSub(1) {}
+    void matchBlock(int64_t _blockNumber, EventSubTask::Ptr, MatchCallback _callback) override
+    {
+        Guard l(x_callbacks);
+        m_callbacks[_blockNumber] = _callback;
+    }
+    MatchCallback take(int64_t _blockNumber)
+    {
+        Guard l(x_callbacks);
+        auto callback = m_callbacks.at(_blockNumber);
+        m_callbacks.erase(_blockNumber);
+        return callback;
+    }
+    void answer(int64_t _blockNumber, Error::Ptr _error = nullptr, uint32_t _logs = 1)
+    {
+        auto callback = take(_blockNumber);
+        Json::Value logs(Json::arrayValue);
+        for (uint32_t i = 0; !_error && i < _logs; i++)
+        {
+            Json::Value log;
+            log["blockNumber"] = (Json::Int64)_blockNumber;
+            log["logIndex"] = i;
+            logs.append(log);
+        }
+        callback(_error, logs);
+    }
+    size_t fetchedBlocks() const
+    {
+        Guard l(x_callbacks);
+        return m_callbacks.size();
+    }
+
+private:
+    std::map<int64_t, MatchCallback> m_callbacks;
+    mutable Mutex x_callbacks;
+};
+
+struct PipelineFixture : public TestPromptFixture
+{
+    PipelineFixture()
+    {
+        eventSub = std::make_shared<FakeEventSub>();
+        eventSub->setGroupManager(std::make_shared<FakeGroupManager>());
+        // every block is pushed in its own frame
+        eventSub->setMaxPushBytes(0);
+        task = std::make_shared<EventSubTask>();
+        task->setId("task0");
+        task->setGroup("group0");
+        auto params = std::make_shared<EventSubParams>();
+        params->setFromBlock(1);
+        params->setToBlock(-1);
+        task->setParams(params);
+        auto state = std::make_shared<EventSubTaskState>();
+        state->setCurrentBlockNumber(1);
+        task->setState(state);
+        task->setCallback([this](const std::string&, bool, const Json::Value& _logs) {
+            for (auto const& log : _logs)
+            {
+                pushedBlocks.push_back(log["blockNumber"].asInt64());
+            }
+            frames.push_back(_logs.size());
+            return true;
+        });
+        task->setWork(true);
+    }
+
+    std::shared_ptr<FakeEventSub> eventSub;
+    EventSubTask::Ptr task;
+    std::vector<int64_t> pushedBlocks;
+    // the number of the logs of each frame
+    std::vector<size_t> frames;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubPipelineTest, PipelineFixture)
+BOOST_AUTO_TEST_CASE(testBlockOrder)
+{
+    auto pipeline =
+        std::make_shared<EventSubPipeline>(eventSub, task, std::vector<int64_t>({1, 3, 4}), 5);
+    pipeline->start();
+    BOOST_CHECK_EQUAL(eventSub->fetchedBlocks(), 3);
+
+    // the blocks finished out of order are pushed in block order
+    eventSub->answer(4);
+    eventSub->answer(3);
+    BOOST_CHECK(pushedBlocks.empty());
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 1);
+    eventSub->answer(1);
+    BOOST_CHECK(pushedBlocks == std::vector<int64_t>({1, 3, 4}));
+    // the blocks after the last block of the list have no candidate log
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 6);
+    BOOST_CHECK(!task->work());
+}
+
+BOOST_AUTO_TEST_CASE(testRetryFromFailedBlock)
+{
+    auto window = task->state()->fetchWindow();
+    auto pipeline =
+        std::make_shared<EventSubPipeline>(eventSub, task, std::vector<int64_t>({1, 2, 3}), 5);
+    pipeline->start();
+    BOOST_CHECK_EQUAL(eventSub->fetchedBlocks(), 3);
+
+    eventSub->answer(2, std::make_shared<Error>(-1, "fetch block failed"));
+    BOOST_CHECK(task->state()->fetchWindow() < window);
+    eventSub->answer(3);
+    BOOST_CHECK(task->work());
+    eventSub->answer(1);
+    // the logs after the failed block are dropped, the task continues from the failed block
+    BOOST_CHECK(pushedBlocks == std::vector<int64_t>({1}));
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 2);
+    BOOST_CHECK(!task->work());
+
+    // the next round fetches the failed block again
+    pipeline =
+        std::make_shared<EventSubPipeline>(eventSub, task, std::vector<int64_t>({2, 3}), 5);
+    task->setWork(true);
+    pipeline->start();
+    eventSub->answer(2);
+    eventSub->answer(3);
+    BOOST_CHECK(pushedBlocks == std::vector<int64_t>({1, 2, 3}));
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(testSplitLargeBlock)
+{
+    // two logs per frame
+    auto logBytes = EventSubPushBuffer::estimateBytes(Json::Value(Json::objectValue));
+    eventSub->setMaxPushBytes(logBytes * 2 + logBytes / 2);
+    eventSub->setMaxPushLatency(1000 * 1000);
+    task->params()->setToBlock(2);
+    auto pipeline =
+        std::make_shared<EventSubPipeline>(eventSub, task, std::vector<int64_t>({1, 2}), 2);
+    pipeline->start();
+    eventSub->answer(1, nullptr, 5);
+    // the last log waits for the next block
+    BOOST_CHECK(frames == std::vector<size_t>({2, 2}));
+    BOOST_CHECK(!task->pushBuffer()->empty());
+    eventSub->answer(2, nullptr, 1);
+    // the completed task flushes the buffer
+    BOOST_CHECK(frames == std::vector<size_t>({2, 2, 2}));
+    BOOST_CHECK(task->pushBuffer()->empty());
+    BOOST_CHECK_EQUAL(pushedBlocks.size(), 6);
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(testReleasedEventSub)
+{
+    auto pipeline =
+        std::make_shared<EventSubPipeline>(eventSub, task, std::vector<int64_t>({1, 2}), 5);
+    pipeline->start();
+    auto callback1 = eventSub->take(1);
+    auto callback2 = eventSub->take(2);
+    // the pipeline doesn't keep the event sub alive
+    std::weak_ptr<EventSub> released = eventSub;
+    eventSub.reset();
+    BOOST_CHECK(released.expired());
+
+    // the blocks answered after the event sub released are dropped
+    Json::Value logs(Json::arrayValue);
+    Json::Value log;
+    log["blockNumber"] = 1;
+    logs.append(log);
+    callback1(nullptr, logs);
+    BOOST_CHECK(task->work());
+    callback2(nullptr, logs);
+    BOOST_CHECK(pushedBlocks.empty());
+    BOOST_CHECK_EQUAL(task->state()->currentBlockNumber(), 1);
+    BOOST_CHECK(!task->work());
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
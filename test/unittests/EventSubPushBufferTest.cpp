@@ -0,0 +1,76 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the push buffer of the event sub task
+ * @file EventSubPushBufferTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSubPushBuffer.h>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::event;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(EventSubPushBufferTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testEstimateBytes)
+{
+    Json::Value log;
+    log["address"] = "0x1234";
+    auto fixedBytes = EventSubPushBuffer::estimateBytes(log);
+    log["data"] = "0x" + std::string(1000, 'a');
+    BOOST_CHECK_EQUAL(EventSubPushBuffer::estimateBytes(log), fixedBytes + 1002);
+    log["topics"].append("0x" + std::string(64, 'b'));
+    log["topics"].append("0x" + std::string(64, 'c'));
+    auto bytes = EventSubPushBuffer::estimateBytes(log);
+    BOOST_CHECK(bytes > fixedBytes + 1002 + 2 * 66);
+    // the estimation is close to the serialized size
+    BOOST_CHECK(bytes >= Json::FastWriter().write(log).size());
+}
+
+BOOST_AUTO_TEST_CASE(testAppendAndTake)
+{
+    EventSubPushBuffer buffer;
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK_EQUAL(buffer.bytes(), 0);
+    BOOST_CHECK_EQUAL(buffer.age(), 0);
+
+    for (int i = 0; i < 3; i++)
+    {
+        Json::Value log;
+        log["logIndex"] = i;
+        buffer.append(log, 100);
+    }
+    BOOST_CHECK(!buffer.empty());
+    BOOST_CHECK_EQUAL(buffer.bytes(), 300);
+    // the age starts from the oldest log
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK(buffer.age() >= 20);
+
+    auto logs = buffer.take();
+    BOOST_CHECK_EQUAL(logs.size(), 3);
+    BOOST_CHECK_EQUAL(logs[2]["logIndex"].asInt(), 2);
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK_EQUAL(buffer.bytes(), 0);
+    BOOST_CHECK_EQUAL(buffer.age(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,85 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the tasks woken by the block notifications of the EventSub
+ * @file EventSubSchedulerTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/event/EventSub.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::event;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0") {}
+    bcos::protocol::BlockNumber getBlockNumberByGroup(const std::string&) override
+    {
+        return m_blockNumber;
+    }
+    bcos::protocol::BlockNumber m_blockNumber = 10;
+};
+
+EventSubTask::Ptr fakeTask(std::string const& _id, std::string const& _group)
+{
+    auto task = std::make_shared<EventSubTask>();
+    task->setId(_id);
+    task->setGroup(_group);
+    return task;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubSchedulerTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testWakeOnBlockNumber)
+{
+    auto eventSub = std::make_shared<EventSub>(1);
+    eventSub->setGroupManager(std::make_shared<FakeGroupManager>());
+
+    // the tasks that have processed the highest block wait for the next block
+    eventSub->waitForBlock(fakeTask("task0", "group0"), 10);
+    eventSub->waitForBlock(fakeTask("task1", "group1"), 10);
+    BOOST_CHECK_EQUAL(eventSub->waitingTaskCount(), 2);
+    BOOST_CHECK_EQUAL(eventSub->readyTaskCount(), 0);
+    // the block reached before waiting is never missed
+    eventSub->waitForBlock(fakeTask("task2", "group0"), 9);
+    BOOST_CHECK_EQUAL(eventSub->waitingTaskCount(), 2);
+    BOOST_CHECK_EQUAL(eventSub->readyTaskCount(), 1);
+
+    // only the tasks of the notified group are woken
+    eventSub->onBlockNumberUpdated("group0", 11);
+    BOOST_CHECK_EQUAL(eventSub->waitingTaskCount(), 1);
+    BOOST_CHECK_EQUAL(eventSub->readyTaskCount(), 2);
+    eventSub->onBlockNumberUpdated("group2", 11);
+    BOOST_CHECK_EQUAL(eventSub->waitingTaskCount(), 1);
+
+    eventSub->readyTask(fakeTask("task3", "group2"));
+    BOOST_CHECK_EQUAL(eventSub->readyTaskCount(), 3);
+    eventSub->onBlockNumberUpdated("group1", 11);
+    BOOST_CHECK_EQUAL(eventSub->waitingTaskCount(), 0);
+    BOOST_CHECK_EQUAL(eventSub->readyTaskCount(), 4);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
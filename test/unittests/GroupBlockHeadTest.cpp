@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the lock-free block head of the groups
+ * @file GroupBlockHeadTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupBlockHead.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(GroupBlockHeadTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testUpdate)
+{
+    auto blockHead = std::make_shared<GroupBlockHead>();
+    auto node0 = blockHead->internNode("node0");
+    auto node1 = blockHead->internNode("node1");
+    BOOST_CHECK_EQUAL(node0, 0);
+    BOOST_CHECK_EQUAL(node1, 1);
+    BOOST_CHECK_EQUAL(blockHead->internNode("node0"), 0);
+    BOOST_CHECK_EQUAL(blockHead->nodeBit("node2"), -1);
+
+    BOOST_CHECK(blockHead->update(node0, 10) == BlockHeadUpdateResult::BLOCK_INCREASED);
+    BOOST_CHECK_EQUAL(blockHead->blockNumber(), 10);
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 1);
+    BOOST_CHECK(blockHead->update(node0, 10) == BlockHeadUpdateResult::UNCHANGED);
+    BOOST_CHECK(blockHead->update(node1, 10) == BlockHeadUpdateResult::NODE_UPDATED);
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 3);
+    BOOST_CHECK(blockHead->update(node0, 9) == BlockHeadUpdateResult::EXPIRED);
+
+    // the bitmap is reset for the new block
+    BOOST_CHECK(blockHead->update(node1, 11) == BlockHeadUpdateResult::BLOCK_INCREASED);
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 2);
+    // the untracked node updates the block only
+    BOOST_CHECK(blockHead->update(-1, 12) == BlockHeadUpdateResult::BLOCK_INCREASED);
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testInternAndRemove)
+{
+    auto blockHead = std::make_shared<GroupBlockHead>();
+    for (int32_t i = 0; i < GroupBlockHead::c_maxTrackedNodes; i++)
+    {
+        BOOST_CHECK_EQUAL(blockHead->internNode("node" + std::to_string(i)), i);
+    }
+    BOOST_CHECK_EQUAL(blockHead->internNode("nodeX"), -1);
+    BOOST_CHECK_EQUAL(blockHead->internedNodes(), (size_t)GroupBlockHead::c_maxTrackedNodes);
+
+    blockHead->update(3, 10);
+    blockHead->update(5, 10);
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), (1ULL << 3) | (1ULL << 5));
+
+    // the bits of the removed nodes are cleared and released
+    blockHead->removeNodes(std::set<std::string>{"node3", "unknown"});
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 1ULL << 5);
+    BOOST_CHECK_EQUAL(blockHead->nodeBit("node3"), -1);
+    BOOST_CHECK_EQUAL(blockHead->blockNumber(), 10);
+    BOOST_CHECK_EQUAL(blockHead->internNode("nodeX"), 3);
+    // the new node never inherits the block reached by the removed node
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), 1ULL << 5);
+    BOOST_CHECK_EQUAL(blockHead->internNode("nodeY"), -1);
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentUpdate)
+{
+    auto blockHead = std::make_shared<GroupBlockHead>();
+    const int32_t nodeNum = 8;
+    const int64_t blockNum = 1000;
+    std::atomic<int64_t> increased = {0};
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < nodeNum; i++)
+    {
+        auto nodeBit = blockHead->internNode("node" + std::to_string(i));
+        threads.emplace_back([blockHead, nodeBit, blockNum, &increased]() {
+            for (int64_t block = 0; block < blockNum; block++)
+            {
+                if (blockHead->update(nodeBit, block) == BlockHeadUpdateResult::BLOCK_INCREASED)
+                {
+                    increased++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(blockHead->blockNumber(), blockNum - 1);
+    // every block is increased exactly once
+    BOOST_CHECK_EQUAL(increased.load(), blockNum);
+    // all the nodes reached the last block
+    BOOST_CHECK_EQUAL(blockHead->latestNodes(), (1ULL << nodeNum) - 1);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the invalidation of the cached group info json
+ * @file GroupInfoCacheTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/interfaces/multigroup/ChainNodeInfo.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfo.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/GroupInfoCache.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::group;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+// the GroupManager without the node service factory and the status updater
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0")
+    {
+        registerGroupInfoNotifier([](GroupInfo::Ptr) {});
+    }
+    using GroupManager::removeUnreachableNodes;
+};
+
+GroupInfo::Ptr fakeGroupInfo(std::string const& _groupID)
+{
+    auto groupInfo = std::make_shared<GroupInfo>("chain0", _groupID);
+    groupInfo->appendNodeInfo(std::make_shared<ChainNodeInfo>("node0", 0));
+    return groupInfo;
+}
+
+Json::Value parse(bcos::bytes const& _data)
+{
+    Json::Value result;
+    Json::Reader().parse(std::string(_data.begin(), _data.end()), result);
+    return result;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(GroupInfoCacheTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testInvalidation)
+{
+    auto groupManager = std::make_shared<FakeGroupManager>();
+    auto cache = std::make_shared<GroupInfoCache>(groupManager);
+    BOOST_CHECK(!cache->groupInfo("g0"));
+    BOOST_CHECK_EQUAL(parse(*cache->groupInfoList()->data).size(), 0);
+
+    groupManager->updateGroupInfo(fakeGroupInfo("g0"));
+    auto g0 = cache->groupInfo("g0");
+    BOOST_CHECK(g0);
+    // served from the cache until the group info changes
+    BOOST_CHECK(cache->groupInfo("g0") == g0);
+    auto groupInfoList = cache->groupInfoList();
+    BOOST_CHECK_EQUAL(parse(*groupInfoList->data).size(), 1);
+    BOOST_CHECK(cache->groupInfoList() == groupInfoList);
+    auto handshake = cache->handshakeResponse(1);
+    BOOST_CHECK(cache->handshakeResponse(1) == handshake);
+
+    // the new group invalidates the list and the handshake, but not the other groups
+    groupManager->updateGroupInfo(fakeGroupInfo("g1"));
+    BOOST_CHECK(cache->groupInfo("g0") == g0);
+    auto updatedGroupInfoList = cache->groupInfoList();
+    BOOST_CHECK(updatedGroupInfoList != groupInfoList);
+    BOOST_CHECK(updatedGroupInfoList->version > groupInfoList->version);
+    auto groupInfos = parse(*updatedGroupInfoList->data);
+    BOOST_CHECK_EQUAL(groupInfos.size(), 2);
+    // the spliced list is the same as the cached group info
+    BOOST_CHECK(groupInfos[0] == parse(*g0->data));
+    auto updatedHandshake = cache->handshakeResponse(1);
+    BOOST_CHECK(updatedHandshake != handshake);
+    BOOST_CHECK_EQUAL(parse(*updatedHandshake)["groupInfoList"].size(), 2);
+    auto groupList = parse(*cache->handshakeResponse(1, true))["groupList"];
+    BOOST_CHECK_EQUAL(groupList.size(), 2);
+    BOOST_CHECK_EQUAL(groupList[1].asString(), "g1");
+
+    // the removed node invalidates the group
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> unreachableNodes;
+    unreachableNodes["g0"]["node0"] = nullptr;
+    groupManager->removeUnreachableNodes(unreachableNodes);
+    auto updatedG0 = cache->groupInfo("g0");
+    BOOST_CHECK(updatedG0 != g0);
+    BOOST_CHECK(updatedG0->version > g0->version);
+    BOOST_CHECK(*updatedG0->data != *g0->data);
+    BOOST_CHECK(cache->groupInfoList()->version > updatedGroupInfoList->version);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
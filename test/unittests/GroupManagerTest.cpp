@@ -0,0 +1,169 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the paginated group list of the GroupManager
+ * @file GroupManagerTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/interfaces/multigroup/ChainNodeInfo.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfo.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::group;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+// the GroupManager without the node service factory and the status updater
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0")
+    {
+        registerGroupInfoNotifier([](GroupInfo::Ptr) {});
+    }
+    using GroupManager::removeUnreachableNodes;
+};
+
+// records the batches of the nodes, the nodes named "down" miss the services
+class FakeNodeServiceFactory : public NodeServiceFactory
+{
+public:
+    FakeNodeServiceFactory() : NodeServiceFactory(1) {}
+    std::vector<NodeService::Ptr> buildNodeServices(std::string const&, std::string const&,
+        std::vector<ChainNodeInfo::Ptr> const& _nodeInfos) override
+    {
+        std::vector<std::string> batch;
+        std::vector<NodeService::Ptr> nodeServices;
+        for (auto const& nodeInfo : _nodeInfos)
+        {
+            batch.emplace_back(nodeInfo->nodeName());
+            nodeServices.emplace_back(nodeInfo->nodeName() == "down" ?
+                                          nullptr :
+                                          std::make_shared<NodeService>(nullptr, nullptr, nullptr,
+                                              nullptr, nullptr, nullptr));
+        }
+        std::sort(batch.begin(), batch.end());
+        m_batches.emplace_back(batch);
+        return nodeServices;
+    }
+
+    std::vector<std::vector<std::string>> m_batches;
+};
+
+GroupInfo::Ptr fakeGroupInfo(std::string const& _groupID, bool _started)
+{
+    auto groupInfo = std::make_shared<GroupInfo>("chain0", _groupID);
+    if (_started)
+    {
+        groupInfo->appendNodeInfo(std::make_shared<ChainNodeInfo>("node0", 0));
+    }
+    return groupInfo;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(GroupManagerTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testQueryGroupList)
+{
+    auto groupManager = std::make_shared<FakeGroupManager>();
+    // g0..g9, only the even groups are started
+    for (int i = 9; i >= 0; i--)
+    {
+        groupManager->updateGroupInfo(fakeGroupInfo("g" + std::to_string(i), i % 2 == 0));
+    }
+    groupManager->updateGroupInfo(fakeGroupInfo("h0", true));
+
+    size_t total = 0;
+    auto groupList = groupManager->queryGroupList("g", 2, 3, false, total);
+    BOOST_CHECK_EQUAL(total, 10);
+    BOOST_CHECK(groupList == std::vector<std::string>({"g2", "g3", "g4"}));
+
+    groupList = groupManager->queryGroupList("g", 1, 2, true, total);
+    BOOST_CHECK_EQUAL(total, 5);
+    BOOST_CHECK(groupList == std::vector<std::string>({"g2", "g4"}));
+
+    groupList = groupManager->queryGroupList("", 0, 100, true, total);
+    BOOST_CHECK_EQUAL(total, 6);
+    BOOST_CHECK_EQUAL(groupList.size(), 6);
+    BOOST_CHECK_EQUAL(groupList.back(), "h0");
+
+    // the page out of the matched groups
+    groupList = groupManager->queryGroupList("g", 10, 3, false, total);
+    BOOST_CHECK_EQUAL(total, 10);
+    BOOST_CHECK(groupList.empty());
+    groupList = groupManager->queryGroupList("x", 0, 3, false, total);
+    BOOST_CHECK_EQUAL(total, 0);
+    BOOST_CHECK(groupList.empty());
+    BOOST_CHECK_EQUAL(groupManager->groupList().size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(testStartedGroups)
+{
+    auto groupManager = std::make_shared<FakeGroupManager>();
+    groupManager->updateGroupInfo(fakeGroupInfo("g0", true));
+    groupManager->updateGroupInfo(fakeGroupInfo("g1", true));
+    BOOST_CHECK_EQUAL(groupManager->sortedStartedGroupIDs()->size(), 2);
+
+    // the group losing its last node is no longer started
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> unreachableNodes;
+    unreachableNodes["g0"]["node0"] = nullptr;
+    groupManager->removeUnreachableNodes(unreachableNodes);
+    auto startedGroupIDs = groupManager->sortedStartedGroupIDs();
+    BOOST_CHECK(*startedGroupIDs == std::vector<std::string>({"g1"}));
+    BOOST_CHECK_EQUAL(groupManager->sortedGroupIDs()->size(), 2);
+
+    size_t total = 0;
+    auto groupList = groupManager->queryGroupList("g", 0, 10, true, total);
+    BOOST_CHECK_EQUAL(total, 1);
+    BOOST_CHECK(groupList == std::vector<std::string>({"g1"}));
+    BOOST_CHECK(groupManager->groupList() == std::set<std::string>({"g1"}));
+}
+
+BOOST_AUTO_TEST_CASE(testBuildNodeServicesInBatch)
+{
+    auto factory = std::make_shared<FakeNodeServiceFactory>();
+    auto groupManager = std::make_shared<GroupManager>("chain0", factory);
+    groupManager->registerGroupInfoNotifier([](GroupInfo::Ptr) {});
+    groupManager->updateGroupInfo(fakeGroupInfo("g0", true));
+    BOOST_CHECK(factory->m_batches.empty());
+
+    // all the started nodes of the update are built by one batch
+    auto groupInfo = fakeGroupInfo("g0", true);
+    groupInfo->appendNodeInfo(std::make_shared<ChainNodeInfo>("node1", 0));
+    groupInfo->appendNodeInfo(std::make_shared<ChainNodeInfo>("down", 0));
+    groupManager->updateGroupInfo(groupInfo);
+    BOOST_REQUIRE_EQUAL(factory->m_batches.size(), 1);
+    BOOST_CHECK(
+        factory->m_batches[0] == std::vector<std::string>({"down", "node0", "node1"}));
+    BOOST_CHECK(groupManager->getNodeService("g0", "node0"));
+    BOOST_CHECK(groupManager->getNodeService("g0", "node1"));
+    BOOST_CHECK(!groupManager->getNodeService("g0", "down"));
+
+    // only the node without the node service is built again
+    groupManager->updateGroupInfo(groupInfo);
+    BOOST_REQUIRE_EQUAL(factory->m_batches.size(), 2);
+    BOOST_CHECK(factory->m_batches[1] == std::vector<std::string>({"down"}));
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
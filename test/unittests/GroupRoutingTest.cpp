@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the routing snapshot of the GroupManager
+ * @file GroupRoutingTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/interfaces/multigroup/ChainNodeInfo.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfo.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/groupmgr/GroupManager.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::group;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0")
+    {
+        registerGroupInfoNotifier([](GroupInfo::Ptr) {});
+    }
+    using GroupManager::removeUnreachableNodes;
+    using GroupManager::routingTable;
+
+    // add the node service like updateGroupInfo without building the service clients
+    void addNode(std::string const& _groupID, std::string const& _nodeName,
+        NodeService::Ptr _nodeService)
+    {
+        auto& shard = groupShard(_groupID);
+        {
+            WriteGuard l(shard.x_groups);
+            addNodeServiceWithoutLock(
+                shard, _groupID, std::make_shared<ChainNodeInfo>(_nodeName, 0), _nodeService);
+        }
+        publishRoutingTable(std::set<std::string>{_groupID});
+    }
+};
+
+NodeService::Ptr fakeNodeService()
+{
+    return std::make_shared<NodeService>(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(GroupRoutingTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testRoutingSnapshot)
+{
+    auto groupManager = std::make_shared<FakeGroupManager>();
+    groupManager->updateGroupInfo(std::make_shared<GroupInfo>("chain0", "g0"));
+    BOOST_CHECK(!groupManager->getNodeService("g0", ""));
+
+    auto node0 = fakeNodeService();
+    groupManager->addNode("g0", "node0", node0);
+    auto snapshot = groupManager->routingTable("g0");
+    BOOST_REQUIRE(snapshot);
+    BOOST_CHECK_EQUAL(snapshot->nodeServices.size(), 1);
+    BOOST_CHECK(groupManager->getNodeService("g0", "node0") == node0);
+    // the node without block is selected from the started nodes
+    BOOST_CHECK(groupManager->getNodeService("g0", "") == node0);
+
+    // the update publishes a new snapshot, the snapshot held by the reader is unchanged
+    auto node1 = fakeNodeService();
+    groupManager->addNode("g0", "node1", node1);
+    BOOST_CHECK_EQUAL(snapshot->nodeServices.size(), 1);
+    BOOST_CHECK(groupManager->routingTable("g0") != snapshot);
+    BOOST_CHECK_EQUAL(groupManager->routingTable("g0")->nodeServices.size(), 2);
+    BOOST_CHECK(groupManager->getNodeService("g0", "node1") == node1);
+    BOOST_CHECK(!groupManager->getNodeService("g0", "node2"));
+    BOOST_CHECK(!groupManager->getNodeService("g1", ""));
+
+    // only the node with the highest block is selected
+    groupManager->updateGroupBlockInfo("g0", "node0", 10);
+    groupManager->updateGroupBlockInfo("g0", "node1", 11);
+    BOOST_CHECK_EQUAL(groupManager->getBlockNumberByGroup("g0"), 11);
+    for (int i = 0; i < 10; i++)
+    {
+        BOOST_CHECK(groupManager->getNodeService("g0", "") == node1);
+    }
+
+    // the removed node is no longer routed
+    std::map<std::string, std::map<std::string, NodeService::Ptr>> unreachableNodes;
+    unreachableNodes["g0"]["node1"] = node1;
+    groupManager->removeUnreachableNodes(unreachableNodes);
+    BOOST_CHECK(!groupManager->getNodeService("g0", "node1"));
+    // the highest block is kept, the rest nodes are selected until they reach it
+    BOOST_CHECK(groupManager->getNodeService("g0", "") == node0);
+    BOOST_CHECK_EQUAL(groupManager->getBlockNumberByGroup("g0"), 11);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
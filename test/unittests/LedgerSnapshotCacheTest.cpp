@@ -0,0 +1,142 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the per-block ledger snapshot cache
+ * @file LedgerSnapshotCacheTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/LedgerSnapshotCache.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(LedgerSnapshotCacheTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testSnapshotOfBlock)
+{
+    auto cache = std::make_shared<LedgerSnapshotCache>();
+    Json::Value jValue;
+    BOOST_CHECK(!cache->get("group0", 10, SNAPSHOT_SEALER_LIST, jValue));
+
+    Json::Value jSealers(Json::arrayValue);
+    jSealers.append("node0");
+    cache->update("group0", 10, SNAPSHOT_SEALER_LIST, jSealers);
+    BOOST_CHECK(cache->get("group0", 10, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK_EQUAL(jValue.size(), 1);
+    // the snapshot is only served for the block it's read at
+    BOOST_CHECK(!cache->get("group0", 11, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK(!cache->get("group0", 10, SNAPSHOT_OBSERVER_LIST, jValue));
+
+    // the items of the same block are merged into the snapshot
+    Json::Value jCount;
+    jCount["transactionCount"] = 100;
+    cache->update("group0", 10, SNAPSHOT_TOTAL_TX_COUNT, jCount);
+    BOOST_CHECK(cache->get("group0", 10, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK(cache->get("group0", 10, SNAPSHOT_TOTAL_TX_COUNT, jValue));
+    BOOST_CHECK_EQUAL(jValue["transactionCount"].asInt64(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidation)
+{
+    auto cache = std::make_shared<LedgerSnapshotCache>();
+    Json::Value jValue(Json::arrayValue);
+    cache->update("group0", 10, SNAPSHOT_SEALER_LIST, jValue);
+
+    // the new block drops the items of the old block
+    cache->onBlockNumberUpdated("group0", 11);
+    BOOST_CHECK(!cache->get("group0", 10, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK(!cache->get("group0", 11, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK_EQUAL(cache->snapshot("group0")->blockNumber, 11);
+
+    // the result read from a lagging node is never published over the newer snapshot
+    cache->update("group0", 10, SNAPSHOT_SEALER_LIST, jValue);
+    BOOST_CHECK(!cache->get("group0", 10, SNAPSHOT_SEALER_LIST, jValue));
+    BOOST_CHECK_EQUAL(cache->snapshot("group0")->blockNumber, 11);
+
+    cache->setEnabled(false);
+    cache->update("group0", 11, SNAPSHOT_SEALER_LIST, jValue);
+    BOOST_CHECK(!cache->get("group0", 11, SNAPSHOT_SEALER_LIST, jValue));
+}
+
+BOOST_AUTO_TEST_CASE(testSingleFlightQuery)
+{
+    auto cache = std::make_shared<LedgerSnapshotCache>();
+    std::vector<LedgerSnapshotCache::QueryCallback> queries;
+    auto querier = [&queries](LedgerSnapshotCache::QueryCallback _onQueried) {
+        queries.push_back(_onQueried);
+    };
+    std::vector<int64_t> results;
+    auto callback = [&results](Error::Ptr _error, Json::Value& _value) {
+        results.push_back(_error ? -1 : _value["transactionCount"].asInt64());
+    };
+    Json::Value jCount;
+    jCount["transactionCount"] = 100;
+
+    // the group without notified block is queried every time and never cached
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 2);
+    queries[0](nullptr, jCount);
+    queries[1](nullptr, jCount);
+    BOOST_CHECK(results == std::vector<int64_t>({100, 100}));
+    BOOST_CHECK(!cache->snapshot("group0"));
+
+    // the concurrent misses of the notified block share one query
+    queries.clear();
+    results.clear();
+    cache->onBlockNumberUpdated("group0", 10);
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    cache->query("group0", SNAPSHOT_SEALER_LIST, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 2);
+    queries[0](nullptr, jCount);
+    BOOST_CHECK(results == std::vector<int64_t>({100, 100}));
+    Json::Value jValue;
+    BOOST_CHECK(cache->get("group0", 10, SNAPSHOT_TOTAL_TX_COUNT, jValue));
+    // the cached item is answered without query
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 2);
+    BOOST_CHECK_EQUAL(results.size(), 3);
+
+    // the result of the query across a new block is answered but not cached
+    cache->onBlockNumberUpdated("group0", 11);
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 3);
+    cache->onBlockNumberUpdated("group0", 12);
+    // the request of the new block never waits for the query of the old block
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 4);
+    queries[2](nullptr, jCount);
+    BOOST_CHECK_EQUAL(results.size(), 4);
+    BOOST_CHECK(!cache->get("group0", 12, SNAPSHOT_TOTAL_TX_COUNT, jValue));
+
+    // the failed query is answered to all the waiters and never cached
+    cache->query("group0", SNAPSHOT_TOTAL_TX_COUNT, querier, callback);
+    BOOST_CHECK_EQUAL(queries.size(), 4);
+    Json::Value jEmpty;
+    queries[3](std::make_shared<Error>(-1, "query failed"), jEmpty);
+    BOOST_CHECK(results == std::vector<int64_t>({100, 100, 100, 100, -1, -1}));
+    BOOST_CHECK(!cache->get("group0", 12, SNAPSHOT_TOTAL_TX_COUNT, jValue));
+    queries[1](nullptr, jValue);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,62 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the probe rounds of the NodeHealthProber
+ * @file NodeHealthProberTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/groupmgr/NodeHealthProber.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(NodeHealthProberTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testRoundFinishedAfterCallback)
+{
+    auto prober = std::make_shared<NodeHealthProber>(2, 1000);
+    size_t finishedRounds = 0;
+    bool probingInCallback = false;
+    bool overlappedRound = true;
+    BOOST_CHECK(prober->probe({}, [&](ProbeResults&& _results) {
+        BOOST_CHECK(_results.empty());
+        finishedRounds++;
+        // the next round can't start before the results are applied
+        probingInCallback = prober->probing();
+        overlappedRound = prober->probe({}, [&](ProbeResults&&) { finishedRounds++; });
+    }));
+    BOOST_CHECK_EQUAL(finishedRounds, 1);
+    BOOST_CHECK(probingInCallback);
+    BOOST_CHECK(!overlappedRound);
+    BOOST_CHECK(!prober->probing());
+    BOOST_CHECK_EQUAL(prober->probeRounds(), 1);
+
+    // the exception of the callback doesn't block the next rounds
+    BOOST_CHECK(prober->probe(
+        {}, [](ProbeResults&&) { throw std::runtime_error("apply the results failed"); }));
+    BOOST_CHECK(!prober->probing());
+    BOOST_CHECK(prober->probe({}, [&](ProbeResults&&) { finishedRounds++; }));
+    BOOST_CHECK_EQUAL(finishedRounds, 2);
+    BOOST_CHECK_EQUAL(prober->probeRounds(), 3);
+    BOOST_CHECK_EQUAL(prober->timedOutProbes(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
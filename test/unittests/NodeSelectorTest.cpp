@@ -0,0 +1,98 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the load-aware node selection
+ * @file NodeSelectorTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/groupmgr/NodeSelector.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+std::vector<NodeService::Ptr> fakeNodeServices(size_t _size)
+{
+    std::vector<NodeService::Ptr> nodeServices;
+    for (size_t i = 0; i < _size; i++)
+    {
+        nodeServices.emplace_back(
+            std::make_shared<NodeService>(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr));
+    }
+    return nodeServices;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(NodeSelectorTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testPowerOfTwoChoices)
+{
+    auto selector = std::make_shared<PowerOfTwoChoicesNodeSelector>();
+    auto nodeServices = fakeNodeServices(3);
+    // the single candidate is always selected
+    BOOST_CHECK_EQUAL(selector->select(nodeServices, {2}), 2);
+
+    // the node with more outstanding requests loses the choice of the two candidates
+    nodeServices[0]->onRequestStart();
+    nodeServices[0]->onRequestStart();
+    for (int i = 0; i < 20; i++)
+    {
+        BOOST_CHECK_EQUAL(selector->select(nodeServices, {0, 1}), 1);
+    }
+    // the slow node loses the choice with the same outstanding requests
+    nodeServices[0]->onRequestFinish(100 * 1000, false);
+    nodeServices[0]->onRequestFinish(100 * 1000, false);
+    nodeServices[1]->onRequestStart();
+    nodeServices[1]->onRequestFinish(1000, false);
+    BOOST_CHECK_EQUAL(nodeServices[0]->outstandingRequests(), 0);
+    for (int i = 0; i < 20; i++)
+    {
+        BOOST_CHECK_EQUAL(selector->select(nodeServices, {0, 1}), 1);
+    }
+    // the cancelled request is no longer counted
+    nodeServices[1]->onRequestStart();
+    nodeServices[1]->onRequestCancel();
+    BOOST_CHECK_EQUAL(nodeServices[1]->outstandingRequests(), 0);
+
+    // the selected node is always one of the candidates
+    for (int i = 0; i < 20; i++)
+    {
+        auto index = selector->select(nodeServices, {0, 2});
+        BOOST_CHECK(index == 0 || index == 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testRandomSelector)
+{
+    auto selector = std::make_shared<RandomNodeSelector>();
+    auto nodeServices = fakeNodeServices(3);
+    std::set<size_t> selected;
+    for (int i = 0; i < 100; i++)
+    {
+        auto index = selector->select(nodeServices, {1, 2});
+        BOOST_CHECK(index == 1 || index == 2);
+        selected.insert(index);
+    }
+    BOOST_CHECK_EQUAL(selected.size(), 2);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
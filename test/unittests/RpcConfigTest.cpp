@@ -0,0 +1,99 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the options of the rpc loaded from config.ini
+ * @file RpcConfigTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/RpcConfig.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(RpcConfigTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testLogQueryLimits)
+{
+    auto config = std::make_shared<RpcConfig>();
+    boost::property_tree::ptree pt;
+    config->loadConfig(pt);
+    BOOST_CHECK_EQUAL(config->logQueryMaxBlockRange(), 1000);
+    BOOST_CHECK_EQUAL(config->logQueryMaxResultCount(), 10000);
+    BOOST_CHECK_EQUAL(config->logQueryFetchWindow(), 8);
+
+    pt.put("rpc.log_query_max_block_range", 200);
+    pt.put("rpc.log_query_max_result_count", 500);
+    pt.put("rpc.log_query_fetch_window", 4);
+    config->loadConfig(pt);
+    BOOST_CHECK_EQUAL(config->logQueryMaxBlockRange(), 200);
+    BOOST_CHECK_EQUAL(config->logQueryMaxResultCount(), 500);
+    BOOST_CHECK_EQUAL(config->logQueryFetchWindow(), 4);
+
+    pt.put("rpc.log_query_fetch_window", 0);
+    BOOST_CHECK_THROW(config->loadConfig(pt), InvalidRpcConfig);
+}
+
+BOOST_AUTO_TEST_CASE(testHedge)
+{
+    auto config = std::make_shared<RpcConfig>();
+    // the hedged requests double the load of the slow nodes, disabled by default
+    BOOST_CHECK(!config->hedgeEnabled());
+    boost::property_tree::ptree pt;
+    pt.put("rpc.hedge_enable", true);
+    pt.put("rpc.hedge_percentile", 0.99);
+    config->loadConfig(pt);
+    BOOST_CHECK(config->hedgeEnabled());
+    BOOST_CHECK_CLOSE(config->hedgePercentile(), 0.99, 0.0001);
+    BOOST_CHECK_CLOSE(config->hedgeTokenRatio(), 0.05, 0.0001);
+
+    pt.put("rpc.hedge_percentile", 1.5);
+    BOOST_CHECK_THROW(config->loadConfig(pt), InvalidRpcConfig);
+}
+
+BOOST_AUTO_TEST_CASE(testMissingFile)
+{
+    auto config = std::make_shared<RpcConfig>();
+    BOOST_CHECK_THROW(config->loadConfig("./not_exist_config.ini"), InvalidRpcConfig);
+}
+BOOST_AUTO_TEST_CASE(testEventBloomPath)
+{
+    auto config = std::make_shared<RpcConfig>();
+    boost::property_tree::ptree pt;
+    config->loadConfig(pt);
+    BOOST_CHECK(config->eventBloomPath().empty());
+    pt.put("rpc.event_bloom_path", "./data/bloom");
+    config->loadConfig(pt);
+    BOOST_CHECK_EQUAL(config->eventBloomPath(), "./data/bloom");
+}
+BOOST_AUTO_TEST_CASE(testEventLogIndexPath)
+{
+    auto config = std::make_shared<RpcConfig>();
+    boost::property_tree::ptree pt;
+    config->loadConfig(pt);
+    // the log index is disabled by default
+    BOOST_CHECK(config->eventLogIndexPath().empty());
+    pt.put("rpc.event_log_index_path", "./data/logIndex");
+    config->loadConfig(pt);
+    BOOST_CHECK_EQUAL(config->eventLogIndexPath(), "./data/logIndex");
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
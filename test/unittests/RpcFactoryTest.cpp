@@ -0,0 +1,108 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the rpc config applied by the RpcFactory
+ * @file RpcFactoryTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/RpcFactory.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+class FakeGroupManager : public GroupManager
+{
+public:
+    FakeGroupManager() : GroupManager("chain0") {}
+};
+
+class FakeRpcFactory : public RpcFactory
+{
+public:
+    FakeRpcFactory() : RpcFactory("chain0", nullptr, nullptr) {}
+    using RpcFactory::buildJsonRpc;
+};
+
+const std::string c_contract = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(RpcFactoryTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testLoadRpcConfig)
+{
+    std::string configPath = "./rpcFactoryTest.ini";
+    {
+        std::ofstream config(configPath, std::ios::trunc);
+        config << "[rpc]\n"
+               << "    call_cache_enable=true\n"
+               << "    call_cache_capacity=8\n"
+               << "    call_cache_allowlist=" << c_contract << "\n"
+               << "    code_cache_max_block_age=5\n"
+               << "    log_query_max_block_range=20\n"
+               << "    filter_timeout=3000\n";
+    }
+    auto factory = std::make_shared<FakeRpcFactory>();
+    factory->setConfigPath(configPath);
+    auto jsonRpc = factory->buildJsonRpc(
+        std::make_shared<bcos::boostssl::ws::WsService>(), std::make_shared<FakeGroupManager>());
+    std::remove(configPath.c_str());
+
+    auto callResultCache = jsonRpc->callResultCache();
+    BOOST_CHECK(callResultCache->enabled());
+    BOOST_CHECK_EQUAL(callResultCache->capacity(), 8 * 1024 * 1024);
+    BOOST_CHECK(callResultCache->cacheable(c_contract));
+    BOOST_CHECK(!callResultCache->cacheable("0x1111111111111111111111111111111111111111"));
+    BOOST_CHECK_EQUAL(jsonRpc->codeCache()->maxBlockAge(), 5);
+    BOOST_CHECK_EQUAL(jsonRpc->logQuery()->maxBlockRange(), 20);
+    BOOST_CHECK_EQUAL(jsonRpc->filterManager()->filterTimeout(), 3000);
+    // the optional features stay disabled
+    BOOST_CHECK(!jsonRpc->requestHedger()->enabled());
+    BOOST_CHECK(!jsonRpc->writeSessionTracker()->enabled());
+    BOOST_CHECK(factory->rpcConfig()->callCacheEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(testDefaultRpcConfig)
+{
+    auto factory = std::make_shared<FakeRpcFactory>();
+    auto jsonRpc = factory->buildJsonRpc(
+        std::make_shared<bcos::boostssl::ws::WsService>(), std::make_shared<FakeGroupManager>());
+    BOOST_CHECK(!jsonRpc->callResultCache()->enabled());
+
+    // the invalid config fails the build
+    std::string configPath = "./rpcFactoryInvalidTest.ini";
+    {
+        std::ofstream config(configPath, std::ios::trunc);
+        config << "[rpc]\n    log_query_max_block_range=0\n";
+    }
+    factory = std::make_shared<FakeRpcFactory>();
+    factory->setConfigPath(configPath);
+    BOOST_CHECK_THROW(factory->buildJsonRpc(std::make_shared<bcos::boostssl::ws::WsService>(),
+                          std::make_shared<FakeGroupManager>()),
+        InvalidRpcConfig);
+    std::remove(configPath.c_str());
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
@@ -0,0 +1,105 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the routing of the reads of the submitted transactions
+ * @file WriteSessionTrackerTest.cpp
+ * @author: agent
+ * @date 2026-10-18
+ */
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-rpc/jsonrpc/WriteSessionTracker.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::rpc;
+namespace bcos
+{
+namespace test
+{
+namespace
+{
+bcos::crypto::HashType txHash(char _c)
+{
+    return bcos::crypto::HashType(std::string(64, _c));
+}
+GroupManager::Ptr fakeGroupManager()
+{
+    return std::make_shared<GroupManager>("chain0", std::make_shared<NodeServiceFactory>());
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(WriteSessionTrackerTest, TestPromptFixture)
+BOOST_AUTO_TEST_CASE(testDisabled)
+{
+    auto tracker = std::make_shared<WriteSessionTracker>(fakeGroupManager());
+    BOOST_CHECK(!tracker->enabled());
+    tracker->onTransactionCommitted("group0", txHash('1'), nullptr, 10);
+    BOOST_CHECK_EQUAL(tracker->trackedWrites(), 0);
+
+    bool routed = false;
+    tracker->route("group0", txHash('1'), [&routed](NodeService::Ptr _nodeService) {
+        BOOST_CHECK(!_nodeService);
+        routed = true;
+    });
+    BOOST_CHECK(routed);
+}
+
+BOOST_AUTO_TEST_CASE(testWaitForBlock)
+{
+    auto tracker = std::make_shared<WriteSessionTracker>(fakeGroupManager());
+    tracker->setEnabled(true);
+    tracker->setMaxWaitTime(200);
+    // the group has not reached block 10
+    tracker->onTransactionCommitted("group0", txHash('1'), nullptr, 10);
+    BOOST_CHECK_EQUAL(tracker->trackedWrites(), 1);
+
+    std::atomic_bool routed = {false};
+    tracker->route("group0", txHash('1'), [&routed](NodeService::Ptr) { routed = true; });
+    BOOST_CHECK(!routed);
+    // woken by the block
+    tracker->onBlockNumberUpdated("group0", 10);
+    BOOST_CHECK(routed);
+
+    // expired by the cleaner after maxWaitTime
+    routed = false;
+    tracker->route("group0", txHash('1'), [&routed](NodeService::Ptr) { routed = true; });
+    BOOST_CHECK(!routed);
+    for (int i = 0; i < 20 && !routed; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    BOOST_CHECK(routed);
+}
+
+BOOST_AUTO_TEST_CASE(testReleaseWaitersWhenDisabled)
+{
+    auto tracker = std::make_shared<WriteSessionTracker>(fakeGroupManager());
+    tracker->setEnabled(true);
+    tracker->setMaxWaitTime(60 * 1000);
+    tracker->onTransactionCommitted("group0", txHash('2'), nullptr, 10);
+
+    std::atomic_bool routed = {false};
+    tracker->route("group0", txHash('2'), [&routed](NodeService::Ptr) { routed = true; });
+    BOOST_CHECK(!routed);
+    tracker->setEnabled(false);
+    BOOST_CHECK(routed);
+    BOOST_CHECK_EQUAL(tracker->trackedWrites(), 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos